@@ -0,0 +1,348 @@
+/**
+ * cata_bench: plays canned scenarios through game::do_turn without a user interface and
+ * writes how long the turns took, and how much memory the game used, as JSON to stdout.
+ *
+ * Usage: cata_bench [--turns K] [--zombies N] [--seed S] [scenario...]
+ *
+ * Every scenario is set up on freshly generated map away from the others, the set up is
+ * not timed. The player waits through the turns and takes no damage. The same arguments
+ * play the same game, so the results of two builds can be compared.
+ */
+
+#include "calendar.h"
+#include "debug.h"
+#include "field.h"
+#include "game.h"
+#include "get_version.h"
+#include "init.h"
+#include "item.h"
+#include "json.h"
+#include "line.h"
+#include "map.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "options.h"
+#include "path_info.h"
+#include "player.h"
+#include "rng.h"
+#include "vehicle.h"
+#include "worldfactory.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+const mtype_id mon_zombie( "mon_zombie" );
+
+const efftype_id effect_sleep( "sleep" );
+
+struct bench_settings {
+    int turns = 100;
+    int zombies = 100;
+    unsigned seed = 42;
+};
+
+struct bench_scenario {
+    const char *name;
+    /** Puts what the scenario is about around the player. */
+    std::function<void( const bench_settings & )> setup;
+    /** Called before each turn, for what the player or the npcs would do, can be empty. */
+    std::function<void()> each_turn;
+};
+
+/** Resident memory in KiB, or -1 where it is not known. */
+static long current_memory()
+{
+#if defined(__linux__)
+    std::ifstream statm( "/proc/self/statm" );
+    long size = 0;
+    long resident = 0;
+    if( statm >> size >> resident ) {
+        return resident * ( sysconf( _SC_PAGESIZE ) / 1024 );
+    }
+#endif
+    return -1;
+}
+
+/** The most resident memory so far in KiB, or -1 where it is not known. */
+static long peak_memory()
+{
+#if defined(__linux__)
+    rusage usage;
+    if( getrusage( RUSAGE_SELF, &usage ) == 0 ) {
+        return usage.ru_maxrss;
+    }
+#endif
+    return -1;
+}
+
+static tripoint player_pos()
+{
+    return tripoint( SEEX * MAPSIZE / 2, SEEY * MAPSIZE / 2, 0 );
+}
+
+static void init_global_game_state( const bench_settings &settings )
+{
+    PATH_INFO::init_base_path( "" );
+    PATH_INFO::init_user_dir( "./" );
+    PATH_INFO::set_standard_filenames();
+
+    get_options().init();
+    get_options().load();
+    init_colors();
+    // Saving would be timed with the turn it happens on
+    OPTIONS["AUTOSAVE"].setValue( "false" );
+
+    std::srand( settings.seed );
+    g = new game;
+
+    g->load_static_data();
+    g->load_core_data();
+    DynamicDataLoader::get_instance().finalize_loaded_data();
+
+    world_generator->set_active_world( NULL );
+    world_generator->get_all_worlds();
+    WORLDPTR bench_world = world_generator->make_new_world( false );
+    world_generator->set_active_world( bench_world );
+
+    g->u = player();
+    g->u.create( PLTYPE_NOW );
+    g->m = map( static_cast<bool>( ACTIVE_WORLD_OPTIONS["ZLEVELS"] ) );
+    g->m.load( g->get_levx(), g->get_levy(), g->get_levz(), false );
+}
+
+/** Moves the player to freshly generated map, far away from where the other scenarios played. */
+static void move_to_fresh_map( const int index )
+{
+    g->clear_zombies();
+    g->load_map( g->m.get_abs_sub() + tripoint( MAPSIZE * 4 * ( index + 1 ), 0, 0 ) );
+    g->u.setpos( player_pos() );
+    g->u.moves = 0;
+    if( !g->u.has_trait( "DEBUG_NODMG" ) ) {
+        g->u.toggle_trait( "DEBUG_NODMG" );
+    }
+    g->u.remove_effect( effect_sleep );
+}
+
+static void setup_horde( const bench_settings &settings )
+{
+    const tripoint center = player_pos();
+    int placed = 0;
+    for( int attempt = 0; attempt < settings.zombies * 10 && placed < settings.zombies; attempt++ ) {
+        const tripoint p = center + tripoint( rng( -20, 20 ), rng( -20, 20 ), 0 );
+        if( square_dist( center, p ) < 4 || !g->m.passable( p ) || g->critter_at( p ) != nullptr ) {
+            continue;
+        }
+        if( g->summon_mon( mon_zombie, p ) ) {
+            placed++;
+        }
+    }
+}
+
+// A wooden block full of furniture and planks with fires here and there in it
+static void setup_fire( const bench_settings & )
+{
+    const tripoint corner = player_pos() + tripoint( 4, -12, 0 );
+    const int size = 24;
+    for( int x = 0; x < size; x++ ) {
+        for( int y = 0; y < size; y++ ) {
+            const tripoint p = corner + tripoint( x, y, 0 );
+            const bool outer_wall = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+            const bool inner_wall = ( x % 8 == 0 || y % 8 == 0 ) && ( x + y ) % 3 != 0;
+            g->m.ter_set( p, outer_wall || inner_wall ? t_wall_wood : t_floor );
+            g->m.furn_set( p, ( x + y ) % 5 == 0 ? f_table : ( x * y ) % 7 == 0 ? f_bookcase : f_null );
+            g->m.i_clear( p );
+            if( ( x + 2 * y ) % 4 == 0 ) {
+                g->m.add_item( p, item( "2x4", calendar::turn ) );
+            }
+        }
+    }
+    for( int i = 0; i < 12; i++ ) {
+        const tripoint p = corner + tripoint( rng( 1, size - 2 ), rng( 1, size - 2 ), 0 );
+        g->m.add_field( p, fd_fire, 2, 0 );
+    }
+}
+
+// Cars on a road, driving east past the player
+static void setup_convoy( const bench_settings & )
+{
+    const tripoint start = player_pos() + tripoint( -40, -12, 0 );
+    for( int x = 0; x < SEEX * MAPSIZE - start.x; x++ ) {
+        for( int y = 0; y < 24; y++ ) {
+            const tripoint p = start + tripoint( x, y, 0 );
+            g->m.ter_set( p, t_pavement );
+            g->m.furn_set( p, f_null );
+        }
+    }
+    for( int i = 0; i < 4; i++ ) {
+        vehicle *veh = g->m.add_vehicle( vproto_id( "car" ), start + tripoint( 8 * ( i % 2 ), 4 + 6 * i, 0 ),
+                                         0, 100, 0 );
+        if( veh == nullptr ) {
+            continue;
+        }
+        veh->engine_on = true;
+        veh->cruise_on = true;
+        veh->cruise_velocity = 1000;
+        veh->velocity = 1000;
+    }
+}
+
+// Someone drives each car, vehicle::gain_moves only uses the cruise control for the player
+static void drive_convoy()
+{
+    for( auto &wrapped : g->m.get_vehicles() ) {
+        vehicle *veh = wrapped.v;
+        if( veh->engine_on && veh->cruise_on && veh->cruise_velocity != veh->velocity ) {
+            veh->thrust( veh->cruise_velocity > veh->velocity ? 1 : -1 );
+        }
+    }
+}
+
+// Everything a survivor hoards, spread around the player
+static void setup_base( const bench_settings & )
+{
+    static const std::vector<std::string> hoard = {{
+            "rock", "2x4", "water_clean", "can_beans", "apple", "meat", "bandages", "jeans", "tshirt",
+            "battery", "nail", "flashlight"
+        }
+    };
+    const tripoint center = player_pos();
+    int kind = 0;
+    for( int x = -10; x <= 10; x++ ) {
+        for( int y = -10; y <= 10; y++ ) {
+            const tripoint p = center + tripoint( x, y, 0 );
+            g->m.ter_set( p, t_floor );
+            g->m.furn_set( p, f_null );
+            for( int i = 0; i < 10; i++ ) {
+                g->m.add_item( p, item( hoard[kind++ % hoard.size()], calendar::turn ) );
+            }
+        }
+    }
+}
+
+static void setup_sleep( const bench_settings &settings )
+{
+    g->u.fall_asleep( settings.turns + 1 );
+}
+
+static const std::vector<bench_scenario> scenarios = {{
+        { "horde", setup_horde, nullptr },
+        { "fire", setup_fire, nullptr },
+        { "convoy", setup_convoy, drive_convoy },
+        { "base", setup_base, nullptr },
+        { "sleep", setup_sleep, nullptr },
+    }
+};
+
+static void run_scenario( const int index, const bench_settings &settings, JsonOut &json )
+{
+    const bench_scenario &scenario = scenarios[index];
+    std::srand( settings.seed + index );
+    move_to_fresh_map( index );
+    scenario.setup( settings );
+    const long memory_before = current_memory();
+
+    int turns = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for( ; turns < settings.turns; turns++ ) {
+        if( !g->u.in_sleep_state() ) {
+            // The player waits, do_turn would ask for an action otherwise
+            g->u.moves = 0;
+        }
+        if( scenario.each_turn ) {
+            scenario.each_turn();
+        }
+        if( g->do_turn() ) {
+            break;
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const long elapsed = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+
+    json.start_object();
+    json.member( "name", scenario.name );
+    json.member( "turns", turns );
+    json.member( "total_us", elapsed );
+    json.member( "us_per_turn", turns > 0 ? elapsed / turns : 0 );
+    json.member( "monsters", int( g->num_zombies() ) );
+    json.member( "memory_before_kb", memory_before );
+    json.member( "memory_after_kb", current_memory() );
+    json.member( "peak_memory_kb", peak_memory() );
+    json.end_object();
+}
+
+static void print_usage()
+{
+    std::cerr << "Usage: cata_bench [--turns K] [--zombies N] [--seed S] [scenario...]" << std::endl;
+    std::cerr << "Scenarios:";
+    for( const bench_scenario &scenario : scenarios ) {
+        std::cerr << " " << scenario.name;
+    }
+    std::cerr << std::endl;
+}
+
+int main( int argc, char *argv[] )
+{
+    bench_settings settings;
+    std::vector<int> selected;
+    for( int i = 1; i < argc; i++ ) {
+        const std::string arg = argv[i];
+        if( ( arg == "--turns" || arg == "--zombies" || arg == "--seed" ) && i + 1 < argc ) {
+            const int value = std::atoi( argv[++i] );
+            if( arg == "--turns" ) {
+                settings.turns = value;
+            } else if( arg == "--zombies" ) {
+                settings.zombies = value;
+            } else {
+                settings.seed = value;
+            }
+            continue;
+        }
+        bool found = false;
+        for( size_t s = 0; s < scenarios.size(); s++ ) {
+            if( arg == scenarios[s].name ) {
+                selected.push_back( s );
+                found = true;
+            }
+        }
+        if( !found ) {
+            print_usage();
+            return 1;
+        }
+    }
+    if( selected.empty() ) {
+        for( size_t s = 0; s < scenarios.size(); s++ ) {
+            selected.push_back( s );
+        }
+    }
+
+    init_global_game_state( settings );
+
+    JsonOut json( std::cout, true );
+    json.start_object();
+    json.member( "version", getVersionString() );
+    json.member( "seed", settings.seed );
+    json.member( "turns", settings.turns );
+    json.member( "zombies", settings.zombies );
+    json.member( "startup_memory_kb", current_memory() );
+    json.member( "scenarios" );
+    json.start_array();
+    for( const int index : selected ) {
+        run_scenario( index, settings, json );
+    }
+    json.end_array();
+    json.end_object();
+    std::cout << std::endl;
+
+    g->delete_world( world_generator->active_world->world_name, true );
+    return 0;
+}
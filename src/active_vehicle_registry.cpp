@@ -0,0 +1,33 @@
+#include "active_vehicle_registry.h"
+
+#include <algorithm>
+
+void active_vehicle_registry::add( vehicle *veh )
+{
+    if( !has( veh ) ) {
+        vehicles.push_back( veh );
+    }
+}
+
+void active_vehicle_registry::remove( const vehicle *veh )
+{
+    const auto iter = std::find( vehicles.begin(), vehicles.end(), veh );
+    if( iter != vehicles.end() ) {
+        vehicles.erase( iter );
+    }
+}
+
+bool active_vehicle_registry::has( const vehicle *veh ) const
+{
+    return std::find( vehicles.begin(), vehicles.end(), veh ) != vehicles.end();
+}
+
+bool active_vehicle_registry::empty() const
+{
+    return vehicles.empty();
+}
+
+std::vector<vehicle *> active_vehicle_registry::get() const
+{
+    return vehicles;
+}
@@ -0,0 +1,37 @@
+#ifndef ACTIVE_VEHICLE_REGISTRY_H
+#define ACTIVE_VEHICLE_REGISTRY_H
+
+#include <vector>
+
+class vehicle;
+
+/**
+ * Vehicles that have something running (see @ref vehicle::has_active_systems),
+ * so they need power and fuel processing each turn even outside of the reality bubble.
+ * Vehicles with nothing running don't do anything outside of the bubble, so
+ * game::do_turn only has to visit these instead of every submap in @ref MAPBUFFER.
+ * Funnels and solar panels don't count, @ref vehicle::update_time catches up on
+ * those once the vehicle is back in the bubble.
+ *
+ * Vehicles get added when created by mapgen, when loaded from disk and when
+ * processed inside the reality bubble. They are removed once nothing is running
+ * anymore, and by the vehicle destructor.
+ */
+class active_vehicle_registry
+{
+    private:
+        // A vector, not a set, so vehicles are always processed in the same order
+        std::vector<vehicle *> vehicles;
+
+    public:
+        void add( vehicle *veh );
+        void remove( const vehicle *veh );
+        bool has( const vehicle *veh ) const;
+        bool empty() const;
+        /** Returns a copy, so vehicles can be removed while iterating over it. */
+        std::vector<vehicle *> get() const;
+};
+
+extern active_vehicle_registry active_vehicles;
+
+#endif
@@ -348,10 +348,10 @@ void auto_pickup::test_pattern(const int iCurrentPage, const int iCurrentLine)
 
     //Loop through all itemfactory items
     //APU now ignores prefixes, bottled items and suffix combinations still not generated
+    const cCompiledRule rule( vRules[iCurrentPage][iCurrentLine].sRule, false );
     for( auto &p : item_controller->get_all_itypes() ) {
         sItemName = p.second->nname(1);
-        if (vRules[iCurrentPage][iCurrentLine].bActive &&
-            match(sItemName, vRules[iCurrentPage][iCurrentLine].sRule)) {
+        if (vRules[iCurrentPage][iCurrentLine].bActive && rule.matches(fold_case(sItemName))) {
             vMatchingItems.push_back(sItemName);
         }
     }
@@ -466,7 +466,6 @@ bool auto_pickup::has_rule(const std::string &sRule)
 void auto_pickup::add_rule(const std::string &sRule)
 {
     vRules[CHARACTER].push_back(cRules(sRule, true, false));
-    merge_vector();
     create_rules();
 
     if (!OPTIONS["AUTO_PICKUP"] &&
@@ -483,56 +482,23 @@ void auto_pickup::remove_rule(const std::string &sRule)
         if (sRule.length() == it->sRule.length() &&
             ci_find_substr(sRule, it->sRule) != -1) {
             vRules[CHARACTER].erase(it);
-            merge_vector();
             create_rules();
             break;
         }
     }
 }
 
-void auto_pickup::create_rules(const std::string &sItemNameIn)
+void auto_pickup::create_rules()
 {
-    if (sItemNameIn == "") {
-        mapItems.clear();
-    }
-
-    std::string sItemName = "";
+    merge_vector();
 
-    //process include/exclude in order of rules, global first, then character specific
-    //the MERGED vector is already in the correct order
-    //if a specific item is being added, all the rules need to be checked now
-    //may have some performance issues since exclusion needs to check all items also
+    vCompiledRules.clear();
     for( auto &elem : vRules[MERGED] ) {
-        if( !elem.bExclude ) {
-            if (sItemNameIn != "") {
-                if( elem.bActive && match( sItemNameIn, elem.sRule ) ) {
-                    mapItems[sItemNameIn] = "true";
-                }
-            } else {
-                //Check include patterns against all itemfactory items
-                for( auto &p : item_controller->get_all_itypes() ) {
-                    sItemName = p.second->nname(1);
-                    if( elem.bActive && match( sItemName, elem.sRule ) ) {
-                        mapItems[sItemName] = "true";
-                    }
-                }
-            }
-        } else {
-            if (sItemNameIn != "") {
-                if( elem.bActive && match( sItemNameIn, elem.sRule ) ) {
-                    mapItems[sItemNameIn] = "false";
-                }
-            } else {
-                //only re-exclude items from the existing mapping for now
-                //new exclusions will process during pickup attempts
-                for (auto iter = mapItems.begin(); iter != mapItems.end(); ++iter) {
-                    if( elem.bActive && match( iter->first, elem.sRule ) ) {
-                        mapItems[iter->first] = "false";
-                    }
-                }
-            }
+        if( elem.bActive ) {
+            vCompiledRules.emplace_back( elem.sRule, elem.bExclude );
         }
     }
+    mapItems.clear();
 }
 
 /**
@@ -572,13 +538,19 @@ std::string auto_pickup::trim_rule(const std::string &sPatternIn)
     return sPattern;
 }
 
-bool auto_pickup::match(const std::string &sTextIn, const std::string &sPatternIn)
+std::string auto_pickup::fold_case( const std::string &sText )
 {
-    std::string sText = sTextIn;
-    std::string sPattern = sPatternIn;
-
-    //case insenitive search
+    const std::locale loc;
+    std::string sFolded = sText;
+    for( auto &ch : sFolded ) {
+        ch = std::toupper( ch, loc );
+    }
+    return sFolded;
+}
 
+auto_pickup::cCompiledRule::cCompiledRule( const std::string &sRule, const bool bExcludeIn )
+    : bExclude( bExcludeIn )
+{
     /* Possible patterns
     *
     wooD
@@ -589,69 +561,51 @@ bool auto_pickup::match(const std::string &sTextIn, const std::string &sPatternI
     *wood*arrow
     *wood*hard* *x*y*z*arrow*
     */
+    const std::string sPattern = fold_case( trim_rule( sRule ) );
+    size_t iStart = 0;
+    size_t iPos;
+    while( ( iPos = sPattern.find( '*', iStart ) ) != std::string::npos ) {
+        vSegments.push_back( sPattern.substr( iStart, iPos - iStart ) );
+        iStart = iPos + 1;
+    }
+    vSegments.push_back( sPattern.substr( iStart ) );
+}
 
-    if (sText == "") {
+bool auto_pickup::cCompiledRule::matches( const std::string &sFoldedText ) const
+{
+    if( sFoldedText.empty() ) {
         return false;
-    } else if (sText == "*") {
+    } else if( sFoldedText == "*" ) {
         return true;
     }
 
-    int iPos;
-    std::vector<std::string> vPattern;
-
-    sPattern = trim_rule(sPattern);
-
-    split(sPattern, '*', vPattern);
-    size_t iNum = vPattern.size();
+    if( vSegments.size() == 1 ) { // no * found
+        return sFoldedText == vSegments.front();
+    }
 
-    if (iNum == 0) { //should never happen
+    //beginning: ^vSegments[0]
+    const std::string &sFirst = vSegments.front();
+    if( sFoldedText.compare( 0, sFirst.length(), sFirst ) != 0 ) {
         return false;
-    } else if (iNum == 1) { // no * found
-        return (sText.length() == vPattern[0].length() && ci_find_substr(sText, vPattern[0]) != -1);
     }
+    size_t iPos = sFirst.length();
 
-    for (auto it = vPattern.begin(); it != vPattern.end(); ++it) {
-        if (it == vPattern.begin() && *it != "") { //beginning: ^vPat[i]
-            if (sText.length() < it->length() ||
-                ci_find_substr(sText.substr(0, it->length()), *it) == -1) {
-                return false;
-            }
-
-            sText = sText.substr(it->length(), sText.length() - it->length());
-        } else if (it == vPattern.end() - 1 && *it != "") { //linenend: vPat[i]$
-            if (sText.length() < it->length() ||
-                ci_find_substr(sText.substr(sText.length() - it->length(),
-                                            it->length()), *it) == -1) {
-                return false;
-            }
-        } else { //inbetween: vPat[i]
-            if (*it != "") {
-                if ((iPos = (int)ci_find_substr(sText, *it)) == -1) {
-                    return false;
-                }
-
-                sText = sText.substr(iPos + (int)it->length(), (int)sText.length() - iPos);
-            }
+    //inbetween: vSegments[i], each after the one before
+    for( size_t i = 1; i + 1 < vSegments.size(); i++ ) {
+        if( vSegments[i].empty() ) {
+            continue;
         }
+        const size_t iFound = sFoldedText.find( vSegments[i], iPos );
+        if( iFound == std::string::npos ) {
+            return false;
+        }
+        iPos = iFound + vSegments[i].length();
     }
 
-    return true;
-}
-
-std::vector<std::string> &auto_pickup::split(const std::string &s, char delim, std::vector<std::string> &elems)
-{
-    std::stringstream ss(s);
-    std::string item;
-    elems.clear();
-    while (std::getline(ss, item, delim)) {
-        elems.push_back(item);
-    }
-
-    if ( s.substr(s.length() - 1, 1) == "*") {
-        elems.push_back("");
-    }
-
-    return elems;
+    //lineend: vSegments[n]$, not overlapping the ones before
+    const std::string &sLast = vSegments.back();
+    return sFoldedText.length() - iPos >= sLast.length() &&
+           sFoldedText.compare( sFoldedText.length() - sLast.length(), sLast.length(), sLast ) == 0;
 }
 
 // find substring (case insensitive)
@@ -667,9 +621,23 @@ int auto_pickup::ci_find_substr( const charT &str1, const charT &str2, const std
     }
 }
 
-const std::string &auto_pickup::check_item(const std::string &sItemName)
+rule_state auto_pickup::check_item( const std::string &sItemName )
 {
-    return mapItems[sItemName];
+    const auto iter = mapItems.find( sItemName );
+    if( iter != mapItems.end() ) {
+        return iter->second;
+    }
+
+    rule_state state = RULE_NONE;
+    const std::string sFolded = fold_case( sItemName );
+    for( auto it = vCompiledRules.rbegin(); it != vCompiledRules.rend(); ++it ) {
+        if( it->matches( sFolded ) ) {
+            state = it->bExclude ? RULE_BLACKLISTED : RULE_WHITELISTED;
+            break;
+        }
+    }
+    mapItems[sItemName] = state;
+    return state;
 }
 
 void auto_pickup::clear_character_rules()
@@ -718,7 +686,6 @@ bool auto_pickup::save(const bool bCharacter)
         serialize(jout);
 
         if(!bCharacter) {
-            merge_vector();
             create_rules();
         }
 
@@ -771,7 +738,6 @@ void auto_pickup::load(const bool bCharacter)
     }
 
     fin.close();
-    merge_vector();
     create_rules();
 }
 
@@ -8,6 +8,12 @@
 #include <algorithm>
 #include "json.h"
 
+enum rule_state : int {
+    RULE_NONE,
+    RULE_WHITELISTED,
+    RULE_BLACKLISTED
+};
+
 class auto_pickup : public JsonSerializer, public JsonDeserializer
 {
     private:
@@ -25,12 +31,10 @@ class auto_pickup : public JsonSerializer, public JsonDeserializer
         };
 
         void test_pattern( const int iCurrentPage, const int iCurrentLine );
-        std::string trim_rule( const std::string &sPatternIn );
+        static std::string trim_rule( const std::string &sPatternIn );
         void merge_vector();
         void save_reset_changes( const bool bReset );
-        bool match( const std::string &sTextIn, const std::string &sPatternIn );
-        std::vector<std::string> &split( const std::string &s, char delim,
-                                         std::vector<std::string> &elems );
+        static std::string fold_case( const std::string &sText );
         template<typename charT>
         int ci_find_substr( const charT &str1, const charT &str2, const std::locale &loc = std::locale() );
 
@@ -38,7 +42,7 @@ class auto_pickup : public JsonSerializer, public JsonDeserializer
         bool save( const bool bCharacter );
         bool load_legacy( const bool bCharacter );
 
-        bool bChar;
+        bool bChar = false;
 
         enum type {
             MERGED = 0,
@@ -69,16 +73,39 @@ class auto_pickup : public JsonSerializer, public JsonDeserializer
         };
 
         /**
-         * The currently-active set of auto-pickup rules, in a form that allows quick
-         * lookup. When this is filled (by @ref auto_pickup::create_rules()), every
-         * item existing in the game that matches a rule (either white- or blacklist)
-         * is added as the key, with "true" or "false" as the values.
+         * A rule split at its wildcards, with the case folded by @ref fold_case, so matching
+         * an item name only compares the folded name against the pieces.
+         */
+        class cCompiledRule
+        {
+            public:
+                cCompiledRule( const std::string &sRule, bool bExcludeIn );
+
+                /** Whether the rule matches the item name, which has to be folded already. */
+                bool matches( const std::string &sFoldedText ) const;
+
+                bool bExclude;
+
+            private:
+                // The pieces between the wildcards: the first one has to be at the start
+                // of the name, the last one at the end, either one may be empty
+                std::vector<std::string> vSegments;
+        };
+
+        /**
+         * The active rules of vRules[MERGED], in order. Filled by @ref auto_pickup::create_rules().
+         */
+        std::vector<cCompiledRule> vCompiledRules;
+
+        /**
+         * The verdicts of the item names checked since the rules last changed, filled
+         * by @ref auto_pickup::check_item() and cleared by @ref auto_pickup::create_rules().
          */
-        std::unordered_map<std::string, std::string> mapItems;
+        std::unordered_map<std::string, rule_state> mapItems;
 
         /**
          * An ugly hackish mess. Contains:
-         * - vRules[0] aka vRules[MERGED]: the current set of rules; used to fill @ref mapItems.
+         * - vRules[0] aka vRules[MERGED]: the current set of rules; used to fill @ref vCompiledRules.
          *      Filled by a call to @ref auto_pickup::merge_vector()
          * - vRules[1,2] aka vRules[GLOBAL,CHARACTER]: current rules split into global and
          *      character-specific. Allows the editor to show one or the other.
@@ -92,9 +119,11 @@ class auto_pickup : public JsonSerializer, public JsonDeserializer
         bool has_rule( const std::string &sRule );
         void add_rule( const std::string &sRule );
         void remove_rule( const std::string &sRule );
-        void create_rules( const std::string &sItemNameIn = "" );
+        /** Merges the global and character rules and compiles them, forgetting old verdicts. */
+        void create_rules();
         void clear_character_rules();
-        const std::string &check_item( const std::string &sItemName );
+        /** The last active rule matching the item name decides, global rules come first. */
+        rule_state check_item( const std::string &sItemName );
 
         void show();
         bool save_character();
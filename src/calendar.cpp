@@ -13,6 +13,9 @@ calendar calendar::turn;
 season_type calendar::initial_season;
 bool calendar::eternal_season = false;
 
+// The time is printed each time the sidebar is drawn
+static const option<std::string> option_24_hour( "24_HOUR" );
+
 // Internal constants, not part of the calendar interface.
 // Times for sunrise, sunset at equinoxes
 #define SUNRISE_WINTER   7
@@ -266,10 +269,10 @@ std::string calendar::print_time(bool just_hour) const
     std::stringstream time_string;
     int hour_param;
 
-    if (OPTIONS["24_HOUR"] == "military") {
+    if (option_24_hour.get() == "military") {
         hour_param = hour % 24;
         time_string << string_format("%02d%02d.%02d", hour_param, minute, second);
-    } else if (OPTIONS["24_HOUR"] == "24h") {
+    } else if (option_24_hour.get() == "24h") {
         hour_param = hour % 24;
         if (just_hour) {
             time_string << hour_param;
@@ -46,6 +46,10 @@ extern bool tile_iso;
 //the minimap texture pool which is used to reduce new texture allocation spam
 static minimap_shared_texture_pool tex_pool;
 
+// Read for each frame the pixel minimap is drawn
+static const option<int> option_pixel_minimap_blink( "PIXEL_MINIMAP_BLINK" );
+static const option<bool> option_pixel_minimap_ratio( "PIXEL_MINIMAP_RATIO" );
+
 SDL_Color cursesColorToSDL(int color);
 
 static const std::string empty_string;
@@ -1165,7 +1169,7 @@ void cata_tiles::init_minimap( int destx, int desty, int width, int height )
     minimap_tile_size.x = std::max( width / minimap_tiles_range.x, 1 );
     minimap_tile_size.y = std::max( height / minimap_tiles_range.y, 1 );
     //maintain a square "pixel" shape
-    if (OPTIONS["PIXEL_MINIMAP_RATIO"]) {
+    if (option_pixel_minimap_ratio) {
         int smallest_size = std::min( minimap_tile_size.x, minimap_tile_size.y );
         minimap_tile_size.x = smallest_size;
         minimap_tile_size.y = smallest_size;
@@ -1322,7 +1326,7 @@ void cata_tiles::draw_minimap( int destx, int desty, const tripoint &center, int
 
     //handles the enemy faction red highlights
     //this value should be divisible by 200
-    const int indicator_length = OPTIONS["PIXEL_MINIMAP_BLINK"] * 200; //default is 2000 ms, 2 seconds
+    const int indicator_length = option_pixel_minimap_blink * 200; //default is 2000 ms, 2 seconds
     int indicator_tick = 0; //if blink is disabled, leave at 0
     if( indicator_length > 0 ) {
         indicator_tick = SDL_GetTicks() % indicator_length;
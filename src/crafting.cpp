@@ -457,6 +457,8 @@ const inventory& player::crafting_inventory()
         tools.charges = power_level;
         cached_crafting_inventory += tools;
     }
+    // The recipes are checked against the same items over and over
+    cached_crafting_inventory.build_index();
     cached_moves = moves;
     cached_turn = calendar::turn.get_turn();
     cached_position = pos();
@@ -0,0 +1,121 @@
+#include "crafting_index.h"
+
+#include "item.h"
+#include "itype.h"
+
+#include <algorithm>
+#include <climits>
+
+// The best level of each quality of the item and its contents, like item::get_quality
+static void gather_qualities( const item &it, std::map<std::string, int> &qualities )
+{
+    for( const auto &quality : it.type->qualities ) {
+        auto iter = qualities.find( quality.first );
+        if( iter == qualities.end() ) {
+            qualities[quality.first] = quality.second;
+        } else {
+            iter->second = std::max( iter->second, quality.second );
+        }
+    }
+    for( const auto &elem : it.contents ) {
+        gather_qualities( elem, qualities );
+    }
+}
+
+void crafting_index::clear()
+{
+    types.clear();
+    quality_levels.clear();
+    max_qualities.clear();
+}
+
+void crafting_index::add( const item &it )
+{
+    add_amounts( it );
+    add_charges( it );
+
+    std::map<std::string, int> qualities;
+    gather_qualities( it, qualities );
+    // Containers with something inside only count for max_quality
+    const bool counts = it.contents.empty() || !it.is_container();
+    const long count = it.count_by_charges() ? it.charges : 1;
+    for( const auto &quality : qualities ) {
+        auto iter = max_qualities.find( quality.first );
+        if( iter == max_qualities.end() ) {
+            max_qualities[quality.first] = quality.second;
+        } else {
+            iter->second = std::max( iter->second, quality.second );
+        }
+        if( counts ) {
+            quality_levels[quality.first][quality.second] += count;
+        }
+    }
+}
+
+// Like item::amount_of
+void crafting_index::add_amounts( const item &it )
+{
+    if( it.contents.empty() ) {
+        type_amounts &amounts = types[it.type->iid];
+        amounts.tools++;
+        if( !it.has_flag( "PSEUDO" ) ) {
+            amounts.components++;
+        }
+    }
+    for( const auto &elem : it.contents ) {
+        add_amounts( elem );
+    }
+}
+
+// Like item::charges_of
+void crafting_index::add_charges( const item &it )
+{
+    if( !it.contents.empty() ) {
+        for( const auto &elem : it.contents ) {
+            add_charges( elem );
+        }
+        return;
+    }
+    const long charges = it.charges < 0 ? 1 : it.charges;
+    types[it.type->iid].charges += charges;
+    if( it.is_tool() ) {
+        const itype_iid subtype = dynamic_cast<const it_tool *>( it.type )->subtype_iid;
+        if( subtype != itype_iid() && subtype != it.type->iid ) {
+            types[subtype].charges += charges;
+        }
+    }
+}
+
+int crafting_index::amount_of( const itype_iid type, const bool used_as_tool ) const
+{
+    const auto iter = types.find( type );
+    if( iter == types.end() ) {
+        return 0;
+    }
+    return used_as_tool ? iter->second.tools : iter->second.components;
+}
+
+long crafting_index::charges_of( const itype_iid type ) const
+{
+    const auto iter = types.find( type );
+    return iter == types.end() ? 0 : iter->second.charges;
+}
+
+long crafting_index::quality_count( const std::string &quality_id, const int level ) const
+{
+    const auto iter = quality_levels.find( quality_id );
+    if( iter == quality_levels.end() ) {
+        return 0;
+    }
+    long found = 0;
+    for( auto lvl = iter->second.lower_bound( level ); lvl != iter->second.end(); ++lvl ) {
+        found += lvl->second;
+    }
+    return found;
+}
+
+int crafting_index::max_quality( const std::string &quality_id ) const
+{
+    const auto iter = max_qualities.find( quality_id );
+    return iter == max_qualities.end() ? INT_MIN : iter->second;
+}
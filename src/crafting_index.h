@@ -0,0 +1,50 @@
+#ifndef CRAFTING_INDEX_H
+#define CRAFTING_INDEX_H
+
+#include "itype_iid.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+class item;
+
+/**
+ * What the items of an inventory amount to for crafting: how many items and charges of
+ * each type there are and how many items have a quality at each level, summed up once so
+ * that checking the requirements of many recipes doesn't look at every item for each
+ * component. It answers like the corresponding functions of @ref inventory.
+ * It is built again with each inventory, not kept up to date as items move.
+ */
+class crafting_index
+{
+    public:
+        void clear();
+        /** Adds an item of an inventory stack, including its contents. */
+        void add( const item &it );
+
+        int amount_of( itype_iid type, bool used_as_tool ) const;
+        long charges_of( itype_iid type ) const;
+        /** Items (or charges) that have the quality at least at the level, empty containers only. */
+        long quality_count( const std::string &quality_id, int level ) const;
+        /** INT_MIN if no item has the quality. */
+        int max_quality( const std::string &quality_id ) const;
+
+    private:
+        struct type_amounts {
+            int tools = 0;
+            // Without the pseudo items
+            int components = 0;
+            long charges = 0;
+        };
+
+        void add_amounts( const item &it );
+        void add_charges( const item &it );
+
+        std::unordered_map<itype_iid, type_amounts> types;
+        // By quality id, then by the level of the best quality of each item
+        std::unordered_map<std::string, std::map<int, long>> quality_levels;
+        std::unordered_map<std::string, int> max_qualities;
+};
+
+#endif
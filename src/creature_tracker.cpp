@@ -4,6 +4,12 @@
 #include "debug.h"
 #include "mtype.h"
 #include "item.h"
+#include "line.h"
+#include "coordinate_conversions.h"
+#include "game_constants.h"
+
+#include <algorithm>
+#include <climits>
 
 Creature_tracker::Creature_tracker()
 {
@@ -71,6 +77,8 @@ bool Creature_tracker::add( monster &critter )
 
     monsters_by_location[critter.pos()] = monsters_list.size();
     monsters_list.push_back( new monster( critter ) );
+    submap_of.push_back( ms_to_sm_copy( critter.pos() ) );
+    monsters_by_submap[submap_of.back()].push_back( monsters_list.back() );
     return true;
 }
 
@@ -82,6 +90,13 @@ size_t Creature_tracker::size() const
 bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_pos )
 {
     const auto old_pos = critter.pos();
+    // monster::setpos moves the monster even if we refuse the new position below,
+    // so the submap index must follow it in any case.
+    const int idx = index_of( critter );
+    if( idx >= 0 ) {
+        update_submap_index( idx, new_pos );
+    }
+
     if( critter.is_dead() ) {
         // mon_at ignores dead critters anyway, changing their position in the
         // monsters_by_location map is useless.
@@ -151,9 +166,11 @@ void Creature_tracker::remove( const int idx )
 
     monster &m = *monsters_list[idx];
     remove_from_location_map( m );
+    remove_from_submap_index( idx );
 
     delete monsters_list[idx];
     monsters_list.erase( monsters_list.begin() + idx );
+    submap_of.erase( submap_of.begin() + idx );
 
     // Fix indices in monsters_by_location for any zombies that were just moved down 1 place.
     for( auto &elem : monsters_by_location ) {
@@ -170,14 +187,20 @@ void Creature_tracker::clear()
     }
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
+    submap_of.clear();
 }
 
 void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    monsters_by_submap.clear();
+    submap_of.clear();
     for( size_t i = 0; i < monsters_list.size(); i++ ) {
         monster &critter = *monsters_list[i];
         monsters_by_location[critter.pos()] = i;
+        submap_of.push_back( ms_to_sm_copy( critter.pos() ) );
+        monsters_by_submap[submap_of.back()].push_back( &critter );
     }
 }
 
@@ -209,8 +232,115 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     if( ok ) {
         monsters_by_location[first.pos()] = first_mdex;
         monsters_by_location[second.pos()] = second_mdex;
+        update_submap_index( first_mdex, first.pos() );
+        update_submap_index( second_mdex, second.pos() );
     } else {
         // Try to avoid spamming error messages if something weird happens
         rebuild_cache();
     }
 }
+
+int Creature_tracker::index_of( const monster &critter ) const
+{
+    const auto iter = monsters_by_location.find( critter.pos() );
+    if( iter != monsters_by_location.end() && monsters_list[iter->second] == &critter ) {
+        return iter->second;
+    }
+    // Dead monsters are not in the location map
+    const auto found = std::find( monsters_list.begin(), monsters_list.end(), &critter );
+    if( found != monsters_list.end() ) {
+        return found - monsters_list.begin();
+    }
+    return -1;
+}
+
+void Creature_tracker::update_submap_index( const size_t idx, const tripoint &new_pos )
+{
+    const tripoint new_submap = ms_to_sm_copy( new_pos );
+    if( submap_of[idx] == new_submap ) {
+        return;
+    }
+    remove_from_submap_index( idx );
+    submap_of[idx] = new_submap;
+    monsters_by_submap[new_submap].push_back( monsters_list[idx] );
+}
+
+void Creature_tracker::remove_from_submap_index( const size_t idx )
+{
+    const auto iter = monsters_by_submap.find( submap_of[idx] );
+    if( iter == monsters_by_submap.end() ) {
+        return;
+    }
+    auto &critters = iter->second;
+    const auto found = std::find( critters.begin(), critters.end(), monsters_list[idx] );
+    if( found != critters.end() ) {
+        critters.erase( found );
+    }
+    if( critters.empty() ) {
+        monsters_by_submap.erase( iter );
+    }
+}
+
+std::vector<monster *> Creature_tracker::find_near( const tripoint &p, const int radius ) const
+{
+    std::vector<monster *> result;
+    if( radius < 0 ) {
+        return result;
+    }
+    const auto add_from = [&]( const std::vector<monster *> &critters ) {
+        for( monster *critter : critters ) {
+            if( !critter->is_dead() && rl_dist( p, critter->pos() ) <= radius ) {
+                result.push_back( critter );
+            }
+        }
+    };
+
+    // rl_dist is never smaller than the distance along any axis, so a box is enough
+    const tripoint from = ms_to_sm_copy( tripoint( p.x - radius, p.y - radius, 0 ) );
+    const tripoint to = ms_to_sm_copy( tripoint( p.x + radius, p.y + radius, 0 ) );
+    const int min_z = std::max( p.z - radius, -OVERMAP_DEPTH );
+    const int max_z = std::min( p.z + radius, OVERMAP_HEIGHT );
+    const size_t num_submaps = size_t( to.x - from.x + 1 ) * size_t( to.y - from.y + 1 ) *
+                               size_t( max_z - min_z + 1 );
+    if( num_submaps >= monsters_by_submap.size() ) {
+        // Huge radius, checking the occupied submaps is cheaper than looking up every one in range
+        for( const auto &elem : monsters_by_submap ) {
+            add_from( elem.second );
+        }
+        return result;
+    }
+
+    tripoint sm;
+    for( sm.z = min_z; sm.z <= max_z; sm.z++ ) {
+        for( sm.x = from.x; sm.x <= to.x; sm.x++ ) {
+            for( sm.y = from.y; sm.y <= to.y; sm.y++ ) {
+                const auto iter = monsters_by_submap.find( sm );
+                if( iter != monsters_by_submap.end() ) {
+                    add_from( iter->second );
+                }
+            }
+        }
+    }
+    return result;
+}
+
+monster *Creature_tracker::find_nearest( const tripoint &p, const int radius,
+        const std::function<bool( const monster & )> &predicate ) const
+{
+    // Grow the searched area until something is found. Anything closer than a match
+    // found within some radius lies within the same radius, so the first hit is final.
+    for( int cur_radius = std::min( SEEX, radius ); ; cur_radius = std::min( cur_radius * 2, radius ) ) {
+        monster *best = nullptr;
+        int best_dist = INT_MAX;
+        for( monster *critter : find_near( p, cur_radius ) ) {
+            const int dist = rl_dist( p, critter->pos() );
+            if( dist < best_dist && predicate( *critter ) ) {
+                best = critter;
+                best_dist = dist;
+            }
+        }
+        if( best != nullptr || cur_radius >= radius ) {
+            return best;
+        }
+    }
+}
@@ -2,6 +2,7 @@
 #define CREATURE_TRACKER_H
 
 #include "enums.h"
+#include <functional>
 #include <vector>
 #include <unordered_map>
 
@@ -30,12 +31,40 @@ class Creature_tracker
         const std::vector<monster> &list() const;
         /** Swaps the positions of two monsters */
         void swap_positions( monster &first, monster &second );
+        /**
+         * Returns all living monsters (including hallucinations) that are at most
+         * radius away from p, as measured by rl_dist. Only looks at the submaps
+         * around p, so the cost depends on how crowded the area is, not on the
+         * total number of monsters.
+         */
+        std::vector<monster *> find_near( const tripoint &p, int radius ) const;
+        /**
+         * Returns the closest living monster within radius of p for which the predicate
+         * returns true, or nullptr if there is none. Searches outwards from p and stops
+         * at the first match, so nearby matches are cheap to find.
+         */
+        monster *find_nearest( const tripoint &p, int radius,
+                               const std::function<bool( const monster & )> &predicate ) const;
 
     private:
         std::vector<monster *> monsters_list;
         std::unordered_map<tripoint, size_t> monsters_by_location;
+        /**
+         * Monsters sorted by the submap they are on (key is in submap coordinates),
+         * used for the area queries. Unlike @ref monsters_by_location, dead monsters
+         * are kept here until they are removed, so it always contains every monster.
+         */
+        std::unordered_map<tripoint, std::vector<monster *>> monsters_by_submap;
+        /** Key in @ref monsters_by_submap for each entry in @ref monsters_list */
+        std::vector<tripoint> submap_of;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        /** Index of the monster in @ref monsters_list, or -1 if it's not there */
+        int index_of( const monster &critter ) const;
+        /** Files the monster at idx under the submap containing new_pos */
+        void update_submap_index( size_t idx, const tripoint &new_pos );
+        /** Removes the monster at idx from @ref monsters_by_submap */
+        void remove_from_submap_index( size_t idx );
 };
 
 #endif
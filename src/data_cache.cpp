@@ -0,0 +1,116 @@
+#include "data_cache.h"
+
+#include "debug.h"
+#include "filesystem.h"
+#include "json.h"
+#include "veh_type.h"
+
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+#if (defined _WIN32 || defined __WIN32__)
+#   include "platform_win.h"
+#else
+#   include <unistd.h>
+#endif
+
+static long current_process_id()
+{
+#if (defined _WIN32 || defined __WIN32__)
+    return GetCurrentProcessId();
+#else
+    return getpid();
+#endif
+}
+
+// Path of the running executable, empty if it can't be found
+static std::string executable_path()
+{
+#if (defined _WIN32 || defined __WIN32__)
+    char buffer[MAX_PATH];
+    const DWORD length = GetModuleFileNameA( NULL, buffer, sizeof( buffer ) );
+    return length > 0 && length < sizeof( buffer ) ? std::string( buffer, length ) : std::string();
+#elif defined __linux__
+    char buffer[4096];
+    const ssize_t length = readlink( "/proc/self/exe", buffer, sizeof( buffer ) );
+    return length > 0 && length < static_cast<ssize_t>( sizeof( buffer ) ) ?
+           std::string( buffer, length ) : std::string();
+#else
+    return std::string();
+#endif
+}
+
+bool data_cache::load( const std::string &path, const std::string &key )
+{
+    const mapped_file cache( path );
+    if( !cache.is_open() ) {
+        return false;
+    }
+    try {
+        JsonIn jsin( cache.data(), cache.size() );
+        jsin.start_object();
+        // The key comes first, a cache for other data is rejected without reading the rest
+        if( jsin.get_member_name() != "key" || jsin.get_string() != key ) {
+            return false;
+        }
+        while( !jsin.end_object() ) {
+            const std::string name = jsin.get_member_name();
+            if( name == "vehicle_blueprints" ) {
+                vehicle_prototype::load_blueprints( jsin );
+            } else {
+                jsin.skip_value();
+            }
+        }
+    } catch( const JsonError &err ) {
+        DebugLog( D_WARNING, D_MAIN ) << "Ignoring the data cache " << path << ": " << err.what();
+        return false;
+    }
+    return true;
+}
+
+void data_cache::save( const std::string &path, const std::string &key )
+{
+    const size_t separator = path.find_last_of( "/\\" );
+    if( separator != std::string::npos ) {
+        assure_dir_exist( path.substr( 0, separator ) );
+    }
+    // Games starting at the same time must never read half a cache, or write into the same
+    // temporary file, so each one writes its own and renames it into place
+    std::ostringstream temp_name;
+    temp_name << path << "." << current_process_id() << ".temp";
+    const std::string temp_path = temp_name.str();
+    {
+        std::ofstream fout( temp_path.c_str(), std::ios_base::binary );
+        JsonOut jsout( fout );
+        jsout.start_object();
+        jsout.member( "key", key );
+        jsout.member( "vehicle_blueprints" );
+        vehicle_prototype::save_blueprints( jsout );
+        jsout.end_object();
+        if( !fout.good() ) {
+            DebugLog( D_WARNING, D_MAIN ) << "Failed to write the data cache " << temp_path;
+            remove_file( temp_path );
+            return;
+        }
+    }
+    if( !rename_file( temp_path, path ) ) {
+        DebugLog( D_WARNING, D_MAIN ) << "Failed to replace the data cache " << path;
+        remove_file( temp_path );
+    }
+}
+
+std::string data_cache::build_id()
+{
+    // The executable changes with every build
+    const std::string exe = executable_path();
+    struct stat exe_stat;
+    if( !exe.empty() && stat( exe.c_str(), &exe_stat ) == 0 ) {
+        std::ostringstream id;
+        id << static_cast<long long>( exe_stat.st_size ) << "-" <<
+           static_cast<long long>( exe_stat.st_mtime );
+        return id.str();
+    }
+    // At least a rebuild of this file gives another id
+    return __DATE__ " " __TIME__;
+}
@@ -0,0 +1,28 @@
+#ifndef DATA_CACHE_H
+#define DATA_CACHE_H
+
+#include <string>
+
+/**
+ * Game data that is slow to finalize, kept in a file so that the next start with the
+ * same data files can skip it. Only the vehicle prototype blueprints are kept: the JSON
+ * data files are still read and parsed on every start, as items, monsters, terrain,
+ * recipes, mapgen and overmap terrain have no serialization of their finalized state.
+ *
+ * The cache stores the key of the data it was written for
+ * (see DynamicDataLoader::get_data_key), any other cache is ignored and replaced.
+ */
+namespace data_cache
+{
+/** Reads the cache into the loaded data, returns false if there is none for this key. */
+bool load( const std::string &path, const std::string &key );
+/** Writes the finalized data to the cache. */
+void save( const std::string &path, const std::string &key );
+/**
+ * Identifies the build of the running game, so that a rebuilt game ignores the caches
+ * of the previous build even if the version string stayed the same.
+ */
+std::string build_id();
+}
+
+#endif
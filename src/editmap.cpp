@@ -1799,6 +1799,7 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
                                 }
                             }
                             destsm->field_count = srcsm->field_count; // and count
+                            destsm->field_tiles = srcsm->field_tiles;
 
                             std::memcpy( *destsm->ter, srcsm->ter, sizeof( srcsm->ter ) ); // terrain
                             std::memcpy( *destsm->frn, srcsm->frn, sizeof( srcsm->frn ) ); // furniture
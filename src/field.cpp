@@ -14,6 +14,9 @@
 #include "submap.h"
 #include "mapdata.h"
 #include "mtype.h"
+#include "turn_profiler.h"
+
+#include <algorithm>
 
 const species_id FUNGUS( "FUNGUS" );
 
@@ -367,6 +370,7 @@ field_id field_from_ident(const std::string &field_ident)
 
 bool map::process_fields()
 {
+    PROFILE_SECTION( PROFILE_FIELDS );
     bool dirty_transparency_cache = false;
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
@@ -448,6 +452,29 @@ bool at_edge( const size_t x, const size_t y )
     return x == 0 || x == SEEX || y == 0 || y == SEEY;
 }
 
+namespace {
+
+/**
+ * Refers to the entry of a given type in a field, looked up anew on each access.
+ * Processing a field entry can add other fields to the same square, which
+ * moves the entries around, so a plain pointer would not survive that.
+ */
+class field_entry_ref
+{
+    public:
+        field_entry_ref( field &fld, const field_id type ) : fld( fld ), type( type ) { }
+
+        field_entry *operator->() const {
+            return fld.findField( type );
+        }
+
+    private:
+        field &fld;
+        field_id type;
+};
+
+}
+
 /*
 Function: process_fields_in_submap
 Iterates over every field on every tile of the given submap given as parameter.
@@ -487,7 +514,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
     };
 
     const auto spread_gas = [this, &get_neighbors] (
-        field_entry *cur, const tripoint &p, field_id curtype,
+        const field_entry_ref &cur, const tripoint &p, field_id curtype,
         int percent_spread, int outdoor_age_speedup ) {
         // Reset nearby scents to zero
         tripoint tmp;
@@ -622,9 +649,14 @@ bool map::process_fields_in_submap( submap *const current_submap,
     maptile map_tile( current_submap, 0, 0 );
     size_t &locx = map_tile.x;
     size_t &locy = map_tile.y;
-    //Loop through all tiles in this submap indicated by current_submap
+    //Loop through all tiles in this submap that have fields on them
+    auto &field_tiles = current_submap->field_tiles;
     for( locx = 0; locx < SEEX; locx++ ) {
         for( locy = 0; locy < SEEY; locy++ ) {
+            const size_t tile = locx * SEEY + locy;
+            if( !field_tiles[tile] ) {
+                continue;
+            }
             // This is a translation from local coordinates to submap coords.
             // All submaps are in one long 1d array.
             thep.x = locx + submap_x * SEEX;
@@ -634,16 +666,22 @@ bool map::process_fields_in_submap( submap *const current_submap,
             // Get a reference to the field variable from the submap;
             // contains all the pointers to the real field effects.
             field &curfield = current_submap->fld[locx][locy];
-            for( auto it = curfield.begin(); it != curfield.end();) {
+            // Fields added to this square while processing it get processed as well if
+            // their type comes after the current one, so step by type, not by iterator.
+            field_id processed_type = fd_null;
+            for( auto it = curfield.begin(); it != curfield.end();
+                 it = curfield.next_after( processed_type ) ) {
                 //Iterating through all field effects in the submap's field.
-                field_entry * cur = &it->second;
+                processed_type = it->first;
+                PROFILE_COUNT( PROFILE_FIELDS_PROCESSED, 1 );
+                const field_entry_ref cur( curfield, processed_type );
                 // The field might have been killed by processing a neighbour field
                 if( !cur->isAlive() ) {
                     if( !fieldlist[cur->getFieldType()].transparent[cur->getFieldDensity() - 1] ) {
                         dirty_transparency_cache = true;
                     }
                     current_submap->field_count--;
-                    curfield.removeField( it++ );
+                    curfield.removeField( it );
                     continue;
                 }
 
@@ -1686,11 +1724,12 @@ bool map::process_fields_in_submap( submap *const current_submap,
                 }
                 if( !cur->isAlive() ) {
                     current_submap->field_count--;
-                    curfield.removeField( it++ );
-                } else {
-                    ++it;
+                    curfield.removeField( processed_type );
                 }
             }
+            if( curfield.fieldCount() == 0 ) {
+                field_tiles.reset( tile );
+            }
         }
     }
     return dirty_transparency_cache;
@@ -1724,8 +1763,12 @@ void map::player_in_field( player &u )
     // Iterate through all field effects on this tile.
     // Do not remove the field with removeField, instead set it's density to 0. It will be removed
     // later by the field processing, which will also adjust field_count accordingly.
-    for( auto field_list_it = curfield.begin(); field_list_it != curfield.end(); ++field_list_it){
-        field_entry * cur = &field_list_it->second;
+    // The effects can add fields here (e.g. explosions), so step by type, not by iterator.
+    field_id cur_type = fd_null;
+    for( auto field_list_it = curfield.begin(); field_list_it != curfield.end();
+         field_list_it = curfield.next_after( cur_type ) ) {
+        cur_type = field_list_it->first;
+        const field_entry_ref cur( curfield, cur_type );
         if( !cur->isAlive() ) {
             continue;
         }
@@ -2178,8 +2221,12 @@ void map::monster_in_field( monster &z )
     // Iterate through all field effects on this tile.
     // Do not remove the field with removeField, instead set it's density to 0. It will be removed
     // later by the field processing, which will also adjust field_count accordingly.
-    for( auto field_list_it = curfield.begin(); field_list_it != curfield.end(); ++field_list_it ) {
-        field_entry * cur = &field_list_it->second;
+    // The effects can add fields here (e.g. explosions), so step by type, not by iterator.
+    field_id cur_type = fd_null;
+    for( auto field_list_it = curfield.begin(); field_list_it != curfield.end();
+         field_list_it = curfield.next_after( cur_type ) ) {
+        cur_type = field_list_it->first;
+        const field_entry_ref cur( curfield, cur_type );
         if( !cur->isAlive() ) {
             continue;
         }
@@ -2525,19 +2572,21 @@ Function: findField
 Returns a field entry corresponding to the field_id parameter passed in. If no fields are found then returns NULL.
 Good for checking for exitence of a field: if(myfield.findField(fd_fire)) would tell you if the field is on fire.
 */
+static bool entry_type_less( const std::pair<field_id, field_entry> &entry, const field_id type )
+{
+    return entry.first < type;
+}
+
 field_entry *field::findField( const field_id field_to_find )
 {
-    const auto it = field_list.find( field_to_find );
-    if( it != field_list.end() ) {
-        return &it->second;
-    }
-    return nullptr;
+    return const_cast<field_entry *>( findFieldc( field_to_find ) );
 }
 
 const field_entry *field::findFieldc( const field_id field_to_find ) const
 {
-    const auto it = field_list.find( field_to_find );
-    if( it != field_list.end() ) {
+    const auto it = std::lower_bound( field_list.begin(), field_list.end(), field_to_find,
+                                      entry_type_less );
+    if( it != field_list.end() && it->first == field_to_find ) {
         return &it->second;
     }
     return nullptr;
@@ -2557,29 +2606,30 @@ If you wish to modify an already existing field use findField and modify the res
 Density defaults to 1, and age to 0 (permanent) if not specified.
 */
 bool field::addField(const field_id field_to_add, const int new_density, const int new_age){
-    auto it = field_list.find(field_to_add);
+    auto it = std::lower_bound( field_list.begin(), field_list.end(), field_to_add, entry_type_less );
     if (fieldlist[field_to_add].priority >= fieldlist[draw_symbol].priority)
         draw_symbol = field_to_add;
-    if(it != field_list.end()) {
+    if( it != field_list.end() && it->first == field_to_add ) {
         //Already exists, but lets update it. This is tentative.
         it->second.setFieldDensity(it->second.getFieldDensity() + new_density);
         return false;
     }
-    field_list[field_to_add] = field_entry(field_to_add, new_density, new_age);
+    field_list.emplace( it, field_to_add, field_entry( field_to_add, new_density, new_age ) );
     return true;
 }
 
 bool field::removeField( field_id const field_to_remove )
 {
-    const auto it = field_list.find( field_to_remove );
-    if( it == field_list.end() ) {
+    const auto it = std::lower_bound( field_list.begin(), field_list.end(), field_to_remove,
+                                      entry_type_less );
+    if( it == field_list.end() || it->first != field_to_remove ) {
         return false;
     }
     removeField( it );
     return true;
 }
 
-void field::removeField( std::map<field_id, field_entry>::iterator const it )
+void field::removeField( entry_list::iterator const it )
 {
         field_list.erase( it );
         if( field_list.empty() ) {
@@ -2603,26 +2653,34 @@ unsigned int field::fieldCount() const
     return field_list.size();
 }
 
-std::map<field_id, field_entry>::iterator field::begin()
+field::entry_list::iterator field::begin()
 {
     return field_list.begin();
 }
 
-std::map<field_id, field_entry>::const_iterator field::begin() const
+field::entry_list::const_iterator field::begin() const
 {
     return field_list.begin();
 }
 
-std::map<field_id, field_entry>::iterator field::end()
+field::entry_list::iterator field::end()
 {
     return field_list.end();
 }
 
-std::map<field_id, field_entry>::const_iterator field::end() const
+field::entry_list::const_iterator field::end() const
 {
     return field_list.end();
 }
 
+field::entry_list::iterator field::next_after( const field_id type )
+{
+    return std::upper_bound( field_list.begin(), field_list.end(), type,
+    []( const field_id t, const std::pair<field_id, field_entry> &entry ) {
+        return t < entry.first;
+    } );
+}
+
 /*
 Function: fieldSymbol
 Returns the last added field from the tile for drawing purposes.
@@ -5,7 +5,6 @@
 
 #include <vector>
 #include <string>
-#include <map>
 #include <iosfwd>
 
 /*
@@ -176,9 +175,16 @@ private:
  * Use @ref findField to get the field entry of a specific type, or iterate over
  * all entries via @ref begin and @ref end (allows range based iteration).
  * There is @ref fieldSymbol to specific which field should be drawn on the map.
+ *
+ * The entries are stored in a flat vector sorted by type, because most tiles have
+ * no fields at all and the rest rarely more than two. Adding or removing an entry
+ * invalidates pointers and iterators to the others, so code that may add fields
+ * to a tile while iterating over it must use @ref next_after instead of incrementing.
 */
 class field{
 public:
+    typedef std::vector<std::pair<field_id, field_entry>> entry_list;
+
     field();
     ~field();
 
@@ -218,7 +224,7 @@ public:
      * Make sure to decrement the field counter in the submap.
      * Removes the field entry, the iterator must point into @ref field_list and must be valid.
      */
-    void removeField( std::map<field_id, field_entry>::iterator );
+    void removeField( entry_list::iterator );
 
     //Returns the number of fields existing on the current tile.
     unsigned int fieldCount() const;
@@ -229,12 +235,18 @@ public:
     field_id fieldSymbol() const;
 
     //Returns the vector iterator to begin searching through the list.
-    std::map<field_id, field_entry>::iterator begin();
-    std::map<field_id, field_entry>::const_iterator begin() const;
+    entry_list::iterator begin();
+    entry_list::const_iterator begin() const;
 
     //Returns the vector iterator to end searching through the list.
-    std::map<field_id, field_entry>::iterator end();
-    std::map<field_id, field_entry>::const_iterator end() const;
+    entry_list::iterator end();
+    entry_list::const_iterator end() const;
+
+    /**
+     * Returns the first entry with a type that comes after the given one, or @ref end.
+     * Use it to step to the next entry when fields may have been added in the meantime.
+     */
+    entry_list::iterator next_after( field_id type );
 
     /**
      * Returns the total move cost from all fields.
@@ -242,7 +254,7 @@ public:
     int move_cost() const;
 
 private:
-    std::map<field_id, field_entry> field_list; //A pointer lookup table of all field effects on the current tile.    //Draw_symbol currently is equal to the last field added to the square. You can modify this behavior in the class functions if you wish.
+    entry_list field_list; //A lookup table of all field effects on the current tile.    //Draw_symbol currently is equal to the last field added to the square. You can modify this behavior in the class functions if you wish.
     field_id draw_symbol;
 };
 
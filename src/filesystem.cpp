@@ -25,6 +25,9 @@
 
 #if defined(_WIN32) || defined (__WIN32__)
 #   include "platform_win.h"
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
 #endif
 
 //--------------------------------------------------------------------------------------------------
@@ -320,3 +323,66 @@ std::vector<std::string> get_directories_with(std::vector<std::string> const &pa
 
     return files;
 }
+
+#if (defined _WIN32 || defined __WIN32__)
+mapped_file::mapped_file( const std::string &path )
+{
+    HANDLE file = CreateFile( path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+    if( file == INVALID_HANDLE_VALUE ) {
+        return;
+    }
+    opened = true;
+    LARGE_INTEGER file_size;
+    if( GetFileSizeEx( file, &file_size ) && file_size.QuadPart > 0 ) {
+        HANDLE mapping = CreateFileMapping( file, NULL, PAGE_READONLY, 0, 0, NULL );
+        if( mapping != NULL ) {
+            text = static_cast<const char *>( MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) );
+            if( text != nullptr ) {
+                length = file_size.QuadPart;
+            }
+            // The view keeps the mapping alive
+            CloseHandle( mapping );
+        }
+    }
+    CloseHandle( file );
+}
+
+mapped_file::~mapped_file()
+{
+    if( text != nullptr ) {
+        UnmapViewOfFile( text );
+    }
+}
+#else
+mapped_file::mapped_file( const std::string &path )
+{
+    const int fd = open( path.c_str(), O_RDONLY );
+    if( fd == -1 ) {
+        return;
+    }
+    opened = true;
+    struct stat result;
+    if( fstat( fd, &result ) == 0 && result.st_size > 0 ) {
+        void *const mapping = mmap( nullptr, result.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if( mapping != MAP_FAILED ) {
+            text = static_cast<const char *>( mapping );
+            length = result.st_size;
+            // The file is read front to back
+            madvise( mapping, length, MADV_SEQUENTIAL );
+        } else {
+            auto const e_str = strerror( errno );
+            DebugLog( D_WARNING, D_MAIN ) << "mmap [" << path << "] failed with \"" << e_str << "\".";
+        }
+    }
+    // The mapping keeps the file alive
+    close( fd );
+}
+
+mapped_file::~mapped_file()
+{
+    if( text != nullptr ) {
+        munmap( const_cast<char *>( text ), length );
+    }
+}
+#endif
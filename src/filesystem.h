@@ -1,6 +1,7 @@
 #ifndef CATA_FILE_SYSTEM_H
 #define CATA_FILE_SYSTEM_H
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -41,4 +42,36 @@ std::vector<std::string> get_directories_with( std::vector<std::string> const &p
 
 std::vector<std::string> get_directories_with( std::string const &pattern,
         std::string const &root_path = "", bool const recurse = false );
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A read only view of a whole file, mapped into memory.
+ *
+ * The pages are read by the operating system as they are touched, nothing is copied.
+ * Where mapping is not possible, e.g. for an empty file, the view is empty.
+ */
+class mapped_file
+{
+    public:
+        mapped_file( const std::string &path );
+        ~mapped_file();
+        mapped_file( const mapped_file & ) = delete;
+        mapped_file &operator=( const mapped_file & ) = delete;
+
+        // Whether the file could be opened, an empty file counts as open
+        bool is_open() const {
+            return opened;
+        }
+        const char *data() const {
+            return text != nullptr ? text : "";
+        }
+        size_t size() const {
+            return length;
+        }
+
+    private:
+        const char *text = nullptr;
+        size_t length = 0;
+        bool opened = false;
+};
 #endif //CATA_FILE_SYSTEM_H
@@ -0,0 +1,158 @@
+#include "flag_set.h"
+
+#include <deque>
+#include <unordered_map>
+
+struct interned_flags {
+    std::unordered_map<std::string, size_t> ids;
+    // A deque keeps the names valid for the iterators when more flags are interned
+    std::deque<std::string> names;
+};
+
+static interned_flags &interned()
+{
+    static interned_flags flags;
+    return flags;
+}
+
+static size_t intern_flag( const std::string &flag )
+{
+    interned_flags &flags = interned();
+    const auto iter = flags.ids.find( flag );
+    if( iter != flags.ids.end() ) {
+        return iter->second;
+    }
+    const size_t id = flags.names.size();
+    flags.ids[flag] = id;
+    flags.names.push_back( flag );
+    return id;
+}
+
+// Flags that were never interned are not in any set
+static bool find_flag( const std::string &flag, size_t &id )
+{
+    const interned_flags &flags = interned();
+    const auto iter = flags.ids.find( flag );
+    if( iter == flags.ids.end() ) {
+        return false;
+    }
+    id = iter->second;
+    return true;
+}
+
+static size_t count_bits( uint64_t word )
+{
+    size_t result = 0;
+    for( ; word != 0; word &= word - 1 ) {
+        result++;
+    }
+    return result;
+}
+
+flag_set::const_iterator::const_iterator( const flag_set &set, const size_t pos )
+    : set( &set ), pos( pos )
+{
+    skip_unset();
+}
+
+void flag_set::const_iterator::skip_unset()
+{
+    const size_t end = set->bit_count();
+    while( pos < end && !set->test( pos ) ) {
+        pos++;
+    }
+}
+
+const std::string &flag_set::const_iterator::operator*() const
+{
+    return interned().names[pos];
+}
+
+const std::string *flag_set::const_iterator::operator->() const
+{
+    return &interned().names[pos];
+}
+
+flag_set::const_iterator &flag_set::const_iterator::operator++()
+{
+    pos++;
+    skip_unset();
+    return *this;
+}
+
+bool flag_set::test( const size_t id ) const
+{
+    if( id < word_bits ) {
+        return ( bits >> id ) & 1;
+    }
+    const size_t word = id / word_bits - 1;
+    return word < more_bits.size() && ( ( more_bits[word] >> ( id % word_bits ) ) & 1 );
+}
+
+size_t flag_set::count( const std::string &flag ) const
+{
+    size_t id;
+    // Most items have no flags of their own, that doesn't even need a look up
+    if( empty() || !find_flag( flag, id ) ) {
+        return 0;
+    }
+    return test( id ) ? 1 : 0;
+}
+
+void flag_set::insert( const std::string &flag )
+{
+    const size_t id = intern_flag( flag );
+    const uint64_t mask = uint64_t( 1 ) << ( id % word_bits );
+    if( id < word_bits ) {
+        bits |= mask;
+        return;
+    }
+    const size_t word = id / word_bits - 1;
+    if( more_bits.size() <= word ) {
+        more_bits.resize( word + 1, 0 );
+    }
+    more_bits[word] |= mask;
+}
+
+size_t flag_set::erase( const std::string &flag )
+{
+    size_t id;
+    if( empty() || !find_flag( flag, id ) || !test( id ) ) {
+        return 0;
+    }
+    const uint64_t mask = uint64_t( 1 ) << ( id % word_bits );
+    if( id < word_bits ) {
+        bits &= ~mask;
+        return 1;
+    }
+    more_bits[id / word_bits - 1] &= ~mask;
+    while( !more_bits.empty() && more_bits.back() == 0 ) {
+        more_bits.pop_back();
+    }
+    return 1;
+}
+
+void flag_set::clear()
+{
+    bits = 0;
+    more_bits.clear();
+}
+
+size_t flag_set::size() const
+{
+    size_t result = count_bits( bits );
+    for( const uint64_t word : more_bits ) {
+        result += count_bits( word );
+    }
+    return result;
+}
+
+flag_set::const_iterator flag_set::begin() const
+{
+    return const_iterator( *this, 0 );
+}
+
+flag_set::const_iterator flag_set::end() const
+{
+    return const_iterator( *this, bit_count() );
+}
@@ -0,0 +1,92 @@
+#ifndef FLAG_SET_H
+#define FLAG_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * A set of flag strings, stored as bits. Each flag that is ever added to a set is interned
+ * once into a bit position shared by all sets, so checking a flag is a bit test and comparing
+ * or copying two sets only compares or copies a few words. It behaves like a
+ * `std::set<std::string>` (and is stored in json like one), except that the flags are
+ * iterated in the order they were first interned.
+ */
+class flag_set
+{
+    public:
+        typedef std::string key_type;
+        typedef std::string value_type;
+
+        class const_iterator
+        {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef std::string value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef const std::string *pointer;
+                typedef const std::string &reference;
+
+                const_iterator( const flag_set &set, size_t pos );
+
+                const std::string &operator*() const;
+                const std::string *operator->() const;
+                const_iterator &operator++();
+                const_iterator operator++( int ) {
+                    const_iterator old = *this;
+                    ++*this;
+                    return old;
+                }
+                bool operator==( const const_iterator &rhs ) const {
+                    return pos == rhs.pos;
+                }
+                bool operator!=( const const_iterator &rhs ) const {
+                    return pos != rhs.pos;
+                }
+
+            private:
+                void skip_unset();
+
+                const flag_set *set;
+                size_t pos;
+        };
+
+        /** 1 if the flag is in the set, 0 otherwise. */
+        size_t count( const std::string &flag ) const;
+        void insert( const std::string &flag );
+        /** Returns the number of removed flags (0 or 1). */
+        size_t erase( const std::string &flag );
+        void clear();
+
+        bool empty() const {
+            return bits == 0 && more_bits.empty();
+        }
+        size_t size() const;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+
+        bool operator==( const flag_set &rhs ) const {
+            return bits == rhs.bits && more_bits == rhs.more_bits;
+        }
+        bool operator!=( const flag_set &rhs ) const {
+            return !( *this == rhs );
+        }
+
+    private:
+        static const size_t word_bits = 64;
+
+        bool test( size_t id ) const;
+        size_t bit_count() const {
+            return word_bits * ( 1 + more_bits.size() );
+        }
+
+        // The first flags ever interned, which are most of those in use
+        uint64_t bits = 0;
+        // The flags after those, without trailing zero words so that equal sets compare equal
+        std::vector<uint64_t> more_bits;
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/**
+ * A map stored as a vector of entries sorted by key. For the few entries maps usually hold
+ * (like the variables of an item), it takes less memory than a `std::map`, and copying it
+ * allocates once instead of once per entry. Inserting and erasing moves the entries after
+ * it, so it is not meant for large maps. It behaves like a `std::map` otherwise (and is
+ * stored in json like one), but inserting or erasing invalidates all iterators.
+ */
+template<typename K, typename V>
+class flat_map
+{
+    public:
+        typedef K key_type;
+        typedef V mapped_type;
+        typedef std::pair<K, V> value_type;
+        typedef typename std::vector<value_type>::iterator iterator;
+        typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+        iterator begin() {
+            return entries.begin();
+        }
+        iterator end() {
+            return entries.end();
+        }
+        const_iterator begin() const {
+            return entries.begin();
+        }
+        const_iterator end() const {
+            return entries.end();
+        }
+
+        iterator find( const K &key ) {
+            const iterator iter = lower_bound( key );
+            return iter != entries.end() && iter->first == key ? iter : entries.end();
+        }
+        const_iterator find( const K &key ) const {
+            const const_iterator iter = lower_bound( key );
+            return iter != entries.end() && iter->first == key ? iter : entries.end();
+        }
+        size_t count( const K &key ) const {
+            return find( key ) != entries.end() ? 1 : 0;
+        }
+
+        V &operator[]( const K &key ) {
+            iterator iter = lower_bound( key );
+            if( iter == entries.end() || iter->first != key ) {
+                iter = entries.insert( iter, value_type( key, V() ) );
+            }
+            return iter->second;
+        }
+        size_t erase( const K &key ) {
+            const iterator iter = find( key );
+            if( iter == entries.end() ) {
+                return 0;
+            }
+            entries.erase( iter );
+            return 1;
+        }
+        void clear() {
+            entries.clear();
+        }
+
+        bool empty() const {
+            return entries.empty();
+        }
+        size_t size() const {
+            return entries.size();
+        }
+
+        bool operator==( const flat_map &rhs ) const {
+            return entries == rhs.entries;
+        }
+        bool operator!=( const flat_map &rhs ) const {
+            return entries != rhs.entries;
+        }
+
+    private:
+        static bool key_less( const value_type &entry, const K &key ) {
+            return entry.first < key;
+        }
+        iterator lower_bound( const K &key ) {
+            return std::lower_bound( entries.begin(), entries.end(), key, key_less );
+        }
+        const_iterator lower_bound( const K &key ) const {
+            return std::lower_bound( entries.begin(), entries.end(), key, key_less );
+        }
+
+        std::vector<value_type> entries;
+};
+
+#endif
@@ -59,6 +59,8 @@
 #include "lightmap.h"
 #include "npc.h"
 #include "scenario.h"
+#include "scent_map.h"
+#include "quad_pregenerator.h"
 #include "mission.h"
 #include "compatibility.h"
 #include "mongroup.h"
@@ -79,9 +81,13 @@
 #include "live_view.h"
 #include "recipe_dictionary.h"
 #include "cata_utility.h"
+#include "thread_pool.h"
+#include "active_vehicle_registry.h"
+#include "turn_profiler.h"
 
 #include <map>
 #include <set>
+#include <unordered_set>
 #include <queue>
 #include <algorithm>
 #include <string>
@@ -109,6 +115,21 @@
 const mtype_id mon_fungal_blossom( "mon_fungal_blossom" );
 const mtype_id mon_manhack( "mon_manhack" );
 
+// Options read each turn or each time the screen is drawn
+static const option<bool> option_animations( "ANIMATIONS" );
+static const option<bool> option_animation_rain( "ANIMATION_RAIN" );
+static const option<bool> option_animation_sct( "ANIMATION_SCT" );
+static const option<bool> option_autosave( "AUTOSAVE" );
+static const option<int> option_autosave_turns( "AUTOSAVE_TURNS" );
+static const option<int> option_autosafemode_turns( "AUTOSAFEMODETURNS" );
+static const option<bool> option_auto_pickup( "AUTO_PICKUP" );
+static const option<bool> option_auto_pickup_adjacent( "AUTO_PICKUP_ADJACENT" );
+static const option<bool> option_auto_pickup_safemode( "AUTO_PICKUP_SAFEMODE" );
+static const option<bool> option_driving_view_offset( "DRIVING_VIEW_OFFSET" );
+static const option<int> option_monster_planning_threads( "MONSTER_PLANNING_THREADS" );
+static const option<int> option_safemode_proximity( "SAFEMODEPROXIMITY" );
+static const option<bool> option_vehicle_dir_indicator( "VEHICLE_DIR_INDICATOR" );
+
 const skill_id skill_melee( "melee" );
 const skill_id skill_dodge( "dodge" );
 const skill_id skill_driving( "driving" );
@@ -1230,7 +1251,7 @@ static int veh_lumi(vehicle *veh)
 
 void game::calc_driving_offset(vehicle *veh)
 {
-    if (veh == nullptr || !OPTIONS["DRIVING_VIEW_OFFSET"]) {
+    if (veh == nullptr || !option_driving_view_offset) {
         set_driving_view_offset(point(0, 0));
         return;
     }
@@ -1341,7 +1362,10 @@ bool game::do_turn()
     if( new_game ) {
         new_game = false;
     } else {
-        gamemode->per_turn();
+        // There is none when the game is played without starting it, e.g. by cata_bench
+        if( gamemode != nullptr ) {
+            gamemode->per_turn();
+        }
         calendar::turn.increment();
     }
     process_events();
@@ -1363,8 +1387,8 @@ bool game::do_turn()
     u.update_body();
 
     // Auto-save if autosave is enabled
-    if (OPTIONS["AUTOSAVE"] &&
-        calendar::once_every(((int)OPTIONS["AUTOSAVE_TURNS"])) &&
+    if (option_autosave &&
+        calendar::once_every(option_autosave_turns) &&
         !u.is_dead_state()) {
         autosave();
     }
@@ -1440,19 +1464,38 @@ bool game::do_turn()
 
     // Process power and fuel consumption for all vehicles, including off-map ones.
     // m.vehmove used to do this, but now it only give them moves instead.
-    for( auto &elem : MAPBUFFER ) {
-        tripoint sm_loc = elem.first;
-        point sm_topleft = sm_to_ms_copy(sm_loc.x, sm_loc.y);
-        point in_reality = m.getlocal(sm_topleft);
-
-        submap *sm = elem.second;
-
-        const bool in_bubble_z = m.has_zlevels() || sm_loc.z == get_levz();
-        for( auto &veh : sm->vehicles ) {
-            veh->power_parts();
-            veh->idle( in_bubble_z && m.inbounds(in_reality.x, in_reality.y) );
+    // Off-map vehicles with nothing running would do nothing here, so only those
+    // in active_vehicles are visited instead of every submap in MAPBUFFER.
+    std::unordered_set<const vehicle *> vehicles_on_map;
+    for( auto &wrapped : m.get_vehicles() ) {
+        vehicle *veh = wrapped.v;
+        veh->power_parts();
+        veh->idle( true );
+        vehicles_on_map.insert( veh );
+        if( veh->has_active_systems() ) {
+            active_vehicles.add( veh );
+        } else {
+            active_vehicles.remove( veh );
         }
     }
+    for( vehicle *veh : active_vehicles.get() ) {
+        if( vehicles_on_map.count( veh ) > 0 ) {
+            continue;
+        }
+        veh->power_parts();
+        veh->idle( false );
+        if( !veh->has_active_systems() ) {
+            active_vehicles.remove( veh );
+        }
+    }
+    // Don't let the submaps left behind pile up during long trips
+    MAPBUFFER.unload_unused();
+    {
+        const vehicle *veh = u.in_vehicle ? m.veh_at( u.pos() ) : nullptr;
+        const int facing = veh != nullptr && veh->velocity != 0 ? veh->face.dir() : -1;
+        quad_pregen.process( m.getabs( u.pos() ), facing, m.has_zlevels(),
+                             OPTIONS["PREGENERATE_QUADS"] );
+    }
     m.process_fields();
     m.process_active_items();
     m.creature_in_field( u );
@@ -1487,6 +1530,7 @@ bool game::do_turn()
     sfx::do_danger_music();
     sfx::do_fatigue();
 
+    turn_profiler::end_turn( calendar::turn );
     return false;
 }
 
@@ -2068,7 +2112,7 @@ input_context game::get_player_input(std::string &action)
         ctxt.register_action("QUIT");
     }
 
-    if (OPTIONS["ANIMATIONS"]) {
+    if (option_animations) {
         int iStartX = (TERRAIN_WINDOW_WIDTH > 121) ? (TERRAIN_WINDOW_WIDTH - 121) / 2 : 0;
         int iStartY = (TERRAIN_WINDOW_HEIGHT > 121) ? (TERRAIN_WINDOW_HEIGHT - 121) / 2 : 0;
         int iEndX = (TERRAIN_WINDOW_WIDTH > 121) ? TERRAIN_WINDOW_WIDTH - (TERRAIN_WINDOW_WIDTH - 121) / 2 :
@@ -2120,7 +2164,7 @@ input_context game::get_player_input(std::string &action)
         inp_mngr.set_timeout(125);
         // Force at least one animation frame if the player is dead.
         while( handle_mouseview(ctxt, action) || uquit == QUIT_WATCH ) {
-            if( bWeatherEffect && OPTIONS["ANIMATION_RAIN"] ) {
+            if( bWeatherEffect && option_animation_rain ) {
                 /*
                 Location to add rain drop animation bits! Since it refreshes w_terrain it can be added to the animation section easily
                 Get tile information from above's weather information:
@@ -2166,7 +2210,7 @@ input_context game::get_player_input(std::string &action)
                 }
             }
             // don't bother calculating SCT if we won't show it
-            if (uquit != QUIT_WATCH && OPTIONS["ANIMATION_SCT"]) {
+            if (uquit != QUIT_WATCH && option_animation_sct) {
 #ifdef TILES
                 if (!use_tiles) {
 #endif
@@ -3202,6 +3246,7 @@ int &game::scent( const tripoint &p )
 
 void game::update_scent()
 {
+    PROFILE_SECTION( PROFILE_SCENT );
     static tripoint player_last_position = tripoint_min;
     static int player_last_moved = calendar::turn;
     // Stop updating scent after X turns of the player not moving.
@@ -3217,104 +3262,13 @@ void game::update_scent()
 
     overmap_buffer.set_scent( u.global_omt_location(), u.scent );
 
-    // note: the next four intermediate matrices need to be at least
-    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
-    // The code I'm modifying used [SEEX * MAPSIZE]. I'm staying with that to avoid new bugs.
-
-    // These two matrices are transposed so that x addresses are contiguous in memory
-    int sum_3_scent_y[SEEY * MAPSIZE][SEEX * MAPSIZE];  //intermediate variable
-    int squares_used_y[SEEY * MAPSIZE][SEEX * MAPSIZE]; //intermediate variable
-
-    // these are for caching flag lookups
-    bool blocks_scent[SEEX * MAPSIZE][SEEY * MAPSIZE]; // currently only TFLAG_WALL blocks scent
-    bool reduces_scent[SEEX * MAPSIZE][SEEY * MAPSIZE];
-
-
-    // for loop constants
-    const int scentmap_minx = u.posx() - SCENT_RADIUS;
-    const int scentmap_maxx = u.posx() + SCENT_RADIUS;
-    const int scentmap_miny = u.posy() - SCENT_RADIUS;
-    const int scentmap_maxy = u.posy() + SCENT_RADIUS;
-
-    const int diffusivity = 100; // decrease this to reduce gas spread. Keep it under 125 for
-    // stability. This is essentially a decimal number * 1000.
-
     // No-scent debug mutation has to be processed here or else it takes time to start working
     if( !u.has_active_bionic("bio_scent_mask") && !u.has_trait("DEBUG_NOSCENT") ) {
         grscent[u.posx()][u.posy()] = u.scent;
     }
 
-    // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( blocks_scent, reduces_scent,
-                      scentmap_minx, scentmap_miny, scentmap_maxx, scentmap_maxy );
-    // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
-    // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
-    // is a net performance improvement over the old code. Could probably still be better.
-    // note: this method needs an array that is one square larger on each side in the x direction
-    // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
-    // SEEX*MAPSIZE, but if that changes, this may need tweaking.
-    for (int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x) {
-        for (int y = scentmap_miny; y <= scentmap_maxy; ++y) {
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for (int i = y - 1; i <= y + 1; ++i) {
-                if (! blocks_scent[x][i]) {
-                    if (reduces_scent[x][i]) {
-                        // only 20% of scent can diffuse on REDUCE_SCENT squares
-                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
-                        squares_used_y[y][x] += 2;
-                    } else {
-                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
-                        squares_used_y[y][x] += 10;
-                    }
-                }
-            }
-        }
-    }
-
-    // Rest of the scent map
-    for (int x = scentmap_minx; x <= scentmap_maxx; ++x) {
-        for (int y = scentmap_miny; y <= scentmap_maxy; ++y) {
-            if (! blocks_scent[x][y]) {
-                // to how many neighboring squares do we diffuse out? (include our own square
-                // since we also include our own square when diffusing in)
-                int squares_used = squares_used_y[y][x - 1]
-                                   + squares_used_y[y][x]
-                                   + squares_used_y[y][x + 1];
-
-                int this_diffusivity;
-                if (! reduces_scent[x][y]) {
-                    this_diffusivity = diffusivity;
-                } else {
-                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
-                }
-                int temp_scent;
-                // take the old scent and subtract what diffuses out
-                temp_scent = grscent[x][y] * (10 * 1000 - squares_used * this_diffusivity);
-                // neighboring walls and reduce_scent squares absorb some scent
-                temp_scent -= grscent[x][y] * this_diffusivity * (90 - squares_used) / 5;
-                // we've already summed neighboring scent values in the y direction in the previous
-                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
-                // diffuses into our current square.
-                grscent[x][y] =
-                    (temp_scent
-                     + this_diffusivity * (sum_3_scent_y[y][x - 1]
-                                           + sum_3_scent_y[y][x]
-                                           + sum_3_scent_y[y][x + 1])
-                    ) / (1000 * 10);
-
-                if (grscent[x][y] > 10000) {
-                    dbg(D_ERROR) << "game:update_scent: Wacky scent at " << x << ","
-                                 << y << " (" << grscent[x][y] << ")";
-                    debugmsg("Wacky scent at %d, %d (%d)", x, y, grscent[x][y]);
-                    grscent[x][y] = 0; // Scent should never be higher
-                }
-            } else { // this cell blocks scent
-                grscent[x][y] = 0;
-            }
-        }
-    }
+    diffuse_scent( grscent, m.get_scent_cache_ref( u.posz() ), point( u.posx(), u.posy() ),
+                   SCENT_RADIUS );
 }
 
 bool game::is_game_over()
@@ -3859,6 +3813,8 @@ void game::debug()
                        _( "Set automove route" ),     // 28
                        _( "Show mutation category levels" ), // 29
                        _( "Overmap editor" ),         // 30
+                       _( "Convert map files" ),      // 31
+                       _( "Toggle turn profile" ),    // 32
                        _( "Cancel" ),
                        NULL );
     int veh_num;
@@ -4510,6 +4466,22 @@ void game::debug()
             overmap::draw_editor();
         }
         break;
+        case 31: {
+            // Quads in memory may be newer than their files
+            MAPBUFFER.save();
+            const int converted = MAPBUFFER.convert_saved_quads();
+            popup( _( "Converted %d map files to %s." ), converted,
+                   OPTIONS["MAP_SAVE_FORMAT"].getValueName().c_str() );
+        }
+        break;
+
+        case 32:
+#ifndef CATA_NO_PROFILER
+            turn_profiler::toggle_overlay();
+#else
+            popup( "This binary was compiled without the turn profiler." );
+#endif
+            break;
     }
     erase();
     refresh_all();
@@ -5055,6 +5027,9 @@ void game::draw()
     // Draw map
     werase(w_terrain);
     draw_ter();
+    if( turn_profiler::overlay_shown() ) {
+        turn_profiler::draw_overlay( w_terrain );
+    }
     if( !is_draw_tiles_mode() ) {
         wrefresh(w_terrain);
     }
@@ -5185,7 +5160,7 @@ void game::draw_sidebar()
     mvwprintz(day_window, 0, sideStyle ? 0 : 41, c_white, _("%s, day %d"),
               season_name_upper(calendar::turn.get_season()).c_str(), calendar::turn.days() + 1);
     if (safe_mode != SAFE_MODE_OFF || autosafemode != 0) {
-        int iPercent = int((turnssincelastmon * 100) / OPTIONS["AUTOSAFEMODETURNS"]);
+        int iPercent = turnssincelastmon * 100 / option_autosafemode_turns;
         wmove(w_status, sideStyle ? 4 : 1, getmaxx(w_status) - 4);
         const char *letters[] = { "S", "A", "F", "E" };
         for (int i = 0; i < 4; i++) {
@@ -5331,7 +5306,7 @@ void game::draw_ter( const tripoint &center, const bool looking, const bool draw
 
 tripoint game::get_veh_dir_indicator_location() const
 {
-    if( !OPTIONS["VEHICLE_DIR_INDICATOR"] ) {
+    if( !option_vehicle_dir_indicator ) {
         return tripoint_min;
     }
     vehicle *veh = m.veh_at( u.pos() );
@@ -5755,7 +5730,7 @@ faction *game::faction_by_ident(std::string id)
 
 Creature *game::is_hostile_nearby()
 {
-    int distance = (OPTIONS["SAFEMODEPROXIMITY"] <= 0) ? 60 : OPTIONS["SAFEMODEPROXIMITY"];
+    int distance = (option_safemode_proximity <= 0) ? 60 : option_safemode_proximity.get();
     return is_hostile_within(distance);
 }
 
@@ -5803,7 +5778,7 @@ int game::mon_info(WINDOW *w)
     const int startrow = use_narrow_sidebar() ? 1 : 0;
 
     int newseen = 0;
-    const int iProxyDist = (OPTIONS["SAFEMODEPROXIMITY"] <= 0) ? 60 : OPTIONS["SAFEMODEPROXIMITY"];
+    const int iProxyDist = (option_safemode_proximity <= 0) ? 60 : option_safemode_proximity.get();
     // 7 0 1    unique_types uses these indices;
     // 6 8 2    0-7 are provide by direction_from()
     // 5 4 3    8 is used for local monsters (for when we explain them below)
@@ -5955,7 +5930,7 @@ int game::mon_info(WINDOW *w)
         }
     } else if (autosafemode && newseen == 0) { // Auto-safemode
         turnssincelastmon++;
-        if (turnssincelastmon >= OPTIONS["AUTOSAFEMODETURNS"] && safe_mode == SAFE_MODE_OFF) {
+        if (turnssincelastmon >= option_autosafemode_turns && safe_mode == SAFE_MODE_OFF) {
             safe_mode = SAFE_MODE_ON;
         }
     }
@@ -6134,6 +6109,7 @@ void game::cleanup_dead()
 
 void game::monmove()
 {
+    PROFILE_SECTION( PROFILE_MONSTERS );
     cleanup_dead();
 
     // Make sure these don't match the first time around.
@@ -6141,23 +6117,56 @@ void game::monmove()
 
     mfactions monster_factions;
     const auto &playerfaction = mfaction_str_id( "player" );
+    // monster::plan() needs to know about all monsters on the same team as the monster.
+    const auto update_factions = [&]() {
+        if( cached_lev == m.get_abs_sub() ) {
+            return;
+        }
+
+        monster_factions.clear();
+        for( int i = 0, numz = num_zombies(); i < numz; i++ ) {
+            monster &critter = zombie( i );
+            if( critter.friendly == 0 ) {
+                // Only 1 faction per mon at the moment.
+                monster_factions[ critter.faction ].insert( i );
+            } else {
+                monster_factions[ playerfaction ].insert( i );
+            }
+        }
+        cached_lev = m.get_abs_sub();
+    };
+
+    // With MONSTER_PLANNING_THREADS set, targets of all monsters are picked up front,
+    // before any of them moves. monster::plan_targets neither modifies anything nor uses
+    // the RNG, so the plans are the same no matter how many threads compute them.
+    const int planning_threads = option_monster_planning_threads;
+    std::vector<monster_plan> plans;
+    std::vector<tripoint> planned_positions;
+    if( planning_threads > 0 ) {
+        const size_t num_planned = num_zombies();
+        plans.resize( num_planned );
+        planned_positions.resize( num_planned );
+        for( size_t i = 0; i < num_planned; i++ ) {
+            planned_positions[i] = zombie( i ).pos();
+        }
+        // Fill the lazily computed light levels now, so that the workers only read them
+        for( int z = 0; z <= OVERMAP_HEIGHT; z++ ) {
+            natural_light_level( z );
+        }
+
+        thread_pool &pool = get_thread_pool( pool_purpose::monster_planning, planning_threads - 1 );
+        pool.parallel_for( num_planned, [&]( size_t i ) {
+            const monster &critter = critter_tracker->find( i );
+            if( !critter.is_dead() && !critter.has_effect( effect_controlled ) ) {
+                plans[i] = critter.plan_targets();
+            }
+        } );
+    }
+
     for (size_t i = 0; i < num_zombies(); i++) {
         // The first time through, and any time the map has been shifted,
         // recalculate monster factions.
-        if( cached_lev != m.get_abs_sub() ) {
-            // monster::plan() needs to know about all monsters on the same team as the monster.
-            monster_factions.clear();
-            for( int i = 0, numz = num_zombies(); i < numz; i++ ) {
-                monster &critter = zombie( i );
-                if( critter.friendly == 0 ) {
-                    // Only 1 faction per mon at the moment.
-                    monster_factions[ critter.faction ].insert( i );
-                } else {
-                    monster_factions[ playerfaction ].insert( i );
-                }
-            }
-            cached_lev = m.get_abs_sub();
-        }
+        update_factions();
 
         monster &critter = critter_tracker->find(i);
         while (!critter.is_dead() && !critter.can_move_to(critter.pos())) {
@@ -6194,13 +6203,22 @@ void game::monmove()
 
         m.creature_in_field( critter );
 
+        // The precomputed plan only holds for the first step, and only if nothing invalidated it
+        bool use_plan = i < plans.size() && critter.pos() == planned_positions[i] &&
+                        ( plans[i].target == nullptr || !plans[i].target->is_dead_state() );
         while (critter.moves > 0 && !critter.is_dead()) {
             critter.made_footstep = false;
             // Controlled critters don't make their own plans
             if (!critter.has_effect( effect_controlled)) {
                 // Formulate a path to follow
-                critter.plan( monster_factions );
+                if( use_plan ) {
+                    critter.plan( monster_factions, plans[i] );
+                } else {
+                    critter.plan( monster_factions );
+                }
             }
+            use_plan = false;
+            PROFILE_COUNT( PROFILE_MONSTER_MOVES, 1 );
             critter.move(); // Move one square, possibly hit u
             critter.process_triggers();
             m.creature_in_field( critter );
@@ -12515,8 +12533,8 @@ void game::place_player( const tripoint &dest_loc )
     // and dest_loc was not adjusted and therefor is still in the un-shifted system and probably wrong.
 
     //Autopickup
-    if (OPTIONS["AUTO_PICKUP"] && (!OPTIONS["AUTO_PICKUP_SAFEMODE"] || mostseen == 0) &&
-        ( m.has_items( u.pos() ) || OPTIONS["AUTO_PICKUP_ADJACENT"])) {
+    if (option_auto_pickup && (!option_auto_pickup_safemode || mostseen == 0) &&
+        ( m.has_items( u.pos() ) || option_auto_pickup_adjacent)) {
         Pickup::pick_up(u.pos(), -1);
     }
 
@@ -13103,7 +13121,7 @@ void game::fling_creature(Creature *c, const int &dir, float flvel, bool control
     int steps = 0;
     const bool is_u = (c == &u);
     // Don't animate critters getting bashed if animations are off
-    const bool animate = is_u || OPTIONS["ANIMATIONS"];
+    const bool animate = is_u || option_animations;
 
     player *p = dynamic_cast<player*>(c);
 
@@ -13792,6 +13810,7 @@ void game::replace_stair_monsters()
 //TODO: refactor so zombies can follow up and down stairs instead of this mess
 void game::update_stair_monsters()
 {
+    PROFILE_SECTION( PROFILE_STAIR_MONSTERS );
     // Search for the stairs closest to the player.
     std::vector<int> stairx, stairy;
     std::vector<int> stairdist;
@@ -48,6 +48,8 @@
 #include "veh_type.h"
 #include "clzones.h"
 #include "sounds.h"
+#include "data_cache.h"
+#include "get_version.h"
 
 #include <string>
 #include <vector>
@@ -55,10 +57,20 @@
 #include <sstream> // for throwing errors
 #include <locale> // for loading names
 
-DynamicDataLoader::DynamicDataLoader()
+DynamicDataLoader::DynamicDataLoader() : loaded_files_hash( 14695981039346656037ULL )
 {
 }
 
+// FNV-1a
+static void hash_bytes( unsigned long long &hash, const void *data, const size_t size )
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>( data );
+    for( size_t i = 0; i < size; i++ ) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
 DynamicDataLoader::~DynamicDataLoader()
 {
     reset();
@@ -248,18 +260,14 @@ void DynamicDataLoader::load_data_from_path(const std::string &path)
     // iterate over each file
     for( auto &files_i : files ) {
         const std::string &file = files_i;
-        // open the file as a stream
-        std::ifstream infile(file.c_str(), std::ifstream::in | std::ifstream::binary);
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                (std::istreambuf_iterator<char>(infile)),
-                std::istreambuf_iterator<char>()
-            )
-        );
+        // map the file into memory, the parser reads it in place
+        const mapped_file mapped( file );
+        // The contents, not the modification time, so that edits within the same second count
+        hash_bytes( loaded_files_hash, file.data(), file.size() + 1 );
+        hash_bytes( loaded_files_hash, mapped.data(), mapped.size() );
         try {
             // parse it
-            JsonIn jsin(iss);
+            JsonIn jsin( mapped.data(), mapped.size() );
             load_all_from_json(jsin);
         } catch( const JsonError &err ) {
             throw std::runtime_error( file + ": " + err.what() );
@@ -311,6 +319,7 @@ void init_names()
 
 void DynamicDataLoader::unload_data()
 {
+    loaded_files_hash = 14695981039346656037ULL;
     material_type::reset();
     profession::reset();
     Skill::reset();
@@ -363,6 +372,9 @@ void DynamicDataLoader::finalize_loaded_data()
     set_oter_ids();
     trap::finalize();
     finalize_overmap_terrain();
+    // Whatever the cache holds is not finalized again
+    const bool use_cache = OPTIONS["DATA_CACHE"];
+    const bool cached = use_cache && data_cache::load( FILENAMES["datacache"], get_data_key() );
     vehicle_prototype::finalize();
     calculate_mapgen_weights();
     MonsterGenerator::generator().finalize_mtypes();
@@ -372,6 +384,17 @@ void DynamicDataLoader::finalize_loaded_data()
     finalize_recipes();
     finialize_martial_arts();
     check_consistency();
+
+    if( use_cache && !cached ) {
+        data_cache::save( FILENAMES["datacache"], get_data_key() );
+    }
+}
+
+std::string DynamicDataLoader::get_data_key() const
+{
+    std::ostringstream key;
+    key << getVersionString() << " " << data_cache::build_id() << " " << std::hex << loaded_files_hash;
+    return key.str();
 }
 
 void DynamicDataLoader::check_consistency()
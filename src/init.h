@@ -120,6 +120,11 @@ class DynamicDataLoader
          * functor that loads that kind of object from json.
          */
         t_type_function_map type_function_map;
+        /**
+         * Hash of the names and contents of the files
+         * loaded since @ref unload_data, see @ref get_data_key
+         */
+        unsigned long long loaded_files_hash;
         /**
          * Load all the types from that json data.
          * @param jsin Might contain single object,
@@ -179,6 +184,12 @@ class DynamicDataLoader
          * @ref check_consistency
          */
         void finalize_loaded_data();
+        /**
+         * Identifies the loaded data: the same files, in the same order
+         * and unchanged since, loaded by the same build of the game, give the same key.
+         * Used to tell whether the data cache (see data_cache.h) belongs to the loaded data.
+         */
+        std::string get_data_key() const;
 };
 
 void init_names();
@@ -33,6 +33,7 @@ inventory::inventory()
 
 invslice inventory::slice()
 {
+    summary.index.reset();
     invslice stacks;
     for( auto &elem : items ) {
         stacks.push_back( &elem );
@@ -139,6 +140,7 @@ inventory inventory::operator+ (const item &rhs)
 
 indexed_invslice inventory::slice_filter()
 {
+    summary.index.reset();
     int i = 0;
     indexed_invslice stacks;
     for( auto &elem : items ) {
@@ -150,6 +152,7 @@ indexed_invslice inventory::slice_filter()
 
 indexed_invslice inventory::slice_filter_by_activation(const player &u)
 {
+    summary.index.reset();
     int i = 0;
     indexed_invslice stacks;
     for( auto &elem : items ) {
@@ -163,6 +166,7 @@ indexed_invslice inventory::slice_filter_by_activation(const player &u)
 
 indexed_invslice inventory::slice_filter_by_flag(const std::string flag)
 {
+    summary.index.reset();
     int i = 0;
     indexed_invslice stacks;
     for( auto &elem : items ) {
@@ -176,6 +180,7 @@ indexed_invslice inventory::slice_filter_by_flag(const std::string flag)
 
 indexed_invslice inventory::slice_filter_by_capacity_for_liquid(const item &liquid)
 {
+    summary.index.reset();
     int i = 0;
     indexed_invslice stacks;
     for( auto &elem : items ) {
@@ -189,6 +194,7 @@ indexed_invslice inventory::slice_filter_by_capacity_for_liquid(const item &liqu
 
 indexed_invslice inventory::slice_filter_by_salvageability(const salvage_actor &actor)
 {
+    summary.index.reset();
     int i = 0;
     indexed_invslice stacks;
     for( auto &elem : items ) {
@@ -218,6 +224,7 @@ void inventory::sort()
 
 void inventory::clear()
 {
+    summary.index.reset();
     items.clear();
 }
 
@@ -233,6 +240,7 @@ void inventory::add_stack(const std::list<item> newits)
  */
 void inventory::clone_stack (const std::list<item> &rhs)
 {
+    summary.index.reset();
     std::list<item> newstack;
     for( const auto &rh : rhs ) {
         newstack.push_back( rh );
@@ -314,6 +322,7 @@ char inventory::find_usable_cached_invlet(const std::string &item_type)
 
 item &inventory::add_item(item newit, bool keep_invlet, bool assign_invlet)
 {
+    summary.index.reset();
     bool reuse_cached_letter = false;
 
     // Avoid letters that have been manually assigned to other things.
@@ -382,6 +391,7 @@ void inventory::push_back(item newit)
 
 void inventory::restack(player *p)
 {
+    summary.index.reset();
     // tasks that the old restack seemed to do:
     // 1. reassign inventory letters
     // 2. remove items from non-matching stacks
@@ -446,6 +456,7 @@ static long count_charges_in_list(const itype *type, const map_stack &items)
 
 void inventory::form_from_map( const tripoint &origin, int range, bool assign_invlet )
 {
+    summary.index.reset();
     items.clear();
     for( const tripoint &p : g->m.points_in_radius( origin, range ) ) {
         if (g->m.has_furn( p ) && g->m.accessible_furniture( origin, p, range )) {
@@ -630,6 +641,7 @@ void inventory::form_from_map( const tripoint &origin, int range, bool assign_in
 template<typename Locator>
 std::list<item> inventory::reduce_stack_internal(const Locator &locator, int quantity)
 {
+    summary.index.reset();
     int pos = 0;
     std::list<item> ret;
     for (invstack::iterator iter = items.begin(); iter != items.end(); ++iter) {
@@ -673,6 +685,7 @@ item inventory::remove_item(const item *it)
 template<typename Locator>
 item inventory::remove_item_internal(const Locator &locator)
 {
+    summary.index.reset();
     int pos = 0;
     for (invstack::iterator iter = items.begin(); iter != items.end(); ++iter) {
         if (item_matches_locator(iter->front(), locator, pos)) {
@@ -703,6 +716,7 @@ item inventory::remove_item(int position)
 
 std::list<item> inventory::remove_randomly_by_volume(int volume)
 {
+    summary.index.reset();
     std::list<item> result;
     int volume_dropped = 0;
     while( volume_dropped < volume ) {
@@ -734,6 +748,7 @@ std::list<item> inventory::remove_randomly_by_volume(int volume)
 
 void inventory::dump(std::vector<item *> &dest)
 {
+    summary.index.reset();
     for( auto &elem : items ) {
         for( auto &elem_stack_iter : elem ) {
             dest.push_back( &( elem_stack_iter ) );
@@ -755,6 +770,7 @@ const item &inventory::find_item(int position) const
 
 item &inventory::find_item(int position)
 {
+    summary.index.reset();
     return const_cast<item&>( const_cast<const inventory*>(this)->find_item( position ) );
 }
 
@@ -786,6 +802,7 @@ int inventory::position_by_item( const item *it ) const
 
 item &inventory::item_by_type(itype_id type)
 {
+    summary.index.reset();
     for( auto &elem : items ) {
         if( elem.front().type->id == type ) {
             return elem.front();
@@ -807,6 +824,7 @@ int inventory::position_by_type(itype_id type)
 }
 item &inventory::item_or_container(itype_id type)
 {
+    summary.index.reset();
     for( auto &elem : items ) {
         for( auto &elem_stack_iter : elem ) {
             if( elem_stack_iter.type->id == type ) {
@@ -824,6 +842,7 @@ item &inventory::item_or_container(itype_id type)
 
 std::vector<std::pair<item *, int> > inventory::all_items_by_type(itype_id type)
 {
+    summary.index.reset();
     std::vector<std::pair<item *, int> > ret;
     int i = 0;
     for( auto &elem : items ) {
@@ -844,6 +863,14 @@ int inventory::amount_of(itype_id it) const
 
 int inventory::amount_of(itype_id it, bool used_as_tool) const
 {
+    return amount_of( intern_itype_id( it ), used_as_tool );
+}
+
+int inventory::amount_of( const itype_iid it, const bool used_as_tool ) const
+{
+    if( summary.index ) {
+        return summary.index->amount_of( it, used_as_tool );
+    }
     int count = 0;
     for( const auto &elem : items ) {
         for( const auto &elem_stack_iter : elem ) {
@@ -855,6 +882,14 @@ int inventory::amount_of(itype_id it, bool used_as_tool) const
 
 long inventory::charges_of(itype_id it) const
 {
+    return charges_of( intern_itype_id( it ) );
+}
+
+long inventory::charges_of( const itype_iid it ) const
+{
+    if( summary.index ) {
+        return summary.index->charges_of( it );
+    }
     int count = 0;
     for( const auto &elem : items ) {
         for( const auto &elem_stack_iter : elem ) {
@@ -864,8 +899,24 @@ long inventory::charges_of(itype_id it) const
     return count;
 }
 
+void inventory::build_index()
+{
+    summary.index.reset( new crafting_index() );
+    for( const auto &elem : items ) {
+        for( const auto &it : elem ) {
+            summary.index->add( it );
+        }
+    }
+}
+
 std::list<item> inventory::use_amount(itype_id it, int _quantity)
 {
+    return use_amount( intern_itype_id( it ), _quantity );
+}
+
+std::list<item> inventory::use_amount( const itype_iid it, int _quantity )
+{
+    summary.index.reset();
     long quantity = _quantity; // Don't wanny change the function signature right now
     sort();
     std::list<item> ret;
@@ -890,6 +941,12 @@ std::list<item> inventory::use_amount(itype_id it, int _quantity)
 
 std::list<item> inventory::use_charges(itype_id it, long quantity)
 {
+    return use_charges( intern_itype_id( it ), quantity );
+}
+
+std::list<item> inventory::use_charges( const itype_iid it, long quantity )
+{
+    summary.index.reset();
     sort();
     std::list<item> ret;
     for (invstack::iterator iter = items.begin(); iter != items.end() && quantity > 0; /* noop */) {
@@ -915,11 +972,21 @@ bool inventory::has_tools(itype_id it, int quantity) const
     return has_amount(it, quantity, true);
 }
 
+bool inventory::has_tools( const itype_iid it, const int quantity ) const
+{
+    return amount_of( it, true ) >= quantity;
+}
+
 bool inventory::has_components(itype_id it, int quantity) const
 {
     return has_amount(it, quantity, false);
 }
 
+bool inventory::has_components( const itype_iid it, const int quantity ) const
+{
+    return amount_of( it, false ) >= quantity;
+}
+
 bool inventory::has_amount(itype_id it, int quantity) const
 {
     return has_amount(it, quantity, true);
@@ -935,8 +1002,16 @@ bool inventory::has_charges(itype_id it, long quantity) const
     return (charges_of(it) >= quantity);
 }
 
+bool inventory::has_charges( const itype_iid it, const long quantity ) const
+{
+    return charges_of( it ) >= quantity;
+}
+
 bool inventory::has_items_with_quality(std::string id, int level, int amount) const
 {
+    if( summary.index ) {
+        return summary.index->quality_count( id, level ) >= amount;
+    }
     int found = 0;
     for( const auto &elem : items ) {
         for( const auto &elem_stack_iter : elem ) {
@@ -961,6 +1036,9 @@ bool inventory::has_items_with_quality(std::string id, int level, int amount) co
 
 int inventory::max_quality( const std::string &quality_id ) const
 {
+    if( summary.index ) {
+        return summary.index->max_quality( quality_id );
+    }
     int result = INT_MIN;
     for( const auto &elem : items ) {
         for( const auto &cur_item : elem ) {
@@ -1016,6 +1094,7 @@ bool inventory::has_enough_painkiller(int pain) const
 
 item *inventory::most_appropriate_painkiller(int pain)
 {
+    summary.index.reset();
     int difference = 9999;
     item *ret = &nullitem;
     for( auto &elem : items ) {
@@ -1043,6 +1122,7 @@ item *inventory::most_appropriate_painkiller(int pain)
 
 item *inventory::best_for_melee( player &p, double &best )
 {
+    summary.index.reset();
     item *ret = &nullitem;
     for( auto &elem : items ) {
         auto score = p.melee_value( elem.front() );
@@ -1057,6 +1137,7 @@ item *inventory::best_for_melee( player &p, double &best )
 
 item *inventory::most_loaded_gun()
 {
+    summary.index.reset();
     item *ret = &nullitem;
     int max = 0;
     for( auto &elem : items ) {
@@ -1084,6 +1165,7 @@ item *inventory::most_loaded_gun()
 
 void inventory::rust_iron_items()
 {
+    summary.index.reset();
     for( auto &elem : items ) {
         for( auto &elem_stack_iter : elem ) {
             if( elem_stack_iter.made_of( "iron" ) &&
@@ -1120,6 +1202,7 @@ int inventory::volume() const
 
 std::vector<item *> inventory::active_items()
 {
+    summary.index.reset();
     std::vector<item *> ret;
     for( auto &elem : items ) {
         for( auto &elem_stack_iter : elem ) {
@@ -1190,6 +1273,7 @@ std::set<char> inventory::allocated_invlets() const
 }
 
 std::vector<item *> inventory::items_with( const std::function<bool(const item&)>& filter ) {
+    summary.index.reset();
     std::vector<item *> res;
     visit_items( [&res, &filter]( item *node ) {
         if( filter( *node ) ) {
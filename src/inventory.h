@@ -4,8 +4,10 @@
 #include "visitable.h"
 #include "item.h"
 #include "enums.h"
+#include "crafting_index.h"
 
 #include <list>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -102,6 +104,16 @@ class inventory : public visitable<inventory>
 
         void form_from_map( const tripoint &origin, int distance, bool assign_invlet = true );
 
+        /**
+         * Sums the items up in a @ref crafting_index, which then answers the amount, charges
+         * and quality functions below instead of looking through all items. Only for
+         * inventories that don't change afterwards, like the crafting inventory of the player:
+         * every non-const function that changes the items or hands out non-const access to
+         * them drops the index, and copies don't get it. Only sorting and the invlet functions
+         * keep it, as they don't change what the index counts.
+         */
+        void build_index();
+
         /**
          * Remove a specific item from the inventory. The item is compared
          * by pointer. Contents of the item are removed as well.
@@ -143,18 +155,26 @@ class inventory : public visitable<inventory>
 
         // Below, "amount" refers to quantity
         //        "charges" refers to charges
+        // The overloads taking an interned id don't intern the id again for every item.
         int  amount_of (itype_id it) const;
         int  amount_of (itype_id it, bool used_as_tool) const;
+        int  amount_of( itype_iid it, bool used_as_tool ) const;
         long charges_of(itype_id it) const;
+        long charges_of( itype_iid it ) const;
 
         std::list<item> use_amount (itype_id it, int quantity);
+        std::list<item> use_amount( itype_iid it, int quantity );
         std::list<item> use_charges(itype_id it, long quantity);
+        std::list<item> use_charges( itype_iid it, long quantity );
 
         bool has_amount (itype_id it, int quantity) const;
         bool has_amount (itype_id it, int quantity, bool used_as_tool) const;
         bool has_tools (itype_id it, int quantity) const;
+        bool has_tools( itype_iid it, int quantity ) const;
         bool has_components (itype_id it, int quantity) const;
+        bool has_components( itype_iid it, int quantity ) const;
         bool has_charges(itype_id it, long quantity) const;
+        bool has_charges( itype_iid it, long quantity ) const;
 
         bool has_items_with_quality(std::string id, int level, int amount) const;
 
@@ -200,6 +220,7 @@ class inventory : public visitable<inventory>
         template<typename T>
         indexed_invslice slice_filter_by( T filter )
         {
+            summary.index.reset();
             int i = 0;
             indexed_invslice stacks;
             for( auto &elem : items ) {
@@ -218,6 +239,7 @@ class inventory : public visitable<inventory>
         template<typename T>
         std::list<item> remove_items_with( T filter )
         {
+            summary.index.reset();
             std::list<item> result;
             for( auto items_it = items.begin(); items_it != items.end(); ) {
                 auto &stack = *items_it;
@@ -255,6 +277,18 @@ class inventory : public visitable<inventory>
 
         invstack items;
         bool sorted;
+
+        // Copies are made to be changed, so they start without the index
+        struct index_holder {
+            index_holder() = default;
+            index_holder( const index_holder & ) { }
+            index_holder &operator=( const index_holder & ) {
+                index.reset();
+                return *this;
+            }
+            std::unique_ptr<crafting_index> index;
+        };
+        index_holder summary;
 };
 
 #endif
@@ -47,6 +47,9 @@ static const std::string GUN_MODE_VAR_NAME( "item::mode" );
 static const std::string CHARGER_GUN_FLAG_NAME( "CHARGE" );
 static const std::string CHARGER_GUN_AMMO_ID( "charge_shot" );
 
+static const option<bool> option_item_health_bar( "ITEM_HEALTH_BAR" );
+static const world_option<int> option_season_length( "SEASON_LENGTH" );
+
 const skill_id skill_survival( "survival" );
 const skill_id skill_melee( "melee" );
 const skill_id skill_bashing( "bashing" );
@@ -540,7 +543,7 @@ void item::clear_vars()
 
 const char ivaresc = 001;
 
-bool itag2ivar( std::string &item_tag, std::map<std::string, std::string> &item_vars )
+bool itag2ivar( std::string &item_tag, flat_map<std::string, std::string> &item_vars )
 {
     size_t pos = item_tag.find('=');
     if(item_tag.at(0) == ivaresc && pos != std::string::npos && pos >= 2 ) {
@@ -1340,8 +1343,7 @@ std::string item::info( bool showtext, std::vector<iteminfo> &info ) const
     }
 
     if( showtext && !is_null() ) {
-        const std::map<std::string, std::string>::const_iterator idescription =
-            item_vars.find( "description" );
+        const auto idescription = item_vars.find( "description" );
         insert_separation_line();
         if( !type->snippet_category.empty() ) {
             // Just use the dynamic description
@@ -1751,9 +1753,8 @@ std::string item::info( bool showtext, std::vector<iteminfo> &info ) const
             }
 
         }
-        std::map<std::string, std::string>::const_iterator item_note = item_vars.find( "item_note" );
-        std::map<std::string, std::string>::const_iterator item_note_type =
-            item_vars.find( "item_note_type" );
+        const auto item_note = item_vars.find( "item_note" );
+        const auto item_note_type = item_vars.find( "item_note_type" );
 
         if( item_note != item_vars.end() ) {
             insert_separation_line();
@@ -2074,11 +2075,11 @@ std::string item::tname( unsigned int quantity, bool with_prefix ) const
 
 // MATERIALS-TODO: put this in json
     std::string damtext = "";
-    if ((damage != 0 || ( OPTIONS["ITEM_HEALTH_BAR"] && is_armor() )) && !is_null() && with_prefix) {
+    if ((damage != 0 || ( option_item_health_bar && is_armor() )) && !is_null() && with_prefix) {
         if( damage < 0 )  {
             if( damage < MIN_ITEM_DAMAGE ) {
                 damtext = rm_prefix(_("<dam_adj>bugged "));
-            } else if ( OPTIONS["ITEM_HEALTH_BAR"] ) {
+            } else if ( option_item_health_bar ) {
                 auto const &nc_text = get_item_hp_bar(damage);
                 damtext = "<color_" + string_from_color(nc_text.second) + ">" + nc_text.first + " </color>";
             } else if (is_gun())  {
@@ -2093,7 +2094,7 @@ std::string item::tname( unsigned int quantity, bool with_prefix ) const
                 if (damage == 3) damtext = rm_prefix(_("<dam_adj>mangled "));
                 if (damage == 4) damtext = rm_prefix(_("<dam_adj>pulped "));
 
-            } else if ( OPTIONS["ITEM_HEALTH_BAR"] ) {
+            } else if ( option_item_health_bar ) {
                 auto const &nc_text = get_item_hp_bar(damage);
                 damtext = "<color_" + string_from_color(nc_text.second) + ">" + nc_text.first + " </color>";
 
@@ -2126,7 +2127,7 @@ std::string item::tname( unsigned int quantity, bool with_prefix ) const
         }
     }
 
-    const std::map<std::string, std::string>::const_iterator iname = item_vars.find("name");
+    const auto iname = item_vars.find("name");
     std::string maintext = "";
     if (corpse != NULL && typeId() == "corpse" ) {
         if (name != "") {
@@ -2900,7 +2901,7 @@ int item::get_warmth() const
 
 int item::brewing_time() const
 {
-    float season_mult = ( (float)ACTIVE_WORLD_OPTIONS["SEASON_LENGTH"] ) / 14;
+    float season_mult = option_season_length / 14.0f;
     unsigned int b_time = dynamic_cast<const it_comest*>(type)->brewtime;
     int ret = b_time * season_mult;
     return ret;
@@ -4810,11 +4811,16 @@ item::LIQUID_FILL_ERROR item::has_valid_capacity_for_liquid(const item &liquid)
 }
 
 int item::amount_of(const itype_id &it, bool used_as_tool) const
+{
+    return amount_of( intern_itype_id( it ), used_as_tool );
+}
+
+int item::amount_of( const itype_iid it, bool used_as_tool ) const
 {
     int count = 0;
     // Check that type matches, and (if not used as tool), it
     // is not a pseudo item.
-    if (type->id == it && (used_as_tool || !has_flag("PSEUDO"))) {
+    if (type->iid == it && (used_as_tool || !has_flag("PSEUDO"))) {
         if (contents.empty()) {
             // Only use empty container
             count++;
@@ -4827,6 +4833,11 @@ int item::amount_of(const itype_id &it, bool used_as_tool) const
 }
 
 bool item::use_amount(const itype_id &it, long &quantity, std::list<item> &used)
+{
+    return use_amount( intern_itype_id( it ), quantity, used );
+}
+
+bool item::use_amount( const itype_iid it, long &quantity, std::list<item> &used )
 {
     // First, check contents
     for( auto a = contents.begin(); a != contents.end() && quantity > 0; ) {
@@ -4837,7 +4848,7 @@ bool item::use_amount(const itype_id &it, long &quantity, std::list<item> &used)
         }
     }
     // Now check the item itself
-    if (type->id == it && quantity > 0 && contents.empty()) {
+    if (type->iid == it && quantity > 0 && contents.empty()) {
         used.push_back(*this);
         quantity--;
         return true;
@@ -4888,10 +4899,15 @@ bool item::fill_with( item &liquid, std::string &err )
 }
 
 long item::charges_of(const itype_id &it) const
+{
+    return charges_of( intern_itype_id( it ) );
+}
+
+long item::charges_of( const itype_iid it ) const
 {
     long count = 0;
 
-    if (((type->id == it) || (is_tool() && (dynamic_cast<const it_tool *>(type))->subtype == it)) && contents.empty()) {
+    if (((type->iid == it) || (is_tool() && (dynamic_cast<const it_tool *>(type))->subtype_iid == it)) && contents.empty()) {
         // If we're specifically looking for a container, only say we have it if it's empty.
         if (charges < 0) {
             count++;
@@ -4907,6 +4923,11 @@ long item::charges_of(const itype_id &it) const
 }
 
 bool item::use_charges(const itype_id &it, long &quantity, std::list<item> &used)
+{
+    return use_charges( intern_itype_id( it ), quantity, used );
+}
+
+bool item::use_charges( const itype_iid it, long &quantity, std::list<item> &used )
 {
     // First, check contents
     for( auto a = contents.begin(); a != contents.end() && quantity > 0; ) {
@@ -4917,7 +4938,7 @@ bool item::use_charges(const itype_id &it, long &quantity, std::list<item> &used
         }
     }
     // Now check the item itself
-    if( !((type->id == it) || (is_tool() && (dynamic_cast<const it_tool *>(type))->subtype == it)) ||
+    if( !((type->iid == it) || (is_tool() && (dynamic_cast<const it_tool *>(type))->subtype_iid == it)) ||
         quantity <= 0 || !contents.empty() ) {
         return false;
     }
@@ -5797,6 +5818,11 @@ bool item::count_by_charges( const itype_id &id )
     return t->count_by_charges();
 }
 
+bool item::count_by_charges( const itype_iid id )
+{
+    return find_type( id )->count_by_charges();
+}
+
 bool item::type_is_defined( const itype_id &id )
 {
     return item_controller->has_template( id );
@@ -5807,6 +5833,11 @@ itype *item::find_type( const itype_id &type )
     return item_controller->find_template( type );
 }
 
+itype *item::find_type( const itype_iid type )
+{
+    return item_controller->find_template( type );
+}
+
 int item::get_gun_ups_drain() const
 {
     int draincount = 0;
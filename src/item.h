@@ -14,6 +14,9 @@
 #include "color.h"
 #include "bodypart.h"
 #include "string_id.h"
+#include "itype_iid.h"
+#include "flag_set.h"
+#include "flat_map.h"
 #include "line.h"
 #include "item_location.h"
 
@@ -377,12 +380,14 @@ class item : public JsonSerializer, public JsonDeserializer, public visitable<it
   * (not counted).
   */
  int amount_of(const itype_id &it, bool used_as_tool) const;
+ int amount_of( itype_iid it, bool used_as_tool ) const;
  /**
   * Count all the charges of items of the type 'it' including this item,
   * and any of its contents (recursively).
   * @param it The type id, only items with the same id are counted.
   */
  long charges_of(const itype_id &it) const;
+ long charges_of( itype_iid it ) const;
  /**
   * Consume a specific amount of charges from items of a specific type.
   * This includes this item, and any of its contents (recursively).
@@ -404,6 +409,7 @@ class item : public JsonSerializer, public JsonDeserializer, public visitable<it
   * therefor not delete itself.
   */
  bool use_charges(const itype_id &it, long &quantity, std::list<item> &used);
+ bool use_charges( itype_iid it, long &quantity, std::list<item> &used );
  /**
   * Consume a specific amount of items of a specific type.
   * This includes this item, and any of its contents (recursively).
@@ -413,6 +419,7 @@ class item : public JsonSerializer, public JsonDeserializer, public visitable<it
   * @param used On success all consumed items will be stored here.
   */
  bool use_amount(const itype_id &it, long &quantity, std::list<item> &used);
+ bool use_amount( itype_iid it, long &quantity, std::list<item> &used );
 
     /**
      * @name Containers
@@ -1326,11 +1333,13 @@ public:
          * Returns the item type of the given identifier. Never returns null.
          */
         static itype *find_type( const itype_id &id );
+        static itype *find_type( itype_iid id );
         /**
          * Whether the item is counted by charges, this is a static wrapper
          * around @ref count_by_charges, that does not need an items instance.
          */
         static bool count_by_charges( const itype_id &id );
+        static bool count_by_charges( itype_iid id );
         /**
          * Check whether the type id refers to a known type.
          * This should be used either before instantiating an item when it's possible
@@ -1357,7 +1366,7 @@ public:
         LIQUID_FILL_ERROR has_valid_capacity_for_liquid(const item &liquid) const;
         std::string name;
         const itype* curammo = nullptr;
-        std::map<std::string, std::string> item_vars;
+        flat_map<std::string, std::string> item_vars;
         const mtype* corpse = nullptr;
         std::set<matec_id> techniques; // item specific techniques
         light_emission light = nolight;
@@ -1381,7 +1390,7 @@ public:
     int note = 0;            // Associated dynamic text snippet.
     int irridation = 0;      // Tracks radiation dosage.
 
- std::set<std::string> item_tags; // generic item specific flags
+ flag_set item_tags; // generic item specific flags
     unsigned item_counter = 0; // generic counter to be used with item flags
     int mission_id = -1; // Refers to a mission in game's master list
     int player_id = -1; // Only give a mission to the right player!
@@ -616,19 +616,41 @@ itype *Item_factory::find_template(Item_tag id)
                                            "  You think it wants to be a %s.", id.c_str());
     bad_itype->sym = '.';
     bad_itype->color = c_white;
-    m_templates[id] = bad_itype;
+    set_template( bad_itype );
     return bad_itype;
 }
 
+itype *Item_factory::find_template( const itype_iid iid )
+{
+    if( static_cast<size_t>( iid.to_i() ) < m_templates_by_iid.size() ) {
+        itype *const type = m_templates_by_iid[iid.to_i()];
+        if( type != nullptr ) {
+            return type;
+        }
+    }
+    return find_template( itype_iid_str( iid ) );
+}
+
 void Item_factory::add_item_type(itype *new_type)
 {
     if( new_type == nullptr ) {
         debugmsg( "called Item_factory::add_item_type with nullptr" );
         return;
     }
+    set_template( new_type );
+}
+
+void Item_factory::set_template( itype *new_type )
+{
+    new_type->iid = intern_itype_id( new_type->id );
     auto &entry = m_templates[new_type->id];
     delete entry;
     entry = new_type;
+    const size_t index = new_type->iid.to_i();
+    if( m_templates_by_iid.size() <= index ) {
+        m_templates_by_iid.resize( index + 1, nullptr );
+    }
+    m_templates_by_iid[index] = new_type;
 }
 
 Item_spawn_data *Item_factory::get_group(const Item_tag &group_tag)
@@ -828,6 +850,7 @@ void Item_factory::load_tool(JsonObject &jo)
     jo.read( "revert_msg", tool_template->revert_msg );
 
     tool_template->subtype = jo.get_string("sub", "");
+    tool_template->subtype_iid = intern_itype_id( tool_template->subtype );
 
     itype *new_item_template = tool_template;
     load_basic_info(jo, new_item_template);
@@ -1065,13 +1088,9 @@ void Item_factory::load_basic_info(JsonObject &jo, itype *new_item_template)
 {
     std::string new_id = jo.get_string("id");
     new_item_template->id = new_id;
-    if (m_templates.count(new_id) > 0) {
-        // New item already exists. Because mods are loaded after
-        // core data, we override it. This allows mods to change
-        // item from core data.
-        delete m_templates[new_id];
-    }
-    m_templates[new_id] = new_item_template;
+    // If the item already exists, it is replaced. Because mods are loaded
+    // after core data, this allows mods to change item from core data.
+    set_template( new_item_template );
 
     // And then proceed to assign the correct field
     new_item_template->price = jo.get_int( "price" );
@@ -1347,6 +1366,7 @@ void Item_factory::clear()
         delete elem.second;
     }
     m_templates.clear();
+    m_templates_by_iid.clear();
     item_blacklist.clear();
     item_whitelist.clear();
     item_options.clear();
@@ -4,6 +4,7 @@
 #include "json.h"
 #include "iuse.h"
 #include "bodypart.h"
+#include "itype_iid.h"
 #include <string>
 #include <memory>
 #include <vector>
@@ -199,6 +200,10 @@ class Item_factory
          * @param id Item type id (@ref itype::id).
          */
         itype *find_template( Item_tag id );
+        /**
+         * Same as above, but looks the type up by its interned id, without comparing strings.
+         */
+        itype *find_template( itype_iid iid );
         /**
          * Add a passed in itype to the collection of item types.
          * If the item type overrides an existing type, the existing type is deleted first.
@@ -234,6 +239,8 @@ class Item_factory
         Item_tag create_artifact_id() const;
     private:
         std::map<Item_tag, itype *> m_templates;
+        /** The same types indexed by their interned id (@ref itype::iid), null for unknown ids. */
+        std::vector<itype *> m_templates_by_iid;
         typedef std::map<Group_tag, Item_spawn_data *> GroupMap;
         GroupMap m_template_groups;
 
@@ -298,6 +305,8 @@ class Item_factory
         void load_item_group_entries( Item_group &ig, JsonArray &entries );
 
         void load_basic_info( JsonObject &jo, itype *new_item );
+        /** Stores the type under its id, replacing (and deleting) any previous type of that id. */
+        void set_template( itype *new_type );
         void tags_from_json( JsonObject &jo, std::string member, std::set<std::string> &tags );
         void set_qualities_from_json( JsonObject &jo, std::string member, itype *new_item );
         void set_properties_from_json( JsonObject &jo, std::string member, itype *new_item );
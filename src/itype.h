@@ -7,6 +7,7 @@
 #include "pldata.h" // add_type
 #include "bodypart.h" // body_part::num_bp
 #include "string_id.h"
+#include "itype_iid.h"
 
 #include <string>
 #include <vector>
@@ -445,6 +446,8 @@ struct itype {
     // can be used as lookup key in master itype map
     // Used for save files; aligns to itype_id above.
     std::string id;
+    /** The interned @ref id, set when the type is added to the @ref Item_factory. */
+    itype_iid iid;
     /**
      * Slots for various item type properties. Each slot may contain a valid pointer or null, check
      * this before using it.
@@ -680,6 +683,8 @@ struct it_tool : itype {
     std::string revert_msg;
 
     std::string subtype;
+    /** The interned @ref subtype. */
+    itype_iid subtype_iid;
 
     long max_charges = 0;
     long def_charges = 0;
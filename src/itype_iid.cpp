@@ -0,0 +1,39 @@
+#include "itype_iid.h"
+
+#include <deque>
+#include <unordered_map>
+
+struct interned_itype_ids {
+    std::unordered_map<std::string, int> ids;
+    // A deque keeps the returned references valid when more ids are interned
+    std::deque<std::string> strings;
+
+    interned_itype_ids() {
+        ids[""] = 0;
+        strings.push_back( "" );
+    }
+};
+
+static interned_itype_ids &interned()
+{
+    static interned_itype_ids table;
+    return table;
+}
+
+itype_iid intern_itype_id( const std::string &id )
+{
+    interned_itype_ids &table = interned();
+    const auto iter = table.ids.find( id );
+    if( iter != table.ids.end() ) {
+        return itype_iid( iter->second );
+    }
+    const int iid = table.strings.size();
+    table.ids[id] = iid;
+    table.strings.push_back( id );
+    return itype_iid( iid );
+}
+
+const std::string &itype_iid_str( const itype_iid iid )
+{
+    return interned().strings[iid.to_i()];
+}
@@ -0,0 +1,27 @@
+#ifndef ITYPE_IID_H
+#define ITYPE_IID_H
+
+#include "int_id.h"
+
+#include <string>
+
+struct itype;
+
+/**
+ * Item type ids interned to integers, so code that compares item types over and over (counting
+ * items and charges in an inventory, checking crafting requirements) compares plain ints instead
+ * of strings. The string item type id (@ref itype::id) remains the one stored in json and save
+ * files, use @ref intern_itype_id to get the interned one.
+ * The interned id of the empty string is 0, the default value of @ref int_id.
+ */
+using itype_iid = int_id<itype>;
+
+/**
+ * Returns the interned id of the item type id, equal strings are always interned to the same id.
+ * Ids of unknown item types are interned as well, they just don't match any item type.
+ */
+itype_iid intern_itype_id( const std::string &id );
+/** The string item type id the id was interned from. */
+const std::string &itype_iid_str( itype_iid iid );
+
+#endif
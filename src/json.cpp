@@ -1,10 +1,12 @@
 #include "json.h"
 
+#include <algorithm>
 #include <cmath> // pow
 #include <cstdlib> // strtoul
 #include <cstring> // strcmp
 #include <fstream>
 #include <istream>
+#include <iterator>
 #include <locale> // ensure user's locale doesn't interfere with output
 #include <set>
 #include <sstream>
@@ -65,32 +67,59 @@ std::string utf16_to_utf8(uint32_t ch)
  * represents a JSON object,
  * providing access to the underlying data.
  */
-JsonObject::JsonObject(JsonIn &j) : positions()
+// orders member names like std::string does
+static int compare_member_name(const char *a, size_t a_length, const char *b, size_t b_length)
+{
+    const int result = memcmp(a, b, std::min(a_length, b_length));
+    if (result != 0) {
+        return result;
+    }
+    return a_length < b_length ? -1 : a_length > b_length ? 1 : 0;
+}
+
+JsonObject::JsonObject(JsonIn &j) : members()
 {
     jsin = &j;
     start = jsin->tell();
     // cache the position of the value for each member
     jsin->start_object();
     while (!jsin->end_object()) {
-        std::string n = jsin->get_member_name();
-        int p = jsin->tell();
-        if (n != "//" && n != "comment" && positions.count(n) > 0) {
-            // members with name "//" or "comment" are used for comments and
-            // should be ignored anyway.
-            j.error("duplicate entry in json object");
-        }
-        positions[n] = p;
+        const std::pair<const char *, size_t> n = jsin->get_member_name_view();
+        members.push_back({ n.first, n.second, jsin->tell() });
         jsin->skip_value();
     }
     end = jsin->tell();
     final_separator = jsin->get_ate_separator();
+
+    const auto by_name = [](const member &a, const member &b) {
+        return compare_member_name(a.name, a.length, b.name, b.length) < 0;
+    };
+    std::stable_sort(members.begin(), members.end(), by_name);
+    // members with name "//" or "comment" are used for comments and
+    // may appear more than once, the last one is kept
+    auto last = members.begin();
+    for (auto it = members.begin(); it != members.end(); ++it) {
+        if (last != it && !by_name(*last, *it)) {
+            const std::string n(it->name, it->length);
+            if (n != "//" && n != "comment") {
+                j.seek(std::max(last->position, it->position));
+                j.error("duplicate entry in json object");
+            }
+            *last = *it;
+        } else if (last != it) {
+            *++last = *it;
+        }
+    }
+    if (!members.empty()) {
+        members.erase(last + 1, members.end());
+    }
 }
 
 JsonObject::JsonObject(const JsonObject &jo)
 {
     jsin = jo.jsin;
     start = jo.start;
-    positions = jo.positions;
+    members = jo.members;
     end = jo.end;
     final_separator = jo.final_separator;
 }
@@ -105,19 +134,23 @@ void JsonObject::finish()
 
 size_t JsonObject::size()
 {
-    return positions.size();
+    return members.size();
 }
 bool JsonObject::empty()
 {
-    return positions.empty();
+    return members.empty();
 }
 
 int JsonObject::verify_position(const std::string &name,
                                 const bool throw_exception)
 {
-    int pos = positions[name]; // initialized to 0 if it doesn't exist
-    if (pos > start) {
-        return pos;
+    const auto iter = std::lower_bound(members.begin(), members.end(), name,
+    [](const member &m, const std::string &n) {
+        return compare_member_name(m.name, m.length, n.data(), n.size()) < 0;
+    });
+    if (iter != members.end() && iter->length == name.size() &&
+        memcmp(iter->name, name.data(), name.size()) == 0) {
+        return iter->position;
     } else if (throw_exception && !jsin) {
         throw JsonError( std::string( "member lookup on empty object: " ) + name );
     } else if (throw_exception) {
@@ -137,8 +170,8 @@ bool JsonObject::has_member(const std::string &name)
 std::set<std::string> JsonObject::get_member_names()
 {
     std::set<std::string> ret;
-    for( auto &elem : positions ) {
-        ret.insert( elem.first );
+    for( auto &elem : members ) {
+        ret.insert( ret.end(), std::string( elem.name, elem.length ) );
     }
     return ret;
 }
@@ -202,7 +235,7 @@ bool JsonObject::get_bool(const std::string &name)
 
 bool JsonObject::get_bool(const std::string &name, const bool fallback)
 {
-    int pos = positions[name];
+    int pos = verify_position(name, false);
     if (pos <= start) {
         return fallback;
     }
@@ -219,7 +252,7 @@ int JsonObject::get_int(const std::string &name)
 
 int JsonObject::get_int(const std::string &name, const int fallback)
 {
-    int pos = positions[name];
+    int pos = verify_position(name, false);
     if (pos <= start) {
         return fallback;
     }
@@ -236,7 +269,7 @@ long JsonObject::get_long(const std::string &name)
 
 long JsonObject::get_long(const std::string &name, const long fallback)
 {
-    long pos = positions[name];
+    long pos = verify_position(name, false);
     if (pos <= start) {
         return fallback;
     }
@@ -253,7 +286,7 @@ double JsonObject::get_float(const std::string &name)
 
 double JsonObject::get_float(const std::string &name, const double fallback)
 {
-    int pos = positions[name];
+    int pos = verify_position(name, false);
     if (pos <= start) {
         return fallback;
     }
@@ -270,7 +303,7 @@ std::string JsonObject::get_string(const std::string &name)
 
 std::string JsonObject::get_string(const std::string &name, const std::string &fallback)
 {
-    int pos = positions[name];
+    int pos = verify_position(name, false);
     if (pos <= start) {
         return fallback;
     }
@@ -282,7 +315,7 @@ std::string JsonObject::get_string(const std::string &name, const std::string &f
 
 JsonArray JsonObject::get_array(const std::string &name)
 {
-    int pos = positions[name];
+    int pos = verify_position(name, false);
     if (pos <= start) {
         return JsonArray(); // empty array
     }
@@ -312,7 +345,7 @@ std::vector<std::string> JsonObject::get_string_array(const std::string &name)
 
 JsonObject JsonObject::get_object(const std::string &name)
 {
-    int pos = positions[name];
+    int pos = verify_position(name, false);
     if (pos <= start) {
         return JsonObject(); // empty object
     }
@@ -323,7 +356,7 @@ JsonObject JsonObject::get_object(const std::string &name)
 std::set<std::string> JsonObject::get_tags(const std::string &name)
 {
     std::set<std::string> ret;
-    int pos = positions[name];
+    int pos = verify_position(name, false);
     if (pos <= start) {
         return ret; // empty set
     }
@@ -713,51 +746,75 @@ bool JsonArray::has_object(int i)
 
 
 /* class JsonIn
- * represents an istream of JSON data,
+ * represents a buffer of JSON data,
  * allowing easy extraction into c++ datatypes.
  */
 JsonIn::JsonIn(std::istream &s, bool strict) :
-    stream(&s), strict(strict), ate_separator(false)
+    stream_text(std::istreambuf_iterator<char>(s), std::istreambuf_iterator<char>()),
+    start(stream_text.data()), cur(start), end(start + stream_text.size()),
+    strict(strict), ate_separator(false)
+{
+}
+
+JsonIn::JsonIn( const char *data, size_t size, bool strict ) :
+    start( data ), cur( data ), end( data + size ), strict( strict ), ate_separator( false )
 {
 }
 
 int JsonIn::tell()
 {
-    return stream->tellg();
+    return cur - start;
 }
 char JsonIn::peek()
 {
-    return (char)stream->peek();
+    return cur < end ? *cur : (char)EOF;
 }
 bool JsonIn::good()
 {
-    return stream->good();
+    return cur < end;
 }
 
 void JsonIn::seek(int pos)
 {
-    stream->clear();
-    stream->seekg(pos);
+    cur = start + std::max( 0, std::min( pos, int( end - start ) ) );
     ate_separator = false;
 }
 
 void JsonIn::eat_whitespace()
 {
-    while (is_whitespace(peek())) {
-        stream->get();
+    while (cur < end && is_whitespace(*cur)) {
+        ++cur;
     }
 }
 
 void JsonIn::uneat_whitespace()
 {
-    while (tell() > 0) {
-        stream->seekg(-1, std::istream::cur);
-        if (!is_whitespace(peek())) {
+    while (cur > start) {
+        --cur;
+        if (!is_whitespace(*cur)) {
             break;
         }
     }
 }
 
+bool JsonIn::skip_word( const char *word, size_t length )
+{
+    if( size_t( end - cur ) < length || strncmp( cur, word, length ) != 0 ) {
+        return false;
+    }
+    cur += length;
+    return true;
+}
+
+std::string JsonIn::next_text( size_t length ) const
+{
+    const char *text_end = cur;
+    while( text_end < end && text_end < cur + length && *text_end != '\n' ) {
+        ++text_end;
+    }
+    return std::string( cur, text_end );
+}
+
 void JsonIn::end_value()
 {
     ate_separator = false;
@@ -773,14 +830,20 @@ void JsonIn::skip_member()
 
 void JsonIn::skip_separator()
 {
-    signed char ch;
     eat_whitespace();
-    ch = peek();
-    if (ch == ',') {
+    const char ch = peek();
+    if (cur >= end) {
+        // that's okay too... probably
+        if (strict && ate_separator) {
+            uneat_whitespace();
+            error("separator at end of file not strictly allowed");
+        }
+        ate_separator = false;
+    } else if (ch == ',') {
         if (strict && ate_separator) {
             error("duplicate separator");
         }
-        stream->get();
+        ++cur;
         ate_separator = true;
     } else if (ch == ']' || ch == '}' || ch == ':') {
         // okay
@@ -791,13 +854,6 @@ void JsonIn::skip_separator()
             error(err.str());
         }
         ate_separator = false;
-    } else if (ch == EOF) {
-        // that's okay too... probably
-        if (strict && ate_separator) {
-            uneat_whitespace();
-            error("separator at end of file not strictly allowed");
-        }
-        ate_separator = false;
     } else if (strict) {
         // not okay >:(
         uneat_whitespace();
@@ -807,33 +863,33 @@ void JsonIn::skip_separator()
 
 void JsonIn::skip_pair_separator()
 {
-    char ch;
     eat_whitespace();
-    stream->get(ch);
-    if (ch != ':') {
+    if (peek() != ':') {
         std::stringstream err;
-        err << "expected pair separator ':', not '" << ch << "'";
-        error(err.str(), -1);
+        err << "expected pair separator ':', not '" << peek() << "'";
+        error(err.str());
     } else if (strict && ate_separator) {
-        error("duplicate separator not strictly allowed", -1);
+        error("duplicate separator not strictly allowed");
     }
+    ++cur;
     ate_separator = true;
 }
 
 void JsonIn::skip_string()
 {
-    char ch;
     eat_whitespace();
-    stream->get(ch);
-    if (ch != '"') {
+    if (peek() != '"') {
         std::stringstream err;
-        err << "expecting string but found '" << ch << "'";
-        error(err.str(), -1);
+        err << "expecting string but found '" << peek() << "'";
+        error(err.str());
     }
-    while (stream->good()) {
-        stream->get(ch);
+    ++cur;
+    while (cur < end) {
+        const char ch = *cur++;
         if (ch == '\\') {
-            stream->get(ch);
+            if (cur < end) {
+                ++cur;
+            }
             continue;
         } else if (ch == '"') {
             break;
@@ -897,55 +953,48 @@ void JsonIn::skip_array()
 
 void JsonIn::skip_true()
 {
-    char text[5];
     eat_whitespace();
-    stream->get(text, 5);
-    if (strcmp(text, "true") != 0) {
+    if (!skip_word("true", 4)) {
         std::stringstream err;
-        err << "expected \"true\", but found \"" << text << "\"";
-        error(err.str(), -4);
+        err << "expected \"true\", but found \"" << next_text(4) << "\"";
+        error(err.str());
     }
     end_value();
 }
 
 void JsonIn::skip_false()
 {
-    char text[6];
     eat_whitespace();
-    stream->get(text, 6);
-    if (strcmp(text, "false") != 0) {
+    if (!skip_word("false", 5)) {
         std::stringstream err;
-        err << "expected \"false\", but found \"" << text << "\"";
-        error(err.str(), -5);
+        err << "expected \"false\", but found \"" << next_text(5) << "\"";
+        error(err.str());
     }
     end_value();
 }
 
 void JsonIn::skip_null()
 {
-    char text[5];
     eat_whitespace();
-    stream->get(text, 5);
-    if (strcmp(text, "null") != 0) {
+    if (!skip_word("null", 4)) {
         std::stringstream err;
-        err << "expected \"null\", but found \"" << text << "\"";
-        error(err.str(), -4);
+        err << "expected \"null\", but found \"" << next_text(4) << "\"";
+        error(err.str());
     }
     end_value();
 }
 
 void JsonIn::skip_number()
 {
-    char ch;
     eat_whitespace();
     // skip all of (+-0123456789.eE)
-    while (stream->good()) {
-        stream->get(ch);
+    while (cur < end) {
+        const char ch = *cur;
         if (ch != '+' && ch != '-' && (ch < '0' || ch > '9') &&
             ch != 'e' && ch != 'E' && ch != '.') {
-            stream->unget();
             break;
         }
+        ++cur;
     }
     end_value();
 }
@@ -957,40 +1006,59 @@ std::string JsonIn::get_member_name()
     return s;
 }
 
+std::pair<const char *, size_t> JsonIn::get_member_name_view()
+{
+    eat_whitespace();
+    if (peek() == '"') {
+        // most names have nothing to unescape
+        for (const char *p = cur + 1; p < end; ++p) {
+            if (*p == '"') {
+                const std::pair<const char *, size_t> name(cur + 1, p - cur - 1);
+                cur = p + 1;
+                end_value();
+                skip_pair_separator();
+                return name;
+            } else if (*p == '\\' || (unsigned char)*p < 0x20) {
+                break;
+            }
+        }
+    }
+    // get_string reports any errors
+    unescaped_names.push_back(get_string());
+    skip_pair_separator();
+    return std::make_pair(unescaped_names.back().data(), unescaped_names.back().size());
+}
+
 std::string JsonIn::get_string()
 {
-    std::string s = "";
-    char ch;
-    bool backslash = false;
-    char unihex[5] = "0000";
+    std::string s;
     eat_whitespace();
     int startpos = tell();
     // the first character had better be a '"'
-    stream->get(ch);
-    if (ch != '"') {
+    if (peek() != '"') {
         std::stringstream err;
-        err << "expecting string but got '" << ch << "'";
-        error(err.str(), -1);
+        err << "expecting string but got '" << peek() << "'";
+        error(err.str());
     }
-    // add chars to the string, one at a time, converting:
+    ++cur;
+    // copy the characters in between escapes all at once, converting:
     // \", \\, \/, \b, \f, \n, \r, \t and \uxxxx according to JSON spec.
-    while (stream->good()) {
-        stream->get(ch);
-        if (ch == '\\') {
-            if (backslash) {
-                s += '\\';
-                backslash = false;
-            } else {
-                backslash = true;
-                continue;
+    const char *plain = cur;
+    while (cur < end) {
+        char ch = *cur;
+        if (ch == '"') {
+            // end of the string
+            s.append(plain, cur);
+            ++cur;
+            end_value();
+            return s;
+        } else if (ch == '\\') {
+            s.append(plain, cur);
+            if (++cur == end) {
+                break;
             }
-        } else if (backslash) {
-            backslash = false;
-            if (ch == '"') {
-                s += '"';
-            } else if (ch == '/') {
-                s += '/';
-            } else if (ch == 'b') {
+            ch = *cur++;
+            if (ch == 'b') {
                 s += '\b';
             } else if (ch == 'f') {
                 s += '\f';
@@ -1002,40 +1070,32 @@ std::string JsonIn::get_string()
                 s += '\t';
             } else if (ch == 'u') {
                 // get the next four characters as hexadecimal
-                stream->get(unihex, 5);
+                const std::string unihex = next_text(4);
+                cur += unihex.size();
                 // insert the appropriate unicode character in utf8
                 // TODO: verify that unihex is in fact 4 hex digits.
-                char **endptr = 0;
-                uint32_t u = (uint32_t)strtoul(unihex, endptr, 16);
+                uint32_t u = (uint32_t)strtoul(unihex.c_str(), nullptr, 16);
                 try {
                     s += utf16_to_utf8(u);
                 } catch( const std::exception &err ) {
                     error( err.what() );
                 }
             } else {
-                // for anything else, just add the character, i suppose
+                // '"', '\\', '/' and for anything else, just add the character, i suppose
                 s += ch;
             }
-        } else if (ch == '"') {
-            // end of the string
-            end_value();
-            return s;
+            plain = cur;
         } else if (strict && (ch == '\r' || ch == '\n')) {
-            error("reached end of line without closing string", -1);
+            error("reached end of line without closing string");
         } else if (strict && (unsigned char)ch < 0x20) {
-            error("invalid character inside string", -1);
+            error("invalid character inside string");
         } else {
-            s += ch;
+            ++cur;
         }
     }
-    // if we get to here, probably hit a premature EOF?
-    if (stream->eof()) {
-        stream->clear();
-        seek(startpos);
-        error("couldn't find end of string, reached EOF.");
-    } else if (stream->fail()) {
-        throw JsonError( "stream failure while reading string." );
-    }
+    // if we get to here, we hit a premature EOF
+    seek(startpos);
+    error("couldn't find end of string, reached EOF.");
     throw JsonError( "something went wrong D:" );
 }
 
@@ -1056,66 +1116,69 @@ long JsonIn::get_long()
 double JsonIn::get_float()
 {
     // this could maybe be prettier?
-    char ch;
     bool neg = false;
     int i = 0;
     int e = 0;
     int mod_e = 0;
     eat_whitespace();
-    stream->get(ch);
+    // the character at the current position, or '\0' at the end
+    const auto next = [this]() {
+        ++cur;
+        return cur < end ? *cur : '\0';
+    };
+    char ch = cur < end ? *cur : '\0';
     if (ch == '-') {
         neg = true;
-        stream->get(ch);
+        ch = next();
     } else if (ch != '.' && (ch < '0' || ch > '9')) {
         // not a valid float
         std::stringstream err;
         err << "expecting number but found '" << ch << "'";
-        error(err.str(), -1);
+        error(err.str());
     }
     if (strict && ch == '0') {
         // allow a single leading zero in front of a '.' or 'e'/'E'
-        stream->get(ch);
+        ch = next();
         if (ch >= '0' && ch <= '9') {
-            error("leading zeros not strictly allowed", -1);
+            error("leading zeros not strictly allowed");
         }
     }
     while (ch >= '0' && ch <= '9') {
         i *= 10;
         i += (ch - '0');
-        stream->get(ch);
+        ch = next();
     }
     if (ch == '.') {
-        stream->get(ch);
+        ch = next();
         while (ch >= '0' && ch <= '9') {
             i *= 10;
             i += (ch - '0');
             mod_e -= 1;
-            stream->get(ch);
+            ch = next();
         }
     }
     if (neg) {
         i *= -1;
     }
     if (ch == 'e' || ch == 'E') {
-        stream->get(ch);
+        ch = next();
         neg = false;
         if (ch == '-') {
             neg = true;
-            stream->get(ch);
+            ch = next();
         } else if (ch == '+') {
-            stream->get(ch);
+            ch = next();
         }
         while (ch >= '0' && ch <= '9') {
             e *= 10;
             e += (ch - '0');
-            stream->get(ch);
+            ch = next();
         }
         if (neg) {
             e *= -1;
         }
     }
-    // unget the final non-number character (probably a separator)
-    stream->unget();
+    // the final non-number character (probably a separator) is left alone
     end_value();
     // now put it all together!
     return i * std::pow(10.0f, e + mod_e);
@@ -1123,34 +1186,30 @@ double JsonIn::get_float()
 
 bool JsonIn::get_bool()
 {
-    char ch;
-    char text[5];
     std::stringstream err;
     eat_whitespace();
-    stream->get(ch);
+    const char ch = peek();
     if (ch == 't') {
-        stream->get(text, 4);
-        if (strcmp(text, "rue") == 0) {
+        if (skip_word("true", 4)) {
             end_value();
             return true;
         } else {
             err << "not a boolean. expected \"true\", but got \"";
-            err << ch << text << "\"";
-            error(err.str(), -4);
+            err << next_text(4) << "\"";
+            error(err.str());
         }
     } else if (ch == 'f') {
-        stream->get(text, 5);
-        if (strcmp(text, "alse") == 0) {
+        if (skip_word("false", 5)) {
             end_value();
             return false;
         } else {
             err << "not a boolean. expected \"false\", but got \"";
-            err << ch << text << "\"";
-            error(err.str(), -5);
+            err << next_text(5) << "\"";
+            error(err.str());
         }
     }
     err << "not a boolean value! expected 't' or 'f' but got '" << ch << "'";
-    error(err.str(), -1);
+    error(err.str());
     throw JsonError( "warnings are silly" );
 }
 
@@ -1167,7 +1226,7 @@ void JsonIn::start_array()
 {
     eat_whitespace();
     if (peek() == '[') {
-        stream->get();
+        ++cur;
         ate_separator = false;
         return;
     } else {
@@ -1187,7 +1246,7 @@ bool JsonIn::end_array()
             uneat_whitespace();
             error("separator not strictly allowed at end of array");
         }
-        stream->get();
+        ++cur;
         end_value();
         return true;
     } else {
@@ -1200,7 +1259,7 @@ void JsonIn::start_object()
 {
     eat_whitespace();
     if (peek() == '{') {
-        stream->get();
+        ++cur;
         ate_separator = false; // not that we want to
         return;
     } else {
@@ -1220,7 +1279,7 @@ bool JsonIn::end_object()
             uneat_whitespace();
             error("separator not strictly allowed at end of object");
         }
-        stream->get();
+        ++cur;
         end_value();
         return true;
     } else {
@@ -1450,26 +1509,16 @@ bool JsonIn::read(JsonDeserializer &j)
 // WARNING: for occasional use only.
 std::string JsonIn::line_number(int offset_modifier)
 {
-    if (stream->eof()) {
-        return "EOF";
-    } else if (stream->fail()) {
-        return "???";
-    } // else stream is fine
-    int pos = tell();
     int line = 1;
     int offset = 1;
-    char ch;
-    seek(0);
-    for (int i = 0; i < pos; ++i) {
-        stream->get(ch);
-        if (ch == '\r') {
+    for (const char *p = start; p < cur; ++p) {
+        if (*p == '\r') {
             offset = 1;
             ++line;
-            if (peek() == '\n') {
-                stream->get();
-                ++i;
+            if (p + 1 < cur && p[1] == '\n') {
+                ++p;
             }
-        } else if (ch == '\n') {
+        } else if (*p == '\n') {
             offset = 1;
             ++line;
         } else {
@@ -1485,54 +1534,51 @@ void JsonIn::error(std::string message, int offset)
 {
     std::ostringstream err;
     err << line_number(offset) << ": " << message;
-    // if we can't get more info from the stream don't try
-    if (!stream->good()) {
+    // if there is no more text don't try to show any
+    if (cur >= end) {
         throw JsonError( err.str() );
     }
     // also print surrounding few lines of context, if not too large
     err << "\n\n";
-    stream->seekg(offset, std::istream::cur);
-    size_t pos = tell();
+    seek(tell() + offset);
+    const char *const pos = cur;
     rewind(3, 240);
-    size_t startpos = tell();
-    char buffer[241];
-    stream->read(&buffer[0], pos - startpos);
-    buffer[pos - startpos] = '\0';
-    err << buffer;
-    if (!is_whitespace(peek())) {
-        err << peek();
+    err << std::string(cur, pos);
+    if (pos < end && !is_whitespace(*pos)) {
+        err << *pos;
     }
     // display a pointer to the position
+    cur = pos;
     rewind(1, 240);
-    startpos = tell();
+    const char *const line_start = cur;
     err << '\n';
-    if (pos > startpos) {
-        err << std::string(pos - startpos - 1, ' ');
+    if (pos > line_start) {
+        err << std::string(pos - line_start - 1, ' ');
     }
     err << "^\n";
-    seek(pos);
+    cur = pos;
     // if that wasn't the end of the line, continue underneath pointer
-    char ch = stream->get();
-    if (ch == '\r') {
-        if (peek() == '\n') {
-            stream->get();
-        }
-    } else if (ch == '\n') {
-        // pass
-    } else if (peek() != '\r' && peek() != '\n') {
-        for (size_t i = 0; i < pos - startpos; ++i) {
-            err << ' ';
+    if (cur < end) {
+        const char ch = *cur++;
+        if (ch == '\r') {
+            if (peek() == '\n') {
+                ++cur;
+            }
+        } else if (ch == '\n') {
+            // pass
+        } else if (peek() != '\r' && peek() != '\n') {
+            err << std::string(pos - line_start, ' ');
         }
     }
     // print the next couple lines as well
     int line_count = 0;
-    for (int i = 0; i < 240; ++i) {
-        stream->get(ch);
+    for (int i = 0; i < 240 && cur < end; ++i) {
+        const char ch = *cur++;
         err << ch;
         if (ch == '\r') {
             ++line_count;
             if (peek() == '\n') {
-                err << stream->get();
+                err << *cur++;
             }
         } else if (ch == '\n') {
             ++line_count;
@@ -1551,48 +1597,40 @@ void JsonIn::rewind(int max_lines, int max_chars)
         seek(0);
         return;
     }
-    if (tell() == 0) {
+    if (cur == start) {
         return;
     }
     int lines_found = 0;
-    stream->seekg(-1, std::istream::cur);
+    --cur;
     for (int i = 0; i < max_chars; ++i) {
-        size_t tellpos = tell();
-        if (peek() == '\n') {
+        if (*cur == '\n') {
             ++lines_found;
-            if (tellpos > 0) {
-                stream->seekg(-1, std::istream::cur);
-                // note: does not update tellpos or count a character
-                if (peek() != '\r') {
+            if (cur > start) {
+                --cur;
+                // note: does not count a character
+                if (*cur != '\r') {
                     continue;
                 }
             }
-        } else if (peek() == '\r') {
+        } else if (*cur == '\r') {
             ++lines_found;
         }
-        if (tellpos == 0) {
+        if (cur == start) {
             break;
         } else if (lines_found == max_lines) {
             // don't include the last \n or \r
-            stream->seekg(1, std::istream::cur);
+            ++cur;
             break;
         }
-        stream->seekg(-1, std::istream::cur);
+        --cur;
     }
 }
 
 std::string JsonIn::substr(size_t pos, size_t len)
 {
-    std::string ret;
-    if (len == std::string::npos) {
-        stream->seekg(0, std::istream::end);
-        size_t end = tell();
-        len = end - pos;
-    }
-    ret.resize(len);
-    stream->seekg(pos);
-    stream->read(&ret[0], len);
-    return ret;
+    pos = std::min(pos, size_t(end - start));
+    len = std::min(len, size_t(end - start) - pos);
+    return std::string(start + pos, len);
 }
 
 
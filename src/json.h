@@ -3,7 +3,9 @@
 
 #include <type_traits>
 #include <iosfwd>
+#include <list>
 #include <string>
+#include <utility>
 #include <vector>
 #include <bitset>
 #include <array>
@@ -80,8 +82,10 @@ inline E string_to_enum_look_up( const C &container, const std::string &data )
 /* JsonIn
  * ======
  *
- * The JsonIn class provides a wrapper around a std::istream,
- * with methods for reading JSON data directly from the stream.
+ * The JsonIn class provides a wrapper around a buffer of JSON text,
+ * with methods for reading JSON data directly from it.
+ * It can be given the buffer directly, e.g. a @ref mapped_file,
+ * or a std::istream, in which case the rest of the stream is read into memory first.
  *
  * JsonObject and JsonArray provide higher-level wrappers,
  * and are a little easier to use in most cases,
@@ -103,7 +107,7 @@ inline E string_to_enum_look_up( const C &container, const std::string &data )
  *
  * If the JSON structure is not as expected,
  * verbose error messages are provided, indicating the problem,
- * and the exact line number and byte offset within the istream.
+ * and the exact line number and byte offset within the text.
  *
  *
  * Single-Pass Loading
@@ -160,16 +164,29 @@ inline E string_to_enum_look_up( const C &container, const std::string &data )
 class JsonIn
 {
     private:
-        std::istream *stream;
+        std::string stream_text; // the text read from a stream, empty if the buffer isn't ours
+        std::list<std::string> unescaped_names; // member names that had to be copied out of the text
+        const char *start; // the text being parsed
+        const char *cur;
+        const char *end;
         bool strict; // throw errors on non-RFC-4627-compliant input
         bool ate_separator;
 
         void skip_separator();
         void skip_pair_separator();
         void end_value();
+        // skips the word if it comes next, leaves the position alone otherwise
+        bool skip_word( const char *word, size_t length );
+        // up to length characters from the current position to the end of the line
+        std::string next_text( size_t length ) const;
 
     public:
         JsonIn(std::istream &stream, bool strict = true);
+        // the buffer must outlive the JsonIn and any JsonObject or JsonArray read from it
+        JsonIn( const char *data, size_t size, bool strict = true );
+        // objects and arrays keep a pointer to their JsonIn
+        JsonIn( const JsonIn & ) = delete;
+        JsonIn &operator=( const JsonIn & ) = delete;
 
         bool get_ate_separator()
         {
@@ -180,10 +197,10 @@ class JsonIn
             ate_separator = s;
         }
 
-        int tell(); // get current stream position
-        void seek(int pos); // seek to specified stream position
+        int tell(); // get current position
+        void seek(int pos); // seek to specified position
         char peek(); // what's the next char gonna be?
-        bool good(); // whether stream is ok
+        bool good(); // whether there is anything left to read
 
         // advance seek head to the next non-whitespace character
         void eat_whitespace();
@@ -208,6 +225,9 @@ class JsonIn
         bool get_bool(); // get the next value as a bool
         double get_float(); // get the next value as a double
         std::string get_member_name(); // also strips the ':'
+        // like get_member_name, but points into the text instead of copying the name,
+        // the name is not 0-terminated and stays valid as long as the JsonIn does
+        std::pair<const char *, size_t> get_member_name_view();
         JsonObject get_object();
         JsonArray get_array();
 
@@ -599,7 +619,13 @@ class JsonOut
 class JsonObject
 {
     private:
-        std::map<std::string, int> positions;
+        // a member name, as given by JsonIn::get_member_name_view, and where its value starts
+        struct member {
+            const char *name;
+            size_t length;
+            int position;
+        };
+        std::vector<member> members; // sorted by name, built once, much cheaper than a map
         int start;
         int end;
         bool final_separator;
@@ -610,7 +636,7 @@ class JsonObject
     public:
         JsonObject(JsonIn &jsin);
         JsonObject(const JsonObject &jsobj);
-        JsonObject() : positions(), start(0), end(0), jsin(NULL) {}
+        JsonObject() : members(), start(0), end(0), jsin(NULL) {}
         ~JsonObject()
         {
             finish();
@@ -690,7 +716,7 @@ class JsonObject
         // return false if the member is not found.
         template <typename T> bool read(const std::string &name, T &t)
         {
-            int pos = positions[name];
+            int pos = verify_position(name, false);
             if (pos <= start) {
                 return false;
             }
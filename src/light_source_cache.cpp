@@ -0,0 +1,153 @@
+#include "light_source_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+light_source_cache::light_source_cache()
+{
+    generation = 0;
+    std::fill_n( &block_generation[0][0], MAPSIZE * MAPSIZE, 0 );
+}
+
+void light_source_cache::update( const grid &transparency, const tripoint &abs_sub )
+{
+    generation++;
+    if( last_transparency.empty() || abs_sub != last_abs_sub ) {
+        sources.clear();
+        last_transparency.resize( MAPSIZE * SEEX * MAPSIZE * SEEY );
+        std::fill_n( &block_generation[0][0], MAPSIZE * MAPSIZE, generation );
+    } else {
+        const float *last = last_transparency.data();
+        for( int bx = 0; bx < MAPSIZE; bx++ ) {
+            for( int by = 0; by < MAPSIZE; by++ ) {
+                for( int x = bx * SEEX; x < ( bx + 1 ) * SEEX; x++ ) {
+                    if( std::memcmp( &transparency[x][by * SEEY], &last[x * MAPSIZE * SEEY + by * SEEY],
+                                     SEEY * sizeof( float ) ) != 0 ) {
+                        block_generation[bx][by] = generation;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    std::memcpy( last_transparency.data(), &transparency[0][0], sizeof( grid ) );
+    last_abs_sub = abs_sub;
+
+    for( auto &src : sources ) {
+        src.second.used = false;
+    }
+}
+
+bool light_source_cache::is_current( const source &src ) const
+{
+    const light_contribution &contribution = src.contribution;
+    if( contribution.width == 0 ) {
+        return true;
+    }
+    const int max_bx = ( contribution.min_x + contribution.width - 1 ) / SEEX;
+    const int max_by = ( contribution.min_y + contribution.height - 1 ) / SEEY;
+    for( int bx = contribution.min_x / SEEX; bx <= max_bx; bx++ ) {
+        for( int by = contribution.min_y / SEEY; by <= max_by; by++ ) {
+            if( block_generation[bx][by] > src.generation ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const light_contribution &light_source_cache::get( const int x, const int y,
+        const float luminance, const unsigned char directions, const cast_function &cast )
+{
+    source &src = sources[x * MAPSIZE * SEEY + y];
+    src.used = true;
+    if( src.generation != 0 && src.luminance == luminance && src.directions == directions &&
+        is_current( src ) ) {
+        return src.contribution;
+    }
+
+    if( scratch.empty() ) {
+        scratch.resize( MAPSIZE * SEEX * MAPSIZE * SEEY, 0.0f );
+    }
+    grid &out = *reinterpret_cast<grid *>( scratch.data() );
+    cast( out );
+
+    // Light never gets further than 60 squares, see castLight
+    const int min_x = std::max( 0, x - 60 );
+    const int max_x = std::min( MAPSIZE * SEEX - 1, x + 60 );
+    const int min_y = std::max( 0, y - 60 );
+    const int max_y = std::min( MAPSIZE * SEEY - 1, y + 60 );
+    int lit_min_x = max_x + 1;
+    int lit_max_x = min_x - 1;
+    int lit_min_y = max_y + 1;
+    int lit_max_y = min_y - 1;
+    for( int i = min_x; i <= max_x; i++ ) {
+        for( int j = min_y; j <= max_y; j++ ) {
+            if( out[i][j] != 0.0f ) {
+                lit_min_x = std::min( lit_min_x, i );
+                lit_max_x = i;
+                lit_min_y = std::min( lit_min_y, j );
+                lit_max_y = std::max( lit_max_y, j );
+            }
+        }
+    }
+
+    light_contribution &contribution = src.contribution;
+    contribution.light.clear();
+    if( lit_min_x > lit_max_x ) {
+        contribution.width = 0;
+        contribution.height = 0;
+    } else {
+        contribution.min_x = lit_min_x;
+        contribution.min_y = lit_min_y;
+        contribution.width = lit_max_x - lit_min_x + 1;
+        contribution.height = lit_max_y - lit_min_y + 1;
+        contribution.light.reserve( contribution.width * contribution.height );
+        for( int i = lit_min_x; i <= lit_max_x; i++ ) {
+            contribution.light.insert( contribution.light.end(), &out[i][lit_min_y],
+                                       &out[i][lit_max_y] + 1 );
+        }
+    }
+    for( int i = min_x; i <= max_x; i++ ) {
+        std::fill( &out[i][min_y], &out[i][max_y] + 1, 0.0f );
+    }
+
+    src.luminance = luminance;
+    src.directions = directions;
+    src.generation = generation;
+    return contribution;
+}
+
+void light_source_cache::forget_unused()
+{
+    for( auto it = sources.begin(); it != sources.end(); ) {
+        if( it->second.used ) {
+            ++it;
+        } else {
+            it = sources.erase( it );
+        }
+    }
+}
+
+void light_source_cache::clear()
+{
+    sources.clear();
+    last_transparency.clear();
+}
+
+size_t light_source_cache::size() const
+{
+    return sources.size();
+}
+
+void light_source_cache::apply( const light_contribution &contribution, grid &lm )
+{
+    const float *light = contribution.light.data();
+    for( int i = 0; i < contribution.width; i++ ) {
+        float *const column = &lm[contribution.min_x + i][contribution.min_y];
+        for( int j = 0; j < contribution.height; j++ ) {
+            column[j] = std::max( column[j], light[j] );
+        }
+        light += contribution.height;
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef LIGHT_SOURCE_CACHE_H
+#define LIGHT_SOURCE_CACHE_H
+
+#include "enums.h"
+#include "game_constants.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+/** The squares lit by a single light source, see @ref light_source_cache. */
+struct light_contribution {
+    // Bounding box of the lit squares
+    int min_x = 0;
+    int min_y = 0;
+    int width = 0;
+    int height = 0;
+    // width * height values, column by column like the lightmap
+    std::vector<float> light;
+};
+
+/**
+ * Light cast by the light sources applied from level_cache::light_source_buffer
+ * (fire, lava, lamps, vehicle lights...) during the last lightmap generation of a z-level.
+ * Most of them stay where they are and shine the same way for many turns, so they are only
+ * cast again when their luminance or the directions they shine in change, or when the
+ * transparency changed within their bounding box.
+ *
+ * Transparency changes are tracked per submap sized block, by comparing the transparency cache
+ * with the one of the previous lightmap generation.
+ */
+class light_source_cache
+{
+    public:
+        typedef float grid[MAPSIZE * SEEX][MAPSIZE * SEEY];
+        typedef std::function<void( grid & )> cast_function;
+
+        light_source_cache();
+
+        /**
+         * Call once per lightmap generation, before any @ref get.
+         * Finds the blocks whose transparency changed since the last call,
+         * everything is forgotten if the map was shifted.
+         */
+        void update( const grid &transparency, const tripoint &abs_sub );
+        /**
+         * Returns the light of the source at x, y. If it isn't cached or changed, it is cast
+         * into an all zero grid by cast, which must only depend on the arguments given here
+         * and on the transparency of the squares it lights.
+         */
+        const light_contribution &get( int x, int y, float luminance, unsigned char directions,
+                                       const cast_function &cast );
+        /** Forgets the sources that were not asked for since the last @ref update. */
+        void forget_unused();
+        void clear();
+        size_t size() const;
+
+        /** Raises every square of lm to at least the light of the contribution. */
+        static void apply( const light_contribution &contribution, grid &lm );
+
+    private:
+        struct source {
+            float luminance = 0.0f;
+            unsigned char directions = 0;
+            // Value of generation when it was cast, 0 if never
+            int generation = 0;
+            bool used = false;
+            light_contribution contribution;
+        };
+        bool is_current( const source &src ) const;
+
+        // Keyed by x * MAPSIZE * SEEY + y
+        std::unordered_map<int, source> sources;
+        // Copy of the transparency cache as of the last update, empty if there was none
+        std::vector<float> last_transparency;
+        // Sources are cast into this, then the lit part is copied out of it
+        std::vector<float> scratch;
+        tripoint last_abs_sub;
+        // Incremented by every update, blocks remember the last one they changed in
+        int generation;
+        int block_generation[MAPSIZE][MAPSIZE];
+};
+
+#endif
@@ -12,9 +12,12 @@
 #include "mtype.h"
 #include "weather.h"
 #include "shadowcasting.h"
+#include "thread_pool.h"
+#include "turn_profiler.h"
 
 #include <cmath>
 #include <cstring>
+#include <array>
 
 #define INBOUNDS(x, y) \
     (x >= 0 && x < SEEX * MAPSIZE && y >= 0 && y < SEEY * MAPSIZE)
@@ -23,6 +26,8 @@
 
 const efftype_id effect_onfire( "onfire" );
 
+static const option<int> option_fov_threads( "FOV_THREADS" );
+
 constexpr double PI     = 3.14159265358979323846;
 constexpr double HALFPI = 1.57079632679489661923;
 constexpr double SQRT_2 = 1.41421356237309504880;
@@ -126,6 +131,7 @@ void map::build_transparency_cache( const int zlev )
         }
     }
     map_cache.transparency_cache_dirty = false;
+    bump_transparency_generation( zlev );
 }
 
 void map::apply_character_light( const player &p )
@@ -388,9 +394,19 @@ void map::generate_lightmap( const int zlev )
     */
     const tripoint cache_start( 0, 0, zlev );
     const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
-    for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
-        if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
+    if( light_source_cache_enabled ) {
+        map_cache.light_sources.update( map_cache.transparency_cache, abs_sub );
+        for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
+            if( light_source_buffer[p.x][p.y] > 0.0 ) {
+                apply_cached_light_source( p, light_source_buffer[p.x][p.y] );
+            }
+        }
+        map_cache.light_sources.forget_unused();
+    } else {
+        for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
+            if( light_source_buffer[p.x][p.y] > 0.0 ) {
+                apply_light_source( p, light_source_buffer[p.x][p.y] );
+            }
         }
     }
 
@@ -404,6 +420,18 @@ void map::generate_lightmap( const int zlev )
     }
 }
 
+void map::clear_light_source_cache()
+{
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        get_cache( z ).light_sources.clear();
+    }
+}
+
+void map::set_light_source_cache_enabled( const bool enabled )
+{
+    light_source_cache_enabled = enabled;
+}
+
 void map::add_light_source( const tripoint &p, float luminance )
 {
     auto &light_source_buffer = get_cache( p.z ).light_source_buffer;
@@ -676,6 +704,25 @@ void cast_zlight(
     }
 }
 
+typedef void ( *cast_sight_func )( float ( & )[MAPSIZE * SEEX][MAPSIZE * SEEY],
+                                   const float ( & )[MAPSIZE * SEEX][MAPSIZE * SEEY],
+                                   int, int, int, float, int, float, float, double );
+
+// The 8 octants in order around the origin, starting with the one between west and north-west.
+// Neighbouring octants both write the cells on the line between them, the others share no cells,
+// so every other octant can be cast at the same time.
+static const std::array<cast_sight_func, 8> sight_octants = {{
+        &castLight<0, 1, 1, 0, sight_calc, sight_check>,
+        &castLight<1, 0, 0, 1, sight_calc, sight_check>,
+        &castLight<-1, 0, 0, 1, sight_calc, sight_check>,
+        &castLight<0, -1, 1, 0, sight_calc, sight_check>,
+        &castLight<0, -1, -1, 0, sight_calc, sight_check>,
+        &castLight<-1, 0, 0, -1, sight_calc, sight_check>,
+        &castLight<1, 0, 0, -1, sight_calc, sight_check>,
+        &castLight<0, 1, -1, 0, sight_calc, sight_check>,
+    }
+};
+
 /**
  * Calculates the Field Of View for the provided map from the given x, y
  * coordinates. Returns a lightmap for a result where the values represent a
@@ -695,31 +742,51 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
     float (&transparency_cache)[MAPSIZE*SEEX][MAPSIZE*SEEY] = map_cache.transparency_cache;
     float (&seen_cache)[MAPSIZE*SEEX][MAPSIZE*SEEY] = map_cache.seen_cache;
 
+    int part;
+    vehicle *veh = veh_at( origin, part );
+
+    // Waiting, crafting, sleeping etc. would compute the same thing every turn.
+    // Mirrors and cameras of the vehicle at the origin aren't covered, so those always recompute.
+    seen_cache_inputs inputs;
+    inputs.origin = origin;
+    inputs.target_z = target_z;
+    inputs.fov_3d = fov_3d;
+    if( !fov_3d ) {
+        inputs.generations[target_z + OVERMAP_DEPTH] = map_cache.transparency_generation;
+    } else {
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            inputs.generations[z + OVERMAP_DEPTH] = get_cache( z ).transparency_generation;
+        }
+    }
+    if( veh == nullptr && inputs == last_seen_cache_inputs ) {
+        return;
+    }
+    // A built transparency cache never has generation 0, so the default never matches
+    last_seen_cache_inputs = veh == nullptr ? inputs : seen_cache_inputs();
+
     std::uninitialized_fill_n(
         &seen_cache[0][0], MAPSIZE*SEEX * MAPSIZE*SEEY, LIGHT_TRANSPARENCY_SOLID);
 
     if( !fov_3d ) {
         seen_cache[origin.x][origin.y] = LIGHT_TRANSPARENCY_CLEAR;
 
-        castLight<0, 1, 1, 0, sight_calc, sight_check>(
-            seen_cache, transparency_cache, origin.x, origin.y, 0 );
-        castLight<1, 0, 0, 1, sight_calc, sight_check>(
-            seen_cache, transparency_cache, origin.x, origin.y, 0 );
-
-        castLight<0, -1, 1, 0, sight_calc, sight_check>(
-            seen_cache, transparency_cache, origin.x, origin.y, 0 );
-        castLight<-1, 0, 0, 1, sight_calc, sight_check>(
-            seen_cache, transparency_cache, origin.x, origin.y, 0 );
-
-        castLight<0, 1, -1, 0, sight_calc, sight_check>(
-            seen_cache, transparency_cache, origin.x, origin.y, 0 );
-        castLight<1, 0, 0, -1, sight_calc, sight_check>(
-            seen_cache, transparency_cache, origin.x, origin.y, 0 );
-
-        castLight<0, -1, -1, 0, sight_calc, sight_check>(
-            seen_cache, transparency_cache, origin.x, origin.y, 0 );
-        castLight<-1, 0, 0, -1, sight_calc, sight_check>(
-            seen_cache, transparency_cache, origin.x, origin.y, 0 );
+        const auto cast_octant = [&]( const size_t octant ) {
+            sight_octants[octant]( seen_cache, transparency_cache, origin.x, origin.y, 0,
+                                   1.0f, 1, 1.0f, 0.0f, LIGHT_TRANSPARENCY_OPEN_AIR );
+        };
+        const int threads = option_fov_threads;
+        if( threads <= 1 ) {
+            for( size_t octant = 0; octant < sight_octants.size(); octant++ ) {
+                cast_octant( octant );
+            }
+        } else {
+            thread_pool &pool = get_thread_pool( pool_purpose::field_of_view, threads - 1 );
+            for( const size_t first : { 0, 1 } ) {
+                pool.parallel_for( sight_octants.size() / 2, [&]( size_t i ) {
+                    cast_octant( first + 2 * i );
+                } );
+            }
+        }
     } else {
         if( origin.z == target_z ) {
             seen_cache[origin.x][origin.y] = LIGHT_TRANSPARENCY_CLEAR;
@@ -777,8 +844,6 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
             seen_caches, transparency_caches, floor_caches, origin, 0 );
     }
 
-    int part;
-    vehicle *veh = veh_at( origin, part );
     if( veh == nullptr ) {
         return;
     }
@@ -937,76 +1002,134 @@ static bool light_check( const float &transparency, const float &intensity ) {
     return transparency > LIGHT_TRANSPARENCY_SOLID && intensity > LIGHT_AMBIENT_LOW;
 }
 
-void map::apply_light_source( const tripoint &p, float luminance )
+// Directions a light source shines into, see light_source_directions
+enum light_direction : unsigned char {
+    LIGHT_NORTH = 1,
+    LIGHT_EAST = 2,
+    LIGHT_SOUTH = 4,
+    LIGHT_WEST = 8,
+};
+
+// Lights the square of a light source itself. Returns the luminance of the light
+// it casts onto other squares, or 0 if it doesn't.
+static float light_source_square( level_cache &cache, const tripoint &p, float luminance,
+                                  const bool in_bounds )
 {
-    auto &cache = get_cache( p.z );
     float (&lm)[MAPSIZE*SEEX][MAPSIZE*SEEY] = cache.lm;
     float (&sm)[MAPSIZE*SEEX][MAPSIZE*SEEY] = cache.sm;
-    float (&transparency_cache)[MAPSIZE*SEEX][MAPSIZE*SEEY] = cache.transparency_cache;
-    float (&light_source_buffer)[MAPSIZE*SEEX][MAPSIZE*SEEY] = cache.light_source_buffer;
-
     const int x = p.x;
     const int y = p.y;
 
-    if( inbounds( p ) ) {
+    if( in_bounds ) {
         lm[x][y] = std::max(lm[x][y], static_cast<float>(LL_LOW));
         lm[x][y] = std::max(lm[x][y], luminance);
         sm[x][y] = std::max(sm[x][y], luminance);
     }
     if ( luminance <= 1 ) {
-        return;
+        return 0.0f;
     } else if ( luminance <= 2 ) {
         luminance = 1.49f;
     } else if (luminance <= LIGHT_SOURCE_LOCAL) {
-        return;
+        return 0.0f;
     }
+    return luminance;
+}
 
-    /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
-         neighboring fires to the north and west that were applied via light_source_buffer
-       If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
-       If there's a 100 luminance magnesium flare south added via apply_light_source instead od
-         add_light_source, it's unbuffered so we'll still cast rays into sy.
-
-          ey
-        nnnNnnn
-        w     e
-        w  5 +e
-     sx W 5*1+E ex
-        w ++++e
-        w+++++e
-        sssSsss
-           sy
-    */
+/* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
+     neighboring fires to the north and west that were applied via light_source_buffer
+   If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
+   If there's a 100 luminance magnesium flare south added via apply_light_source instead od
+     add_light_source, it's unbuffered so we'll still cast rays into sy.
+
+      ey
+    nnnNnnn
+    w     e
+    w  5 +e
+ sx W 5*1+E ex
+    w ++++e
+    w+++++e
+    sssSsss
+       sy
+*/
+static unsigned char light_source_directions( const level_cache &cache, const int x, const int y,
+        const float luminance )
+{
+    const float (&light_source_buffer)[MAPSIZE*SEEX][MAPSIZE*SEEY] = cache.light_source_buffer;
     const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
-    bool north = (y != 0 && light_source_buffer[x][y - 1] < luminance );
-    bool south = (y != peer_inbounds && light_source_buffer[x][y + 1] < luminance );
-    bool east = (x != peer_inbounds && light_source_buffer[x + 1][y] < luminance );
-    bool west = (x != 0 && light_source_buffer[x - 1][y] < luminance );
+    unsigned char directions = 0;
+    if( y != 0 && light_source_buffer[x][y - 1] < luminance ) {
+        directions |= LIGHT_NORTH;
+    }
+    if( x != peer_inbounds && light_source_buffer[x + 1][y] < luminance ) {
+        directions |= LIGHT_EAST;
+    }
+    if( y != peer_inbounds && light_source_buffer[x][y + 1] < luminance ) {
+        directions |= LIGHT_SOUTH;
+    }
+    if( x != 0 && light_source_buffer[x - 1][y] < luminance ) {
+        directions |= LIGHT_WEST;
+    }
+    return directions;
+}
 
-    if( north ) {
+static void cast_light_source( float (&lm)[MAPSIZE*SEEX][MAPSIZE*SEEY],
+                               const float (&transparency_cache)[MAPSIZE*SEEX][MAPSIZE*SEEY],
+                               const int x, const int y, const float luminance,
+                               const unsigned char directions )
+{
+    PROFILE_COUNT( PROFILE_LIGHT_CASTS, 1 );
+    if( directions & LIGHT_NORTH ) {
         castLight<1, 0, 0, -1, light_calc, light_check>( lm, transparency_cache, x, y, 0, luminance );
         castLight<-1, 0, 0, -1, light_calc, light_check>( lm, transparency_cache, x, y, 0, luminance );
     }
 
-    if( east ) {
+    if( directions & LIGHT_EAST ) {
         castLight<0, -1, 1, 0, light_calc, light_check>( lm, transparency_cache, x, y, 0, luminance );
         castLight<0, -1, -1, 0, light_calc, light_check>( lm, transparency_cache, x, y, 0, luminance );
     }
 
 
-    if( south ) {
+    if( directions & LIGHT_SOUTH ) {
         castLight<1, 0, 0, 1, light_calc, light_check>( lm, transparency_cache, x, y, 0, luminance );
         castLight<-1, 0, 0, 1, light_calc, light_check>( lm, transparency_cache, x, y, 0, luminance );
     }
 
-    if( west ) {
+    if( directions & LIGHT_WEST ) {
         castLight<0, 1, 1, 0, light_calc, light_check>( lm, transparency_cache, x, y, 0, luminance );
         castLight<0, 1, -1, 0, light_calc, light_check>( lm, transparency_cache, x, y, 0, luminance );
     }
 }
 
+void map::apply_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    luminance = light_source_square( cache, p, luminance, inbounds( p ) );
+    if( luminance == 0.0f ) {
+        return;
+    }
+    cast_light_source( cache.lm, cache.transparency_cache, p.x, p.y, luminance,
+                       light_source_directions( cache, p.x, p.y, luminance ) );
+}
+
+void map::apply_cached_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    luminance = light_source_square( cache, p, luminance, inbounds( p ) );
+    if( luminance == 0.0f ) {
+        return;
+    }
+    const unsigned char directions = light_source_directions( cache, p.x, p.y, luminance );
+    const auto &transparency_cache = cache.transparency_cache;
+    const light_contribution &light = cache.light_sources.get( p.x, p.y, luminance, directions,
+    [&]( light_source_cache::grid & out ) {
+        cast_light_source( out, transparency_cache, p.x, p.y, luminance, directions );
+    } );
+    light_source_cache::apply( light, cache.lm );
+}
+
 void map::apply_directional_light( const tripoint &p, int direction, float luminance )
 {
+    PROFILE_COUNT( PROFILE_LIGHT_CASTS, 1 );
     const int x = p.x;
     const int y = p.y;
 
@@ -1109,6 +1232,7 @@ void map::calc_ray_end(int angle, int range, const tripoint &p, tripoint &out )
 void map::apply_light_ray(bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
                           const tripoint &s, const tripoint &e, float luminance)
 {
+    PROFILE_COUNT( PROFILE_LIGHT_CASTS, 1 );
     int ax = abs(e.x - s.x) * 2;
     int ay = abs(e.y - s.y) * 2;
     int dx = (s.x < e.x) ? 1 : -1;
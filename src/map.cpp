@@ -31,6 +31,7 @@
 #include "mtype.h"
 #include "weather.h"
 #include "item_group.h"
+#include "turn_profiler.h"
 
 #include <cmath>
 #include <stdlib.h>
@@ -237,6 +238,8 @@ void map::add_vehicle_to_cache( vehicle *veh )
 
     auto &ch = get_cache( veh->smz );
     ch.veh_in_active_range = true;
+    ch.pf_cache.dirty = true;
+    ch.sc_cache.dirty = true;
     // Get parts
     std::vector<vehicle_part> &parts = veh->parts;
     const tripoint gpos = veh->global_pos3();
@@ -264,6 +267,8 @@ void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
 
     // Existing must be cleared
     auto &ch = get_cache( old_zlevel );
+    ch.pf_cache.dirty = true;
+    ch.sc_cache.dirty = true;
     auto it = ch.veh_cached_parts.begin();
     const auto end = ch.veh_cached_parts.end();
     while( it != end ) {
@@ -286,6 +291,8 @@ void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
 void map::clear_vehicle_cache( const int zlev )
 {
     auto &ch = get_cache( zlev );
+    ch.pf_cache.dirty = true;
+    ch.sc_cache.dirty = true;
     while( !ch.veh_cached_parts.empty() ) {
         const auto part = ch.veh_cached_parts.begin();
         const auto &p = part->first;
@@ -337,6 +344,7 @@ void map::destroy_vehicle (vehicle *veh)
                 overmap_buffer.remove_vehicle( veh );
             }
             dirty_vehicle_list.erase(veh);
+            vehicle_schedule.invalidate();
             delete veh;
             return;
         }
@@ -348,10 +356,13 @@ void map::on_vehicle_moved( const int smz ) {
     set_outside_cache_dirty( smz );
     set_transparency_cache_dirty( smz );
     set_floor_cache_dirty( smz );
+    set_pathfinding_cache_dirty( smz );
+    set_scent_cache_dirty( smz );
 }
 
 void map::vehmove()
 {
+    PROFILE_SECTION( PROFILE_VEHICLES );
     // give vehicles movement points
     {
         VehicleList vehs = get_vehicles();
@@ -361,6 +372,7 @@ void map::vehmove()
             veh->slow_leak();
         }
     }
+    vehicle_schedule.invalidate();
 
     // 15 equals 3 >50mph vehicles, or up to 15 slow (1 square move) ones
     // But 15 is too low for V12 deathbikes, let's put 100 here
@@ -369,6 +381,8 @@ void map::vehmove()
             break;
         }
     }
+    // Vehicles may be destroyed before the next turn
+    vehicle_schedule.invalidate();
     // Process item removal on the vehicles that were modified this turn.
     for( const auto &elem : dirty_vehicle_list ) {
         ( elem )->part_removal_cleanup();
@@ -378,42 +392,38 @@ void map::vehmove()
 
 bool map::vehproceed()
 {
-    VehicleList vehs = get_vehicles();
-    vehicle* cur_veh = nullptr;
-    float max_of_turn = 0;
-    tripoint pt;
-    // First horizontal movement
-    for( auto &vehs_v : vehs ) {
-        if( vehs_v.v->of_turn > max_of_turn ) {
-            cur_veh = vehs_v.v;
-            pt = tripoint( vehs_v.x, vehs_v.y, vehs_v.z );
-            max_of_turn = cur_veh->of_turn;
+    // The vehicles are only collected again when they changed, not for each step
+    if( !vehicle_schedule.is_valid() ) {
+        std::vector<vehicle *> vehicles;
+        for( auto &vehs_v : get_vehicles() ) {
+            vehicles.push_back( vehs_v.v );
         }
+        vehicle_schedule.reset( vehicles );
     }
 
-    // Then vertical-only movement
+    // First horizontal movement, then vertical-only movement
+    vehicle *cur_veh = vehicle_schedule.next();
     if( cur_veh == nullptr ) {
-        for( auto &vehs_v : vehs ) {
-            vehicle &cveh = *vehs_v.v;
-            if( cveh.falling ) {
-                cur_veh = vehs_v.v;
-                pt = tripoint( vehs_v.x, vehs_v.y, vehs_v.z );
-                break;
-            }
-        }
+        return false;
     }
 
-    if( cur_veh == nullptr ) {
-        return false;
+    vehicle_step( *cur_veh );
+    // Unless it was destroyed or left the map
+    if( vehicle_schedule.is_valid() ) {
+        vehicle_schedule.update( cur_veh );
     }
+    return true;
+}
 
-    vehicle &veh = *cur_veh;
+void map::vehicle_step( vehicle &veh )
+{
+    const tripoint pt = veh.global_pos3();
     if( !inbounds( pt ) ) {
         dbg( D_INFO ) << "stopping out-of-map vehicle. (x,y,z)=(" << pt.x << "," << pt.y << "," << pt.z << ")";
         veh.stop();
         veh.of_turn = 0;
         veh.falling = false;
-        return true;
+        return;
     }
 
     // It needs to fall when it has no support OR was falling before
@@ -465,7 +475,7 @@ bool map::vehproceed()
 
     if( !should_fall && abs( veh.velocity ) < 20 ) {
         veh.of_turn -= .321f;
-        return true;
+        return;
     }
 
     const float traction = vehicle_traction( veh );
@@ -482,7 +492,7 @@ bool map::vehproceed()
         on_vehicle_moved( veh.smz );
         // Destroy vehicle (sank to nowhere)
         destroy_vehicle( &veh );
-        return true;
+        return;
     } else if( traction < 0.001f ) {
         veh.of_turn = 0;
         if( !should_fall ) {
@@ -510,7 +520,7 @@ bool map::vehproceed()
         if( !should_fall ) {
             veh.of_turn_carry = veh.of_turn;
             veh.of_turn = 0;
-            return true;
+            return;
         }
 
         falling_only = true;
@@ -574,8 +584,6 @@ bool map::vehproceed()
     if( dp.z != 0 ) {
         move_vehicle( veh, tripoint( 0, 0, dp.z ), mdir );
     }
-
-    return true;
 }
 
 bool map::vehicle_falling( vehicle &veh )
@@ -1024,6 +1032,7 @@ float map::vehicle_vehicle_collision( vehicle &veh, vehicle &veh2,
 
         veh.of_turn = avg_of_turn * .9;
         veh2.of_turn = avg_of_turn * 1.1;
+        vehicle_schedule.update( &veh2 );
 
         //Energy after collision
         float E_a = 0.5 * m1 * final1.norm() * final1.norm() +
@@ -1603,6 +1612,9 @@ void map::furn_set( const tripoint &p, const furn_id new_furniture )
     const furn_t &old_t = old_id.obj();
     const furn_t &new_t = new_furniture.obj();
 
+    set_pathfinding_cache_dirty( p.z );
+    set_scent_cache_dirty( p.z );
+
     if( old_t.transparent != new_t.transparent ) {
         set_transparency_cache_dirty( p.z );
     }
@@ -1800,6 +1812,9 @@ void map::ter_set( const tripoint &p, const ter_id new_terrain )
     const ter_t &old_t = old_id.obj();
     const ter_t &new_t = new_terrain.obj();
 
+    set_pathfinding_cache_dirty( p.z );
+    set_scent_cache_dirty( p.z );
+
     // Hack around ledges in traplocs or else it gets NASTY in z-level mode
     if( old_t.trap != tr_null && old_t.trap != tr_ledge ) {
         auto &traps = traplocs[old_t.trap];
@@ -2357,6 +2372,7 @@ void map::drop_vehicle( const tripoint &p )
     }
 
     veh->falling = true;
+    vehicle_schedule.update( veh );
 }
 
 void map::support_dirty( const tripoint &p )
@@ -4812,6 +4828,7 @@ static void process_vehicle_items( vehicle *cur_veh, int part )
 
 void map::process_active_items()
 {
+    PROFILE_SECTION( PROFILE_ACTIVE_ITEMS );
     process_items( true, process_map_items, std::string {} );
 }
 
@@ -5394,6 +5411,8 @@ void map::add_trap( const tripoint &p, const trap_id t)
     if( t != tr_null ) {
         traplocs[t].push_back( p );
     }
+
+    set_pathfinding_cache_dirty( p.z );
 }
 
 void map::disarm_trap( const tripoint &p )
@@ -5466,6 +5485,8 @@ void map::remove_trap( const tripoint &p )
         if( iter != traps.end() ) {
             traps.erase( iter );
         }
+
+        set_pathfinding_cache_dirty( p.z );
     }
 }
 /*
@@ -5589,6 +5610,7 @@ bool map::add_field(const tripoint &p, const field_id t, int density, const int
     if( current_submap->fld[lx][ly].addField( t, density, age ) ) {
         //Only adding it to the count if it doesn't exist.
         current_submap->field_count++;
+        current_submap->mark_field_tile( lx, ly );
     }
 
     if( g != nullptr && this == &g->m && p == g->u.pos() ) {
@@ -6439,6 +6461,7 @@ void map::load(const int wx, const int wy, const int wz, const bool update_vehic
         traps.clear();
     }
     set_abs_sub( wx, wy, wz );
+    vehicle_schedule.invalidate();
     for (int gridx = 0; gridx < my_MAPSIZE; gridx++) {
         for (int gridy = 0; gridy < my_MAPSIZE; gridy++) {
             loadn( gridx, gridy, update_vehicle );
@@ -6472,6 +6495,8 @@ void map::shift( const int sx, const int sy )
     if( sx == 0 && sy == 0 ) {
         return; // Skip this?
     }
+    // Vehicles move out of the map
+    vehicle_schedule.invalidate();
     const int absx = get_abs_sub().x;
     const int absy = get_abs_sub().y;
     const int wz = get_abs_sub().z;
@@ -6680,12 +6705,31 @@ static void generate_uniform( const int x, const int y, const int z, const oter_
     }
 }
 
-void map::loadn( const int gridx, const int gridy, const int gridz, const bool update_vehicles )
+void map::generate_quad( const tripoint &abs_sub_pos )
 {
     // Cache empty overmap types
     static const oter_id rock("empty_rock");
     static const oter_id air("open_air");
 
+    // Each overmap square is two nonants; to prevent overlap, generate only at
+    //  squares divisible by 2.
+    const int newmapx = abs_sub_pos.x - ( abs( abs_sub_pos.x ) % 2 );
+    const int newmapy = abs_sub_pos.y - ( abs( abs_sub_pos.y ) % 2 );
+    // Short-circuit if the map tile is uniform
+    int overx = newmapx;
+    int overy = newmapy;
+    sm_to_omt( overx, overy );
+    oter_id terrain_type = overmap_buffer.ter( overx, overy, abs_sub_pos.z );
+    if( terrain_type == rock || terrain_type == air ) {
+        generate_uniform( newmapx, newmapy, abs_sub_pos.z, terrain_type );
+    } else {
+        tinymap tmp_map;
+        tmp_map.generate( newmapx, newmapy, abs_sub_pos.z, calendar::turn );
+    }
+}
+
+void map::loadn( const int gridx, const int gridy, const int gridz, const bool update_vehicles )
+{
     dbg(D_INFO) << "map::loadn(game[" << g << "], worldx[" << abs_sub.x << "], worldy[" << abs_sub.y << "], gridx["
                 << gridx << "], gridy[" << gridy << "], gridz[" << gridz << "])";
 
@@ -6703,22 +6747,7 @@ void map::loadn( const int gridx, const int gridy, const int gridz, const bool u
     if( tmpsub == nullptr ) {
         // It doesn't exist; we must generate it!
         dbg( D_INFO | D_WARNING ) << "map::loadn: Missing mapbuffer data. Regenerating.";
-
-        // Each overmap square is two nonants; to prevent overlap, generate only at
-        //  squares divisible by 2.
-        const int newmapx = absx - ( abs( absx ) % 2 );
-        const int newmapy = absy - ( abs( absy ) % 2 );
-        // Short-circuit if the map tile is uniform
-        int overx = newmapx;
-        int overy = newmapy;
-        sm_to_omt( overx, overy );
-        oter_id terrain_type = overmap_buffer.ter( overx, overy, gridz );
-        if( terrain_type == rock || terrain_type == air ) {
-            generate_uniform( newmapx, newmapy, gridz, terrain_type );
-        } else {
-            tinymap tmp_map;
-            tmp_map.generate( newmapx, newmapy, gridz, calendar::turn );
-        }
+        generate_quad( tripoint( absx, absy, gridz ) );
 
         // This is the same call to MAPBUFFER as above!
         tmpsub = MAPBUFFER.lookup_submap( absx, absy, gridz );
@@ -6733,6 +6762,8 @@ void map::loadn( const int gridx, const int gridy, const int gridz, const bool u
     set_transparency_cache_dirty( gridz );
     set_outside_cache_dirty( gridz );
     set_floor_cache_dirty( gridz );
+    set_pathfinding_cache_dirty( gridz );
+    set_scent_cache_dirty( gridz );
     setsubmap( gridn, tmpsub );
 
     for( auto it : tmpsub->vehicles ) {
@@ -7392,6 +7423,13 @@ void map::build_floor_cache( const int zlev )
     }
 
     ch.floor_cache_dirty = false;
+    // Floors block vision between z-levels
+    bump_transparency_generation( zlev );
+}
+
+void map::bump_transparency_generation( const int zlev )
+{
+    get_cache( zlev ).transparency_generation = ++last_transparency_generation;
 }
 
 void map::build_floor_caches()
@@ -7405,6 +7443,7 @@ void map::build_floor_caches()
 
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
+    PROFILE_SECTION( PROFILE_MAP_CACHE );
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     for( int z = minz; z <= maxz; z++ ) {
@@ -7435,13 +7474,17 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
 
             if( v.v->part_flag(part, VPFLAG_OPAQUE) && v.v->parts[part].hp > 0 ) {
                 int dpart = v.v->part_with_feature( part, VPFLAG_OPENABLE );
-                if (dpart < 0 || !v.v->parts[dpart].open) {
+                if( ( dpart < 0 || !v.v->parts[dpart].open ) &&
+                    transparency_cache[px][py] != LIGHT_TRANSPARENCY_SOLID ) {
                     transparency_cache[px][py] = LIGHT_TRANSPARENCY_SOLID;
+                    bump_transparency_generation( v.z );
                 }
             }
 
-            if( v.v->part_flag( part, VPFLAG_BOARDABLE ) && v.v->parts[part].hp > 0 ) {
+            if( v.v->part_flag( part, VPFLAG_BOARDABLE ) && v.v->parts[part].hp > 0 &&
+                !floor_cache[px][py] ) {
                 floor_cache[px][py] = true;
+                bump_transparency_generation( v.z );
             }
         }
     }
@@ -7703,6 +7746,8 @@ void map::draw_fill_background( ter_id type )
     // Need to explicitly set caches dirty - set_ter would do it before
     set_transparency_cache_dirty( abs_sub.z );
     set_outside_cache_dirty( abs_sub.z );
+    set_pathfinding_cache_dirty( abs_sub.z );
+    set_scent_cache_dirty( abs_sub.z );
 
     // Fill each submap rather than each tile
     constexpr size_t block_size = SEEX * SEEY;
@@ -7936,45 +7981,54 @@ template<typename Functor>
     }
 }
 
-void map::scent_blockers( bool (&blocks_scent)[SEEX * MAPSIZE][SEEY * MAPSIZE],
-                          bool (&reduces_scent)[SEEX * MAPSIZE][SEEY * MAPSIZE],
-                          const int minx, const int miny, const int maxx, const int maxy )
+const scent_cache &map::get_scent_cache_ref( const int zlev )
+{
+    auto &cache = get_cache( zlev ).sc_cache;
+    if( cache.dirty ) {
+        update_scent_cache( zlev );
+    }
+
+    return cache;
+}
+
+void map::update_scent_cache( const int zlev )
 {
+    auto &cache = get_cache( zlev ).sc_cache;
+    std::fill_n( &cache.weight[0][0], SEEX * MAPSIZE * SEEY * MAPSIZE, SCENT_NORMAL );
+
     auto reduce = TFLAG_REDUCE_SCENT;
     auto block = TFLAG_WALL;
     auto fill_values = [&]( const tripoint &gp, const submap *sm, const point &lp ) {
+        // We need to generate the x/y coords, because we can't get them "for free"
+        const int x = ( gp.x * SEEX ) + lp.x;
+        const int y = ( gp.y * SEEY ) + lp.y;
         if( sm->get_ter( lp.x, lp.y ).obj().has_flag( block ) ) {
-            // We need to generate the x/y coords, because we can't get them "for free"
-            const int x = ( gp.x * SEEX ) + lp.x;
-            const int y = ( gp.y * SEEY ) + lp.y;
-            blocks_scent[x][y] = true;
+            cache.weight[x][y] = SCENT_BLOCKED;
         } else if( sm->get_ter( lp.x, lp.y ).obj().has_flag( reduce ) || sm->get_furn( lp.x, lp.y ).obj().has_flag( reduce ) ) {
-            const int x = ( gp.x * SEEX ) + lp.x;
-            const int y = ( gp.y * SEEY ) + lp.y;
-            reduces_scent[x][y] = true;
+            cache.weight[x][y] = SCENT_REDUCED;
         }
 
         return ITER_CONTINUE;
     };
 
-    function_over( minx, miny, abs_sub.z, maxx, maxy, abs_sub.z, fill_values );
+    const int maxx = SEEX * my_MAPSIZE - 1;
+    const int maxy = SEEY * my_MAPSIZE - 1;
+    function_over( 0, 0, zlev, maxx, maxy, zlev, fill_values );
 
     // Now vehicles
-
-    // Currently the scentmap is limited to an area around the player rather than entire map
-    auto local_bounds = [=]( const point &coord ) {
-        return coord.x >= minx && coord.x <= maxx && coord.y >= miny && coord.y <= maxy;
+    auto reduce_at = [&]( const point &part_pos ) {
+        if( part_pos.x >= 0 && part_pos.x <= maxx && part_pos.y >= 0 && part_pos.y <= maxy &&
+            cache.weight[part_pos.x][part_pos.y] == SCENT_NORMAL ) {
+            cache.weight[part_pos.x][part_pos.y] = SCENT_REDUCED;
+        }
     };
 
-    auto vehs = get_vehicles();
+    auto vehs = get_vehicles( tripoint( 0, 0, zlev ), tripoint( maxx, maxy, zlev ) );
     for( auto &wrapped_veh : vehs ) {
         vehicle &veh = *(wrapped_veh.v);
         auto obstacles = veh.all_parts_with_feature( VPFLAG_OBSTACLE, true );
         for( const int p : obstacles ) {
-            const point part_pos = veh.global_pos() + veh.parts[p].precalc[0];
-            if( local_bounds( part_pos ) ) {
-                reduces_scent[part_pos.x][part_pos.y] = true;
-            }
+            reduce_at( veh.global_pos() + veh.parts[p].precalc[0] );
         }
 
         // Doors, but only the closed ones
@@ -7984,12 +8038,11 @@ void map::scent_blockers( bool (&blocks_scent)[SEEX * MAPSIZE][SEEY * MAPSIZE],
                 continue;
             }
 
-            const point part_pos = veh.global_pos() + veh.parts[p].precalc[0];
-            if( local_bounds( part_pos ) ) {
-                reduces_scent[part_pos.x][part_pos.y] = true;
-            }
+            reduce_at( veh.global_pos() + veh.parts[p].precalc[0] );
         }
     }
+
+    cache.dirty = false;
 }
 
 tripoint_range map::points_in_rectangle( const tripoint &from, const tripoint &to ) const
@@ -8038,6 +8091,7 @@ level_cache::level_cache()
 {
     transparency_cache_dirty = true;
     outside_cache_dirty = true;
+    transparency_generation = 0;
     veh_in_active_range = false;
     std::fill_n( &veh_exists_at[0][0], SEEX * MAPSIZE * SEEY * MAPSIZE, false );
 }
@@ -6,10 +6,15 @@
 #include <set>
 #include <map>
 #include <memory>
+#include <array>
 
 #include "game_constants.h"
 #include "item.h"
 #include "lightmap.h"
+#include "pathfinding.h"
+#include "scent_map.h"
+#include "light_source_cache.h"
+#include "vehicle_scheduler.h"
 #include "item_stack.h"
 #include "active_item_cache.h"
 #include "int_id.h"
@@ -144,6 +149,8 @@ struct level_cache {
     bool transparency_cache_dirty;
     bool outside_cache_dirty;
     bool floor_cache_dirty;
+    // Changes whenever transparency_cache or floor_cache change, see map::build_seen_cache
+    int transparency_generation;
 
     float lm[MAPSIZE*SEEX][MAPSIZE*SEEY];
     float sm[MAPSIZE*SEEX][MAPSIZE*SEEY];
@@ -156,6 +163,10 @@ struct level_cache {
     float seen_cache[MAPSIZE*SEEX][MAPSIZE*SEEY];
     lit_level visibility_cache[MAPSIZE*SEEX][MAPSIZE*SEEY];
 
+    pathfinding_cache pf_cache;
+    scent_cache sc_cache;
+    light_source_cache light_sources;
+
     bool veh_in_active_range;
     bool veh_exists_at[SEEX * MAPSIZE][SEEY * MAPSIZE];
     std::map< tripoint, std::pair<vehicle*,int> > veh_cached_parts;
@@ -224,6 +235,18 @@ class map
             get_cache( zlev ).floor_cache_dirty = true;
         }
     }
+
+    void set_pathfinding_cache_dirty( const int zlev ) {
+        if( inbounds_z( zlev ) ) {
+            get_cache( zlev ).pf_cache.dirty = true;
+        }
+    }
+
+    void set_scent_cache_dirty( const int zlev ) {
+        if( inbounds_z( zlev ) ) {
+            get_cache( zlev ).sc_cache.dirty = true;
+        }
+    }
     /*@}*/
 
 
@@ -442,6 +465,12 @@ public:
  std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                               const int bash, const int maxdist ) const;
 
+    /**
+     * Returns the pathfinding cache of given z-level, rebuilding it first if it's dirty.
+     * The z-level must be valid.
+     */
+    const pathfinding_cache &get_pathfinding_cache_ref( int zlev ) const;
+
  int coord_to_angle(const int x, const int y, const int tgtx, const int tgty) const;
 // Vehicles: Common to 2D and 3D
     VehicleList get_vehicles();
@@ -455,6 +484,8 @@ public:
     void destroy_vehicle (vehicle *veh);
     void vehmove();          // Vehicle movement
     bool vehproceed(); // Returns true if a vehicle moved, false otherwise
+    /** Moves the vehicle a step, called by @ref vehproceed. */
+    void vehicle_step( vehicle &veh );
 
 // 3D vehicles
     VehicleList get_vehicles( const tripoint &start, const tripoint &end );
@@ -971,12 +1002,10 @@ void add_corpse( const tripoint &p );
 
 // Scent propagation helpers
     /**
-     * Build the map of scent-resistant tiles.
-     * Should be way faster than if done in `game.cpp` using public map functions.
+     * Returns the scent weights of given z-level, rebuilding them first if they are dirty.
+     * The z-level must be valid.
      */
-    void scent_blockers( bool (&blocks_scent)[SEEX * MAPSIZE][SEEY * MAPSIZE],
-                         bool (&reduces_scent)[SEEX * MAPSIZE][SEEY * MAPSIZE],
-                         int minx, int miny, int maxx, int maxy );
+    const scent_cache &get_scent_cache_ref( int zlev );
 
 // Computers
     computer* computer_at( const tripoint &p );
@@ -1031,6 +1060,12 @@ public:
      */
     void process_falling();
 
+    /**
+     * Generates the quad (2x2 submaps, one overmap terrain) that contains the given absolute
+     * submap and adds it to @ref MAPBUFFER. The submap must not be in there yet.
+     */
+    static void generate_quad( const tripoint &abs_sub_pos );
+
 // mapgen.cpp functions
  void generate(const int x, const int y, const int z, const int turn);
  void post_process(unsigned zones);
@@ -1054,6 +1089,13 @@ public:
 
     // Note: in 3D mode, will actually build caches on ALL zlevels
     void build_map_cache( int zlev, bool skip_lightmap = false );
+    /** Makes the next lightmap generation cast the light of every light source again. */
+    void clear_light_source_cache();
+    /**
+     * Whether the lightmap generation reuses the light cast by unchanged light sources,
+     * or casts all of them straight into the lightmap. Only turned off to compare with.
+     */
+    void set_light_source_cache_enabled( bool enabled );
 
     vehicle *add_vehicle( const vgroup_id &type, const tripoint &p, const int dir,
                           const int init_veh_fuel = -1, const int init_veh_status = -1,
@@ -1086,6 +1128,8 @@ public:
          */
         bool pl_line_of_sight( const tripoint &t, int max_range ) const;
     std::set<vehicle*> dirty_vehicle_list;
+    /** The vehicles moved by @ref vehproceed, invalidated whenever the set of vehicles changes. */
+    vehicle_scheduler vehicle_schedule;
 
     /** return @ref abs_sub */
     tripoint get_abs_sub() const;
@@ -1210,12 +1254,33 @@ public:
     // We want this visible in `game`, because we want it built earlier in the turn than the rest
     void build_floor_caches();
 protected:
+ void update_pathfinding_cache( int zlev ) const;
+ void update_scent_cache( int zlev );
  void generate_lightmap( int zlev );
  void build_seen_cache( const tripoint &origin, int target_z );
  void apply_character_light( const player &p );
 
  int my_MAPSIZE;
  bool zlevels;
+ bool light_source_cache_enabled = true;
+
+    /** What the seen caches were last built from, so unchanged ones are not rebuilt. */
+    struct seen_cache_inputs {
+        tripoint origin;
+        int target_z = 0;
+        bool fov_3d = false;
+        // level_cache::transparency_generation of every z-level involved, 0 for the others
+        std::array<int, OVERMAP_LAYERS> generations = {{}};
+
+        bool operator==( const seen_cache_inputs &rhs ) const {
+            return origin == rhs.origin && target_z == rhs.target_z && fov_3d == rhs.fov_3d &&
+                   generations == rhs.generations;
+        }
+    };
+    seen_cache_inputs last_seen_cache_inputs;
+    /** Source of level_cache::transparency_generation, so that a value is never reused. */
+    int last_transparency_generation = 0;
+    void bump_transparency_generation( int zlev );
 
     /**
      * Absolute coordinates of first submap (get_submap_at(0,0))
@@ -1312,6 +1377,8 @@ private:
  // ...this, which will apply the light after at the end of generate_lightmap, and prevent redundant
  // light rays from causing massive slowdowns, if there's a huge amount of light.
  void add_light_source( const tripoint &p, float luminance);
+ // Applies light added by add_light_source, reusing what the last generate_lightmap cast if possible
+ void apply_cached_light_source( const tripoint &p, float luminance );
  // Handle just cardinal directions and 45 deg angles.
  void apply_directional_light( const tripoint &p, int direction, float luminance );
  void apply_light_arc( const tripoint &p, int angle, float luminance, int wideangle = 30 );
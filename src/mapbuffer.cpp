@@ -13,13 +13,155 @@
 #include "map.h"
 #include "trap.h"
 #include "vehicle.h"
+#include "active_vehicle_registry.h"
 #include "submap.h"
+#include "options.h"
 
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 
 #define dbg(x) DebugLog((DebugLevel)(x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
+static const std::string json_quad_extension = ".map";
+static const std::string binary_quad_extension = ".bmap";
+// Binary quad files start with this, followed by binary_quad_version and savegame_version
+static const char binary_quad_magic[4] = { 'C', 'D', 'Q', 'B' };
+static const uint32_t binary_quad_version = 1;
+
+namespace {
+
+/** Writes little endian integers and length prefixed strings, independent of the platform. */
+class binary_out
+{
+    public:
+        binary_out( std::ostream &out ) : out( out ) { }
+
+        void u8( const uint8_t value ) {
+            out.put( char( value ) );
+        }
+        void u16( const uint16_t value ) {
+            u8( value & 0xff );
+            u8( value >> 8 );
+        }
+        void u32( const uint32_t value ) {
+            u16( value & 0xffff );
+            u16( value >> 16 );
+        }
+        void i32( const int32_t value ) {
+            u32( uint32_t( value ) );
+        }
+        void str( const std::string &value ) {
+            u32( value.size() );
+            out.write( value.data(), value.size() );
+        }
+
+    private:
+        std::ostream &out;
+};
+
+/** Reads what @ref binary_out wrote, throws if the data ends early. */
+class binary_in
+{
+    public:
+        binary_in( std::istream &in ) : in( in ) { }
+
+        uint8_t u8() {
+            const int value = in.get();
+            if( value == std::char_traits<char>::eof() ) {
+                throw std::runtime_error( "binary map file is truncated" );
+            }
+            return uint8_t( value );
+        }
+        uint16_t u16() {
+            const uint16_t low = u8();
+            return low | ( uint16_t( u8() ) << 8 );
+        }
+        uint32_t u32() {
+            const uint32_t low = u16();
+            return low | ( uint32_t( u16() ) << 16 );
+        }
+        int32_t i32() {
+            return int32_t( u32() );
+        }
+        std::string str() {
+            std::string value( u32(), '\0' );
+            in.read( &value[0], value.size() );
+            if( !in ) {
+                throw std::runtime_error( "binary map file is truncated" );
+            }
+            return value;
+        }
+
+    private:
+        std::istream &in;
+};
+
+/** Strings of a binary quad file, each is stored once and referred to by its index. */
+class string_table
+{
+    public:
+        int intern( const std::string &str ) {
+            const auto iter = index.find( str );
+            if( iter != index.end() ) {
+                return iter->second;
+            }
+            strings.push_back( str );
+            index[str] = strings.size() - 1;
+            return strings.size() - 1;
+        }
+
+        std::vector<std::string> strings;
+
+    private:
+        std::unordered_map<std::string, int> index;
+};
+
+/**
+ * Writes a value for every tile of a submap as (value, count) runs, row by row.
+ * Most submaps are a handful of terrain types, so this is a lot shorter than one value per tile.
+ */
+template<typename Func>
+void write_runs( binary_out &out, Func value_at )
+{
+    int run_value = value_at( 0, 0 );
+    int run_length = 0;
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            const int value = value_at( i, j );
+            if( value != run_value ) {
+                out.i32( run_value );
+                out.u16( run_length );
+                run_value = value;
+                run_length = 0;
+            }
+            run_length++;
+        }
+    }
+    out.i32( run_value );
+    out.u16( run_length );
+}
+
+template<typename Func>
+void read_runs( binary_in &in, Func set_value )
+{
+    int tile = 0;
+    while( tile < SEEX * SEEY ) {
+        const int value = in.i32();
+        const int length = in.u16();
+        if( length == 0 || tile + length > SEEX * SEEY ) {
+            throw std::runtime_error( "bad run length in binary map file" );
+        }
+        for( const int end = tile + length; tile < end; tile++ ) {
+            set_value( tile % SEEX, tile / SEEX, value );
+        }
+    }
+}
+
+}
+
+// Defined before MAPBUFFER, so it still exists when the vehicles in MAPBUFFER get deleted
+active_vehicle_registry active_vehicles;
 mapbuffer MAPBUFFER;
 
 mapbuffer::mapbuffer()
@@ -37,6 +179,8 @@ void mapbuffer::reset()
         delete elem.second;
     }
     submaps.clear();
+    quads_by_use.clear();
+    quad_use.clear();
 }
 
 bool mapbuffer::add_submap(const tripoint &p, submap *sm)
@@ -46,6 +190,7 @@ bool mapbuffer::add_submap(const tripoint &p, submap *sm)
     }
 
     submaps[p] = sm;
+    touch_quad( p );
 
     return true;
 }
@@ -76,6 +221,100 @@ void mapbuffer::remove_submap( tripoint addr )
     }
     delete m_target->second;
     submaps.erase( m_target );
+
+    const auto use = quad_use.find( sm_to_omt_copy( addr ) );
+    if( use != quad_use.end() ) {
+        quads_by_use.erase( use->second );
+        quad_use.erase( use );
+    }
+}
+
+void mapbuffer::touch_quad( const tripoint &submap_addr )
+{
+    const tripoint om_addr = sm_to_omt_copy( submap_addr );
+    const auto use = quad_use.find( om_addr );
+    if( use == quad_use.end() ) {
+        quads_by_use.push_front( om_addr );
+        quad_use[om_addr] = quads_by_use.begin();
+    } else if( use->second != quads_by_use.begin() ) {
+        quads_by_use.splice( quads_by_use.begin(), quads_by_use, use->second );
+    }
+}
+
+size_t mapbuffer::quad_count() const
+{
+    return quads_by_use.size();
+}
+
+std::pair<std::string, std::string> mapbuffer::quad_path( const tripoint &om_addr ) const
+{
+    // A segment is a chunk of 32x32 submap quads.
+    // We're breaking them into subdirectories so there aren't too many files per directory.
+    const tripoint segment_addr = omt_to_seg_copy( om_addr );
+    std::stringstream dirname;
+    dirname << world_generator->active_world->world_path << "/maps/" << segment_addr.x << "." <<
+            segment_addr.y << "." << segment_addr.z;
+
+    std::stringstream filename;
+    filename << dirname.str() << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z;
+    return std::make_pair( dirname.str(), filename.str() );
+}
+
+void mapbuffer::unload_unused()
+{
+    const int limit_mb = OPTIONS["MAP_MEMORY_LIMIT"];
+    if( limit_mb <= 0 ) {
+        return;
+    }
+    // Only counts the submaps themselves, not the items, vehicles etc. on them
+    const size_t max_quads = std::max<size_t>( 1, size_t( limit_mb ) * 1024 * 1024 /
+                                               ( 4 * sizeof( submap ) ) );
+    if( quads_by_use.size() <= max_quads ) {
+        return;
+    }
+
+    // Quads touching the reality bubble, on any z-level
+    const tripoint bubble_min = sm_to_omt_copy( g->m.get_abs_sub() );
+    const tripoint bubble_max = sm_to_omt_copy( g->m.get_abs_sub() +
+                                tripoint( MAPSIZE - 1, MAPSIZE - 1, 0 ) );
+    const auto keep = [&]( const tripoint &om_addr ) {
+        if( om_addr.x >= bubble_min.x && om_addr.x <= bubble_max.x &&
+            om_addr.y >= bubble_min.y && om_addr.y <= bubble_max.y ) {
+            return true;
+        }
+        const tripoint sm_addr = omt_to_sm_copy( om_addr );
+        for( int x = 0; x < 2; x++ ) {
+            for( int y = 0; y < 2; y++ ) {
+                const auto iter = submaps.find( sm_addr + tripoint( x, y, 0 ) );
+                if( iter == submaps.end() ) {
+                    continue;
+                }
+                for( vehicle *veh : iter->second->vehicles ) {
+                    if( active_vehicles.has( veh ) ) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    };
+
+    assure_dir_exist( ( world_generator->active_world->world_path + "/maps" ).c_str() );
+    std::list<tripoint> submaps_to_delete;
+    size_t remaining = quads_by_use.size();
+    for( auto it = quads_by_use.rbegin(); it != quads_by_use.rend() && remaining > max_quads; ++it ) {
+        if( keep( *it ) ) {
+            continue;
+        }
+        const auto path = quad_path( *it );
+        save_quad( path.first, path.second, *it, submaps_to_delete, true );
+        remaining--;
+    }
+    for( auto &elem : submaps_to_delete ) {
+        remove_submap( elem );
+    }
+    dbg( D_INFO ) << "mapbuffer::unload_unused: " << quads_by_use.size() << " quads left, limit " <<
+                  max_quads;
 }
 
 submap *mapbuffer::lookup_submap(int x, int y, int z)
@@ -97,6 +336,7 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
         return NULL;
     }
 
+    touch_quad( p );
     return iter->second;
 }
 
@@ -131,22 +371,12 @@ void mapbuffer::save( bool delete_after_save )
         }
         saved_submaps.insert( om_addr );
 
-        // A segment is a chunk of 32x32 submap quads.
-        // We're breaking them into subdirectories so there aren't too many files per directory.
-        // Might want to make a set for this one too so it's only checked once per save().
-        std::stringstream dirname;
-        tripoint segment_addr = omt_to_seg_copy( om_addr );
-        dirname << map_directory.str() << "/" << segment_addr.x << "." <<
-                     segment_addr.y << "." << segment_addr.z;
-
-        std::stringstream quad_path;
-        quad_path << dirname.str() << "/" << om_addr.x << "." <<
-                  om_addr.y << "." << om_addr.z << ".map";
+        const auto path = quad_path( om_addr );
 
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
         const bool zlev_del = !map_has_zlevels && om_addr.z != g->get_levz();
-        save_quad( dirname.str(), quad_path.str(), om_addr, submaps_to_delete,
+        save_quad( path.first, path.second, om_addr, submaps_to_delete,
                    delete_after_save || zlev_del ||
                    om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
                    om_addr.x > map_origin.x + (MAPSIZE / 2) ||
@@ -158,8 +388,8 @@ void mapbuffer::save( bool delete_after_save )
     }
 }
 
-void mapbuffer::save_quad( const std::string &dirname, const std::string &filename, 
-                           const tripoint &om_addr, std::list<tripoint> &submaps_to_delete, 
+void mapbuffer::save_quad( const std::string &dirname, const std::string &base_path,
+                           const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                            bool delete_after_save )
 {
     std::vector<point> offsets;
@@ -175,8 +405,9 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         submap_addr.x += offsets_offset.x;
         submap_addr.y += offsets_offset.y;
         submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr];
-        if( sm != nullptr && !sm->is_uniform ) {
+        // Don't use operator[], inserting could invalidate the iterators of save()
+        const auto iter = submaps.find( submap_addr );
+        if( iter != submaps.end() && iter->second != nullptr && !iter->second->is_uniform ) {
             all_uniform = false;
         }
     }
@@ -185,7 +416,8 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         // Nothing to save - this quad will be regenerated faster than it would be re-read
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
-                if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
+                const auto iter = submaps.find( submap_addr );
+                if( iter != submaps.end() && iter->second != nullptr ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -194,25 +426,59 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         return;
     }
 
+    quad_submaps quad;
+    for( auto &submap_addr : submap_addrs ) {
+        const auto iter = submaps.find( submap_addr );
+        if( iter != submaps.end() && iter->second != nullptr ) {
+            quad.emplace_back( submap_addr, iter->second );
+        }
+    }
+
     // Don't create the directory if it would be empty
     assure_dir_exist( dirname.c_str() );
+    if( !write_quad( base_path, quad, OPTIONS["MAP_SAVE_FORMAT"] == "binary" ) ) {
+        return;
+    }
+
+    if( delete_after_save ) {
+        for( auto &elem : quad ) {
+            submaps_to_delete.push_back( elem.first );
+        }
+    }
+}
+
+bool mapbuffer::write_quad( const std::string &base_path, const quad_submaps &quad,
+                            const bool binary )
+{
+    const std::string filename = base_path + ( binary ? binary_quad_extension : json_quad_extension );
     std::ofstream fout;
-    fopen_exclusive( fout, filename.c_str() );
+    fopen_exclusive( fout, filename.c_str(), std::ios_base::out | std::ios_base::binary );
     if( !fout.is_open() ) {
-        return;
+        return false;
+    }
+
+    if( binary ) {
+        serialize_quad_binary( fout, quad );
+    } else {
+        serialize_quad_json( fout, quad );
     }
+    fclose_exclusive( fout, filename.c_str() );
+
+    // A file of the other format would be outdated now
+    const std::string other = base_path + ( binary ? json_quad_extension : binary_quad_extension );
+    if( file_exist( other ) ) {
+        remove_file( other );
+    }
+    return true;
+}
 
+void mapbuffer::serialize_quad_json( std::ostream &fout, const quad_submaps &quad )
+{
     JsonOut jsout( fout );
     jsout.start_array();
-    for( auto &submap_addr : submap_addrs ) {
-        if( submaps.count( submap_addr ) == 0 ) {
-            continue;
-        }
-
-        submap *sm = submaps[submap_addr];
-        if( sm == nullptr ) {
-            continue;
-        }
+    for( auto &elem : quad ) {
+        const tripoint &submap_addr = elem.first;
+        submap *sm = elem.second;
 
         jsout.start_object();
 
@@ -279,20 +545,6 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         }
         jsout.end_array();
 
-        jsout.member( "items" );
-        jsout.start_array();
-        for(int j = 0; j < SEEY; j++) {
-            for(int i = 0; i < SEEX; i++) {
-                if( sm->itm[i][j].empty() ) {
-                    continue;
-                }
-                jsout.write( i );
-                jsout.write( j );
-                jsout.write( sm->itm[i][j] );
-            }
-        }
-        jsout.end_array();
-
         jsout.member( "traps" );
         jsout.start_array();
         for(int j = 0; j < SEEY; j++) {
@@ -332,65 +584,179 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         }
         jsout.end_array();
 
-        jsout.member("cosmetics");
-        jsout.start_array();
-        for (int j = 0; j < SEEY; j++) {
-            for (int i = 0; i < SEEX; i++) {
-                if (sm->cosmetics[i][j].size() > 0) {
-                    jsout.start_array();
-                    jsout.write(i);
-                    jsout.write(j);
-                    jsout.write(sm->cosmetics[i][j]);
-                    jsout.end_array();
-                }
+        serialize_submap_objects( jsout, sm );
+        jsout.end_object();
+    }
+
+    jsout.end_array();
+}
+
+void mapbuffer::serialize_submap_objects( JsonOut &jsout, submap *sm )
+{
+    jsout.member( "items" );
+    jsout.start_array();
+    for(int j = 0; j < SEEY; j++) {
+        for(int i = 0; i < SEEX; i++) {
+            if( sm->itm[i][j].empty() ) {
+                continue;
             }
+            jsout.write( i );
+            jsout.write( j );
+            jsout.write( sm->itm[i][j] );
         }
-        jsout.end_array();
+    }
+    jsout.end_array();
 
-        // Output the spawn points
-        jsout.member( "spawns" );
-        jsout.start_array();
-        for( auto &elem : sm->spawns ) {
-            jsout.start_array();
-            jsout.write( elem.type.str() ); // TODO: json should know how to write string_ids
-            jsout.write( elem.count );
-            jsout.write( elem.posx );
-            jsout.write( elem.posy );
-            jsout.write( elem.faction_id );
-            jsout.write( elem.mission_id );
-            jsout.write( elem.friendly );
-            jsout.write( elem.name );
-            jsout.end_array();
+    jsout.member("cosmetics");
+    jsout.start_array();
+    for (int j = 0; j < SEEY; j++) {
+        for (int i = 0; i < SEEX; i++) {
+            if (sm->cosmetics[i][j].size() > 0) {
+                jsout.start_array();
+                jsout.write(i);
+                jsout.write(j);
+                jsout.write(sm->cosmetics[i][j]);
+                jsout.end_array();
+            }
         }
-        jsout.end_array();
+    }
+    jsout.end_array();
 
-        jsout.member( "vehicles" );
+    // Output the spawn points
+    jsout.member( "spawns" );
+    jsout.start_array();
+    for( auto &elem : sm->spawns ) {
         jsout.start_array();
-        for( auto &elem : sm->vehicles ) {
-            // json lib doesn't know how to turn a vehicle * into a vehicle,
-            // so we have to iterate manually.
-            jsout.write( *elem );
-        }
+        jsout.write( elem.type.str() ); // TODO: json should know how to write string_ids
+        jsout.write( elem.count );
+        jsout.write( elem.posx );
+        jsout.write( elem.posy );
+        jsout.write( elem.faction_id );
+        jsout.write( elem.mission_id );
+        jsout.write( elem.friendly );
+        jsout.write( elem.name );
         jsout.end_array();
+    }
+    jsout.end_array();
 
-        // Output the computer
-        if (sm->comp.name != "") {
-            jsout.member( "computers", sm->comp.save_data() );
-        }
+    jsout.member( "vehicles" );
+    jsout.start_array();
+    for( auto &elem : sm->vehicles ) {
+        // json lib doesn't know how to turn a vehicle * into a vehicle,
+        // so we have to iterate manually.
+        jsout.write( *elem );
+    }
+    jsout.end_array();
+
+    // Output the computer
+    if (sm->comp.name != "") {
+        jsout.member( "computers", sm->comp.save_data() );
+    }
+
+    // Output base camp if any
+    if (sm->camp.is_valid()) {
+        jsout.member( "camp" );
+        jsout.write( sm->camp.save_data() );
+    }
+}
+
+void mapbuffer::serialize_quad_binary( std::ostream &fout, const quad_submaps &quad )
+{
+    // The submaps go first, because the string table is only complete afterwards
+    string_table strings;
+    std::ostringstream body_buffer;
+    binary_out body( body_buffer );
+    body.u32( quad.size() );
+    for( auto &elem : quad ) {
+        const tripoint &submap_addr = elem.first;
+        submap *sm = elem.second;
+        body.i32( submap_addr.x );
+        body.i32( submap_addr.y );
+        body.i32( submap_addr.z );
+        body.i32( sm->turn_last_touched );
+        body.i32( sm->temperature );
+
+        write_runs( body, [&]( const int i, const int j ) {
+            return strings.intern( sm->ter[i][j].obj().id );
+        } );
+        write_runs( body, [&]( const int i, const int j ) {
+            return strings.intern( sm->get_furn( i, j ).obj().id );
+        } );
+        write_runs( body, [&]( const int i, const int j ) {
+            return strings.intern( sm->get_trap( i, j ).id().str() );
+        } );
+        write_runs( body, [&]( const int i, const int j ) {
+            return sm->get_radiation( i, j );
+        } );
 
-        // Output base camp if any
-        if (sm->camp.is_valid()) {
-            jsout.member( "camp" );
-            jsout.write( sm->camp.save_data() );
+        std::vector<point> field_tiles;
+        for( int j = 0; j < SEEY; j++ ) {
+            for( int i = 0; i < SEEX; i++ ) {
+                if( sm->fld[i][j].fieldCount() > 0 ) {
+                    field_tiles.emplace_back( i, j );
+                }
+            }
         }
-        if( delete_after_save ) {
-            submaps_to_delete.push_back( submap_addr );
+        body.u32( field_tiles.size() );
+        for( auto &pt : field_tiles ) {
+            const field &fld = sm->fld[pt.x][pt.y];
+            body.u8( pt.x );
+            body.u8( pt.y );
+            body.u32( fld.fieldCount() );
+            for( auto &entry : fld ) {
+                body.i32( entry.second.getFieldType() );
+                body.i32( entry.second.getFieldDensity() );
+                body.i32( entry.second.getFieldAge() );
+            }
         }
+
+        // Items, vehicles and such are rare and complicated, they stay JSON
+        std::ostringstream objects;
+        JsonOut jsout( objects );
+        jsout.start_object();
+        serialize_submap_objects( jsout, sm );
         jsout.end_object();
+        body.str( objects.str() );
     }
 
-    jsout.end_array();
-    fclose_exclusive( fout, filename.c_str() );
+    binary_out out( fout );
+    fout.write( binary_quad_magic, sizeof( binary_quad_magic ) );
+    out.u32( binary_quad_version );
+    out.i32( savegame_version );
+    out.u32( strings.strings.size() );
+    for( auto &str : strings.strings ) {
+        out.str( str );
+    }
+    const std::string body_data = body_buffer.str();
+    fout.write( body_data.data(), body_data.size() );
+}
+
+int mapbuffer::convert_saved_quads()
+{
+    const bool binary = OPTIONS["MAP_SAVE_FORMAT"] == "binary";
+    const std::string &from = binary ? json_quad_extension : binary_quad_extension;
+    const std::string map_directory = world_generator->active_world->world_path + "/maps";
+
+    int converted = 0;
+    for( const std::string &path : get_files_from_path( from, map_directory, true, true ) ) {
+        const std::string base_path = path.substr( 0, path.size() - from.size() );
+        try {
+            loaded_submaps loaded;
+            if( !read_quad( base_path, loaded ) ) {
+                continue;
+            }
+            quad_submaps quad;
+            for( auto &elem : loaded ) {
+                quad.emplace_back( elem.first, elem.second.get() );
+            }
+            if( write_quad( base_path, quad, binary ) ) {
+                converted++;
+            }
+        } catch( const std::exception &err ) {
+            debugmsg( "Failed to convert %s: %s", path.c_str(), err.what() );
+        }
+    }
+    return converted;
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -399,19 +765,46 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
 {
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
-    const tripoint segment_addr = omt_to_seg_copy( om_addr );
-    std::stringstream quad_path;
-    quad_path << world_generator->active_world->world_path << "/maps/" <<
-              segment_addr.x << "." << segment_addr.y << "." << segment_addr.z << "/" <<
-              om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
+    const std::string base_path = quad_path( om_addr ).second;
 
-    std::ifstream fin( quad_path.str().c_str() );
-    if( !fin.is_open() ) {
+    loaded_submaps loaded;
+    if( !read_quad( base_path, loaded ) ) {
         // If it doesn't exist, trigger generating it.
         return NULL;
     }
 
-    JsonIn jsin( fin );
+    for( auto &elem : loaded ) {
+        if( !add_submap( elem.first, elem.second ) ) {
+            debugmsg( "submap %d,%d,%d was already loaded", elem.first.x, elem.first.y, elem.first.z );
+        }
+    }
+    const auto iter = submaps.find( p );
+    if( iter == submaps.end() ) {
+        debugmsg("file %s did not contain the expected submap %d,%d,%d", base_path.c_str(), p.x, p.y,
+                 p.z);
+        return NULL;
+    }
+    return iter->second;
+}
+
+bool mapbuffer::read_quad( const std::string &base_path, loaded_submaps &loaded )
+{
+    std::ifstream bin( ( base_path + binary_quad_extension ).c_str(), std::ios_base::binary );
+    if( bin.is_open() ) {
+        unserialize_quad_binary( bin, loaded );
+        return true;
+    }
+    const mapped_file json( base_path + json_quad_extension );
+    if( json.is_open() ) {
+        JsonIn jsin( json.data(), json.size() );
+        unserialize_quad_json( jsin, loaded );
+        return true;
+    }
+    return false;
+}
+
+void mapbuffer::unserialize_quad_json( JsonIn &jsin, loaded_submaps &loaded )
+{
     jsin.start_array();
     while( !jsin.end_array() ) {
         std::unique_ptr<submap> sm(new submap());
@@ -431,189 +824,273 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
                 int locz = jsin.get_int();
                 jsin.end_array();
                 submap_coordinates = tripoint( locx, locy, locz );
-            } else if( submap_member_name == "turn_last_touched" ) {
-                sm->turn_last_touched = jsin.get_int();
-            } else if( submap_member_name == "temperature" ) {
-                sm->temperature = jsin.get_int();
-            } else if( submap_member_name == "terrain" ) {
-                // TODO: try block around this to error out if we come up short?
-                jsin.start_array();
-                // Small duplication here so that the update check is only performed once
-                if (rubpow_update) {
-                    std::string ter_string;
-                    item rock = item("rock", 0);
-                    item chunk = item("steel_chunk", 0);
-                    for( int j = 0; j < SEEY; j++ ) {
-                        for( int i = 0; i < SEEX; i++ ) {
-                            ter_string = jsin.get_string();
-                            if (ter_string == "t_rubble") {
-                                sm->ter[i][j] = termap[ "t_dirt" ].loadid;
-                                sm->frn[i][j] = furnmap[ "f_rubble" ].loadid;
-                                sm->itm[i][j].push_back( rock );
-                                sm->itm[i][j].push_back( rock );
-                            } else if (ter_string == "t_wreckage"){
-                                sm->ter[i][j] = termap[ "t_dirt" ].loadid;
-                                sm->frn[i][j] = furnmap[ "f_wreckage" ].loadid;
-                                sm->itm[i][j].push_back( chunk );
-                                sm->itm[i][j].push_back( chunk );
-                            } else if (ter_string == "t_ash"){
-                                sm->ter[i][j] = termap[ "t_dirt" ].loadid;
-                                sm->frn[i][j] = furnmap[ "f_ash" ].loadid;
-                            } else if (ter_string == "t_pwr_sb_support_l"){
-                                sm->ter[i][j] = termap[ "t_support_l" ].loadid;
-                            } else if (ter_string == "t_pwr_sb_switchgear_l"){
-                                sm->ter[i][j] = termap[ "t_switchgear_l" ].loadid;
-                            } else if (ter_string == "t_pwr_sb_switchgear_s"){
-                                sm->ter[i][j] = termap[ "t_switchgear_s" ].loadid;
-                            } else {
-                                sm->ter[i][j] = terfind( ter_string );
-                            }
-                        }
-                    }
-                } else {
-                    for( int j = 0; j < SEEY; j++ ) {
-                        for( int i = 0; i < SEEX; i++ ) {
-                            sm->ter[i][j] = terfind( jsin.get_string() );
-                        }
-                    }
-                }
-                jsin.end_array();
-            } else if( submap_member_name == "radiation" ) {
-                int rad_cell = 0;
-                jsin.start_array();
-                while( !jsin.end_array() ) {
-                    int rad_strength = jsin.get_int();
-                    int rad_num = jsin.get_int();
-                    for( int i = 0; i < rad_num; ++i ) {
-                        // A little array trick here, assign to it as a 1D array.
-                        // If it's not in bounds we're kinda hosed anyway.
-                        sm->set_radiation(0, rad_cell, rad_strength);
-                        rad_cell++;
+            } else {
+                unserialize_submap_member( jsin, sm.get(), submap_member_name, rubpow_update );
+            }
+        }
+        loaded.emplace_back( submap_coordinates, std::move( sm ) );
+    }
+}
+
+void mapbuffer::unserialize_submap_member( JsonIn &jsin, submap *sm, const std::string &name,
+                                           const bool rubpow_update )
+{
+if( name == "turn_last_touched" ) {
+        sm->turn_last_touched = jsin.get_int();
+    } else if( name == "temperature" ) {
+        sm->temperature = jsin.get_int();
+    } else if( name == "terrain" ) {
+        // TODO: try block around this to error out if we come up short?
+        jsin.start_array();
+        // Small duplication here so that the update check is only performed once
+        if (rubpow_update) {
+            std::string ter_string;
+            item rock = item("rock", 0);
+            item chunk = item("steel_chunk", 0);
+            for( int j = 0; j < SEEY; j++ ) {
+                for( int i = 0; i < SEEX; i++ ) {
+                    ter_string = jsin.get_string();
+                    if (ter_string == "t_rubble") {
+                        sm->ter[i][j] = termap[ "t_dirt" ].loadid;
+                        sm->frn[i][j] = furnmap[ "f_rubble" ].loadid;
+                        sm->itm[i][j].push_back( rock );
+                        sm->itm[i][j].push_back( rock );
+                    } else if (ter_string == "t_wreckage"){
+                        sm->ter[i][j] = termap[ "t_dirt" ].loadid;
+                        sm->frn[i][j] = furnmap[ "f_wreckage" ].loadid;
+                        sm->itm[i][j].push_back( chunk );
+                        sm->itm[i][j].push_back( chunk );
+                    } else if (ter_string == "t_ash"){
+                        sm->ter[i][j] = termap[ "t_dirt" ].loadid;
+                        sm->frn[i][j] = furnmap[ "f_ash" ].loadid;
+                    } else if (ter_string == "t_pwr_sb_support_l"){
+                        sm->ter[i][j] = termap[ "t_support_l" ].loadid;
+                    } else if (ter_string == "t_pwr_sb_switchgear_l"){
+                        sm->ter[i][j] = termap[ "t_switchgear_l" ].loadid;
+                    } else if (ter_string == "t_pwr_sb_switchgear_s"){
+                        sm->ter[i][j] = termap[ "t_switchgear_s" ].loadid;
+                    } else {
+                        sm->ter[i][j] = terfind( ter_string );
                     }
                 }
-            } else if( submap_member_name == "furniture" ) {
-                jsin.start_array();
-                while( !jsin.end_array() ) {
-                    jsin.start_array();
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    sm->frn[i][j] = furnmap[ jsin.get_string() ].loadid;
-                    jsin.end_array();
-                }
-            } else if( submap_member_name == "items" ) {
-                jsin.start_array();
-                while( !jsin.end_array() ) {
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    jsin.start_array();
-                    while( !jsin.end_array() ) {
-                        item tmp;
-                        jsin.read( tmp );
-
-                        if( tmp.is_emissive() ) {
-                            sm->update_lum_add(tmp, i, j);
-                        }
-
-                        tmp.visit_items( [ &sm, i, j ]( item *it ) {
-                            for( auto& e: it->magazine_convert() ) {
-                                sm->itm[i][j].push_back( e );
-                            }
-                            return VisitResponse::NEXT;
-                        } );
-
-                        sm->itm[i][j].push_back( tmp );
-                        if( tmp.needs_processing() ) {
-                            sm->active_items.add( std::prev(sm->itm[i][j].end()), point( i, j ) );
-                        }
-                    }
+            }
+        } else {
+            for( int j = 0; j < SEEY; j++ ) {
+                for( int i = 0; i < SEEX; i++ ) {
+                    sm->ter[i][j] = terfind( jsin.get_string() );
                 }
-            } else if( submap_member_name == "traps" ) {
-                jsin.start_array();
-                while( !jsin.end_array() ) {
-                    jsin.start_array();
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    // TODO: jsin should support returning an id like jsin.get_id<trap>()
-                    sm->trp[i][j] = trap_str_id( jsin.get_string() );
-                    jsin.end_array();
+            }
+        }
+        jsin.end_array();
+    } else if( name == "radiation" ) {
+        int rad_cell = 0;
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            int rad_strength = jsin.get_int();
+            int rad_num = jsin.get_int();
+            for( int i = 0; i < rad_num && rad_cell < SEEX * SEEY; ++i ) {
+                // Same order as written, row by row
+                sm->set_radiation( rad_cell % SEEX, rad_cell / SEEX, rad_strength );
+                rad_cell++;
+            }
+        }
+    } else if( name == "furniture" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.start_array();
+            int i = jsin.get_int();
+            int j = jsin.get_int();
+            sm->frn[i][j] = furnmap[ jsin.get_string() ].loadid;
+            jsin.end_array();
+        }
+    } else if( name == "items" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            int i = jsin.get_int();
+            int j = jsin.get_int();
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                item tmp;
+                jsin.read( tmp );
+
+                if( tmp.is_emissive() ) {
+                    sm->update_lum_add(tmp, i, j);
                 }
-            } else if( submap_member_name == "fields" ) {
-                jsin.start_array();
-                while( !jsin.end_array() ) {
-                    // Coordinates loop
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    jsin.start_array();
-                    while( !jsin.end_array() ) {
-                        int type = jsin.get_int();
-                        int density = jsin.get_int();
-                        int age = jsin.get_int();
-                        if (sm->fld[i][j].findField(field_id(type)) == NULL) {
-                            sm->field_count++;
-                        }
-                        sm->fld[i][j].addField(field_id(type), density, age);
+
+                tmp.visit_items( [ &sm, i, j ]( item *it ) {
+                    for( auto& e: it->magazine_convert() ) {
+                        sm->itm[i][j].push_back( e );
                     }
+                    return VisitResponse::NEXT;
+                } );
+
+                sm->itm[i][j].push_back( tmp );
+                if( tmp.needs_processing() ) {
+                    sm->active_items.add( std::prev(sm->itm[i][j].end()), point( i, j ) );
                 }
-            } else if( submap_member_name == "graffiti" ) {
-                jsin.start_array();
-                while( !jsin.end_array() ) {
-                    jsin.start_array();
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    sm->set_graffiti( i, j, jsin.get_string() );
-                    jsin.end_array();
-                }
-            } else if(submap_member_name == "cosmetics") {
-                jsin.start_array();
-                while (!jsin.end_array()) {
-                    jsin.start_array();
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    jsin.read(sm->cosmetics[i][j]);
-                    jsin.end_array();
-                }
-            } else if( submap_member_name == "spawns" ) {
-                jsin.start_array();
-                while( !jsin.end_array() ) {
-                    jsin.start_array();
-                    const mtype_id type = mtype_id( jsin.get_string() ); // TODO: json should know how to read an string_id
-                    int count = jsin.get_int();
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    int faction_id = jsin.get_int();
-                    int mission_id = jsin.get_int();
-                    bool friendly = jsin.get_bool();
-                    std::string name = jsin.get_string();
-                    jsin.end_array();
-                    spawn_point tmp( type, count, i, j, faction_id, mission_id, friendly, name );
-                    sm->spawns.push_back( tmp );
-                }
-            } else if( submap_member_name == "vehicles" ) {
-                jsin.start_array();
-                while( !jsin.end_array() ) {
-                    vehicle *tmp = new vehicle();
-                    jsin.read( *tmp );
-                    sm->vehicles.push_back( tmp );
+            }
+        }
+    } else if( name == "traps" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.start_array();
+            int i = jsin.get_int();
+            int j = jsin.get_int();
+            // TODO: jsin should support returning an id like jsin.get_id<trap>()
+            sm->trp[i][j] = trap_str_id( jsin.get_string() );
+            jsin.end_array();
+        }
+    } else if( name == "fields" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            // Coordinates loop
+            int i = jsin.get_int();
+            int j = jsin.get_int();
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                int type = jsin.get_int();
+                int density = jsin.get_int();
+                int age = jsin.get_int();
+                if (sm->fld[i][j].findField(field_id(type)) == NULL) {
+                    sm->field_count++;
+                    sm->mark_field_tile( i, j );
                 }
-            } else if( submap_member_name == "computers" ) {
-                std::string computer_data = jsin.get_string();
-                sm->comp.load_data( computer_data );
-            } else if( submap_member_name == "camp" ) {
-                std::string camp_data = jsin.get_string();
-                sm->camp.load_data( camp_data );
-            } else {
-                jsin.skip_value();
+                sm->fld[i][j].addField(field_id(type), density, age);
             }
         }
-        if( !add_submap( submap_coordinates, sm ) ) {
-            debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
-                      submap_coordinates.z );
+    } else if( name == "graffiti" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.start_array();
+            int i = jsin.get_int();
+            int j = jsin.get_int();
+            sm->set_graffiti( i, j, jsin.get_string() );
+            jsin.end_array();
+        }
+    } else if(name == "cosmetics") {
+        jsin.start_array();
+        while (!jsin.end_array()) {
+            jsin.start_array();
+            int i = jsin.get_int();
+            int j = jsin.get_int();
+            jsin.read(sm->cosmetics[i][j]);
+            jsin.end_array();
+        }
+    } else if( name == "spawns" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.start_array();
+            const mtype_id type = mtype_id( jsin.get_string() ); // TODO: json should know how to read an string_id
+            int count = jsin.get_int();
+            int i = jsin.get_int();
+            int j = jsin.get_int();
+            int faction_id = jsin.get_int();
+            int mission_id = jsin.get_int();
+            bool friendly = jsin.get_bool();
+            std::string name = jsin.get_string();
+            jsin.end_array();
+            spawn_point tmp( type, count, i, j, faction_id, mission_id, friendly, name );
+            sm->spawns.push_back( tmp );
+        }
+    } else if( name == "vehicles" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            vehicle *tmp = new vehicle();
+            jsin.read( *tmp );
+            sm->vehicles.push_back( tmp );
+            if( tmp->has_active_systems() ) {
+                active_vehicles.add( tmp );
+            }
         }
+    } else if( name == "computers" ) {
+        std::string computer_data = jsin.get_string();
+        sm->comp.load_data( computer_data );
+    } else if( name == "camp" ) {
+        std::string camp_data = jsin.get_string();
+        sm->camp.load_data( camp_data );
+    } else {
+        jsin.skip_value();
     }
-    if( submaps.count( p ) == 0 ) {
-        debugmsg("file %s did not contain the expected submap %d,%d,%d", quad_path.str().c_str(), p.x, p.y,
-                 p.z);
-        return NULL;
+}
+
+void mapbuffer::unserialize_quad_binary( std::istream &fin, loaded_submaps &loaded )
+{
+    char magic[sizeof( binary_quad_magic )];
+    fin.read( magic, sizeof( magic ) );
+    if( !fin || !std::equal( magic, magic + sizeof( magic ), binary_quad_magic ) ) {
+        throw std::runtime_error( "not a binary map file" );
+    }
+    binary_in in( fin );
+    const uint32_t version = in.u32();
+    if( version != binary_quad_version ) {
+        throw std::runtime_error( string_format( "unknown binary map version %d", int( version ) ) );
+    }
+    // The savegame version, for when the content needs to be migrated
+    in.i32();
+
+    std::vector<std::string> strings( in.u32() );
+    for( auto &str : strings ) {
+        str = in.str();
+    }
+    const auto string_at = [&strings]( const uint32_t index ) -> const std::string & {
+        if( index >= strings.size() )
+        {
+            throw std::runtime_error( "string index out of range" );
+        }
+        return strings[index];
+    };
+
+    const uint32_t count = in.u32();
+    for( uint32_t n = 0; n < count; n++ ) {
+        std::unique_ptr<submap> sm( new submap() );
+        tripoint submap_coordinates;
+        submap_coordinates.x = in.i32();
+        submap_coordinates.y = in.i32();
+        submap_coordinates.z = in.i32();
+        sm->turn_last_touched = in.i32();
+        sm->temperature = in.i32();
+
+        read_runs( in, [&]( const int i, const int j, const int value ) {
+            sm->ter[i][j] = terfind( string_at( value ) );
+        } );
+        read_runs( in, [&]( const int i, const int j, const int value ) {
+            sm->frn[i][j] = furnmap[ string_at( value ) ].loadid;
+        } );
+        read_runs( in, [&]( const int i, const int j, const int value ) {
+            sm->trp[i][j] = trap_str_id( string_at( value ) );
+        } );
+        read_runs( in, [&]( const int i, const int j, const int value ) {
+            sm->set_radiation( i, j, value );
+        } );
+
+        const uint32_t field_tiles = in.u32();
+        for( uint32_t t = 0; t < field_tiles; t++ ) {
+            const int i = in.u8();
+            const int j = in.u8();
+            if( i >= SEEX || j >= SEEY ) {
+                throw std::runtime_error( "field position out of range" );
+            }
+            const uint32_t entries = in.u32();
+            for( uint32_t e = 0; e < entries; e++ ) {
+                const int type = in.i32();
+                const int density = in.i32();
+                const int age = in.i32();
+                if( sm->fld[i][j].findField( field_id( type ) ) == NULL ) {
+                    sm->field_count++;
+                    sm->mark_field_tile( i, j );
+                }
+                sm->fld[i][j].addField( field_id( type ), density, age );
+            }
+        }
+
+        const std::string objects = in.str();
+        JsonIn jsin( objects.data(), objects.size() );
+        jsin.start_object();
+        while( !jsin.end_object() ) {
+            const std::string name = jsin.get_member_name();
+            unserialize_submap_member( jsin, sm.get(), name, false );
+        }
+
+        loaded.emplace_back( submap_coordinates, std::move( sm ) );
     }
-    return submaps[ p ];
 }
@@ -1,14 +1,18 @@
 #ifndef MAPBUFFER_H
 #define MAPBUFFER_H
 
-#include <map>
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
+#include <iosfwd>
 #include "enums.h"
 struct point;
 struct tripoint;
 struct submap;
+class JsonIn;
+class JsonOut;
 
 /**
  * Store, buffer, save and load the entire world map.
@@ -57,8 +61,28 @@ class mapbuffer
         submap *lookup_submap( int x, int y, int z );
         submap *lookup_submap( const tripoint &p );
 
+        /**
+         * Saves and unloads the least recently used quads until the buffer fits into
+         * the MAP_MEMORY_LIMIT option. Quads overlapping the reality bubble and quads
+         * with running vehicles are kept. Unloaded quads are loaded again by
+         * @ref lookup_submap when needed.
+         * Submap pointers held by maps other than `g->m` may become invalid,
+         * so only call this when no such maps exist.
+         */
+        void unload_unused();
+
+        /** Number of quads (2x2 submaps, one overmap terrain) in this buffer. **/
+        size_t quad_count() const;
+
+        /**
+         * Converts the saved map files of the active world to the format
+         * selected by the MAP_SAVE_FORMAT option.
+         * @return The number of converted files.
+         */
+        int convert_saved_quads();
+
     private:
-        typedef std::map<tripoint, submap *> submap_map_t;
+        typedef std::unordered_map<tripoint, submap *> submap_map_t;
 
     public:
         inline submap_map_t::iterator begin() {
@@ -73,10 +97,34 @@ class mapbuffer
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
         submap *unserialize_submaps( const tripoint &p );
-        void save_quad( const std::string &dirname, const std::string &filename,
+        void save_quad( const std::string &dirname, const std::string &base_path,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
+
+        // Quads are saved either as JSON (.map files) or in a binary format (.bmap files).
+        // When loading, whichever of the two exists is used.
+        typedef std::vector<std::pair<tripoint, submap *>> quad_submaps;
+        typedef std::vector<std::pair<tripoint, std::unique_ptr<submap>>> loaded_submaps;
+        /** Writes the quad to base_path plus the extension of the format, removes the other one. */
+        static bool write_quad( const std::string &base_path, const quad_submaps &quad, bool binary );
+        /** Returns false if there is no file of either format. */
+        static bool read_quad( const std::string &base_path, loaded_submaps &loaded );
+        static void serialize_quad_json( std::ostream &fout, const quad_submaps &quad );
+        static void serialize_quad_binary( std::ostream &fout, const quad_submaps &quad );
+        /** Items, vehicles and other things that both formats store as JSON. */
+        static void serialize_submap_objects( JsonOut &jsout, submap *sm );
+        static void unserialize_quad_json( JsonIn &jsin, loaded_submaps &loaded );
+        static void unserialize_quad_binary( std::istream &fin, loaded_submaps &loaded );
+        static void unserialize_submap_member( JsonIn &jsin, submap *sm, const std::string &name,
+                                               bool rubpow_update );
+        /** Directory and file path without extension of the quad of given overmap terrain coordinates. */
+        std::pair<std::string, std::string> quad_path( const tripoint &om_addr ) const;
+        /** Marks the quad containing the submap as the most recently used one. */
+        void touch_quad( const tripoint &submap_addr );
         submap_map_t submaps;
+        // Overmap terrain coordinates of the quads in the buffer, most recently used first
+        std::list<tripoint> quads_by_use;
+        std::unordered_map<tripoint, std::list<tripoint>::iterator> quad_use;
 };
 
 extern mapbuffer MAPBUFFER;
@@ -12,6 +12,7 @@
 #include "mapgen_functions.h"
 #include "mapgenformat.h"
 #include "mapbuffer.h"
+#include "active_vehicle_registry.h"
 #include "overmapbuffer.h"
 #include "enums.h"
 #include "monstergenerator.h"
@@ -43,6 +44,13 @@
 
 #define MON_RADIUS 3
 
+// Read for each submap generated, or each item placed
+static const world_option<bool> option_classic_zombies( "CLASSIC_ZOMBIES" );
+static const world_option<float> option_item_spawnrate( "ITEM_SPAWNRATE" );
+static const world_option<float> option_spawn_density( "SPAWN_DENSITY" );
+static const world_option<bool> option_static_npc( "STATIC_NPC" );
+static const world_option<bool> option_static_spawn( "STATIC_SPAWN" );
+
 const mtype_id mon_biollante( "mon_biollante" );
 const mtype_id mon_blank( "mon_blank" );
 const mtype_id mon_blob( "mon_blob" );
@@ -861,7 +869,7 @@ class jmapgen_loot : public jmapgen_piece {
         }
         void apply( map &m, const jmapgen_int &x, const jmapgen_int &y, const float /*mon_density*/ ) const override
         {
-            if( rng( 0, 99 ) < chance.get() * ACTIVE_WORLD_OPTIONS[ "ITEM_SPAWNRATE" ] ) {
+            if( rng( 0, 99 ) < chance.get() * option_item_spawnrate ) {
                 std::vector<item> spawn;
                 if( group.empty() ) {
                     spawn.emplace_back( name, calendar::turn );
@@ -10545,7 +10553,7 @@ void map::post_process(unsigned zones)
 void map::place_spawns(const mongroup_id& group, const int chance,
                        const int x1, const int y1, const int x2, const int y2, const float density)
 {
-    if (!ACTIVE_WORLD_OPTIONS["STATIC_SPAWN"]) {
+    if (!option_static_spawn) {
         return;
     }
 
@@ -10556,7 +10564,7 @@ void map::place_spawns(const mongroup_id& group, const int chance,
         return;
     }
 
-    float multiplier = ACTIVE_WORLD_OPTIONS["SPAWN_DENSITY"];
+    float multiplier = option_spawn_density;
 
     if( multiplier == 0.0 ) {
         return;
@@ -10633,7 +10641,7 @@ void map::place_vending(int x, int y, std::string type)
 
 int map::place_npc(int x, int y, std::string type)
 {
-    if(!ACTIVE_WORLD_OPTIONS["STATIC_NPC"]) {
+    if(!option_static_npc) {
         return -1; //Do not generate an npc.
     }
     npc *temp = new npc();
@@ -10651,7 +10659,7 @@ int map::place_npc(int x, int y, std::string type)
 int map::place_items(items_location loc, int chance, int x1, int y1,
                      int x2, int y2, bool ongrass, int turn, bool)
 {
-    const float spawn_rate = ACTIVE_WORLD_OPTIONS["ITEM_SPAWNRATE"];
+    const float spawn_rate = option_item_spawnrate;
 
     if (chance > 100 || chance <= 0) {
         debugmsg("map::place_items() called with an invalid chance (%d)", chance);
@@ -10717,7 +10725,7 @@ void map::add_spawn(const mtype_id& type, int count, int x, int y, bool friendly
                  type.c_str(), count, x, y);
         return;
     }
-    if( ACTIVE_WORLD_OPTIONS["CLASSIC_ZOMBIES"] ) {
+    if( option_classic_zombies ) {
         const mtype& mt = type.obj();
         if( !mt.in_category("CLASSIC") && !mt.in_category("WILDLIFE") ) {
             // Don't spawn non-classic monsters in classic zombie mode.
@@ -10786,10 +10794,15 @@ vehicle *map::add_vehicle(const vproto_id &type, const tripoint &p, const int di
         submap *place_on_submap = get_submap_at_grid( placed_vehicle->smx, placed_vehicle->smy, placed_vehicle->smz );
         place_on_submap->vehicles.push_back(placed_vehicle);
         place_on_submap->is_uniform = false;
+        if( placed_vehicle->has_active_systems() ) {
+            // The submap may be outside of the reality bubble, where the vehicle would be skipped
+            active_vehicles.add( placed_vehicle );
+        }
 
         auto &ch = get_cache( placed_vehicle->smz );
         ch.vehicle_list.insert(placed_vehicle);
         add_vehicle_to_cache( placed_vehicle );
+        vehicle_schedule.invalidate();
 
         //debugmsg ("grid[%d]->vehicles.size=%d veh.parts.size=%d", nonant, grid[nonant]->vehicles.size(),veh.parts.size());
     }
@@ -11142,6 +11155,9 @@ void map::rotate(int turns)
             std::swap( furnrot[i][j], sm->frn[lx][ly] );
             std::swap( traprot[i][j], sm->trp[lx][ly] );
             std::swap( fldrot[i][j], sm->fld[lx][ly] );
+            if( sm->fld[lx][ly].fieldCount() > 0 ) {
+                sm->mark_field_tile( lx, ly );
+            }
             std::swap( radrot[i][j], sm->rad[lx][ly] );
             std::swap( cosmetics_rot[i][j], sm->cosmetics[lx][ly] );
             for( auto &itm : itrot[i][j] ) {
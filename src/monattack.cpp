@@ -1,6 +1,7 @@
 #include "mondeath.h"
 #include "monster.h"
 #include "game.h"
+#include "creature_tracker.h"
 #include "debug.h"
 #include "map.h"
 #include "rng.h"
@@ -1332,13 +1333,12 @@ bool mattack::vine(monster *z)
     }
     // Calculate distance from nearest hub
     int dist_from_hub = 999;
-    for (size_t i = 0; i < g->num_zombies(); i++) {
-        if (g->zombie(i).type->id == mon_creeper_hub) {
-            int dist = rl_dist( z->pos(), g->zombie(i).pos() );
-            if (dist < dist_from_hub) {
-                dist_from_hub = dist;
-            }
-        }
+    const monster *hub = g->critter_tracker->find_nearest( z->pos(), SEEX * MAPSIZE,
+    []( const monster & candidate ) {
+        return candidate.type->id == mon_creeper_hub;
+    } );
+    if( hub != nullptr ) {
+        dist_from_hub = rl_dist( z->pos(), hub->pos() );
     }
     if (grow.empty() || vine_neighbors > 5 || one_in(7 - vine_neighbors) ||
         !one_in(dist_from_hub)) {
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <vector>
 
@@ -28,6 +29,10 @@ MonsterGroupManager::t_string_set MonsterGroupManager::monster_whitelist;
 MonsterGroupManager::t_string_set MonsterGroupManager::monster_categories_blacklist;
 MonsterGroupManager::t_string_set MonsterGroupManager::monster_categories_whitelist;
 
+// Read for each spawned monster
+static const world_option<bool> option_classic_zombies( "CLASSIC_ZOMBIES" );
+static const world_option<float> option_monster_upgrade_factor( "MONSTER_UPGRADE_FACTOR" );
+
 template<>
 const mongroup_id string_id<MonsterGroup>::NULL_ID( "GROUP_NULL" );
 
@@ -58,11 +63,114 @@ void mongroup::clear() {
     monsters.clear();
 }
 
+mongroup_map::mongroup_map( const mongroup_map &other ) : groups( other.groups )
+{
+    copy_index( other );
+}
+
+mongroup_map &mongroup_map::operator=( const mongroup_map &other )
+{
+    if( this != &other ) {
+        groups = other.groups;
+        index.clear();
+        copy_index( other );
+    }
+    return *this;
+}
+
+mongroup &mongroup_map::insert( const mongroup &group )
+{
+    groups.push_back( group );
+    add_to_index( groups.back() );
+    return groups.back();
+}
+
+mongroup_map::iterator mongroup_map::erase( const iterator it )
+{
+    remove_from_index( *it );
+    return groups.erase( it );
+}
+
+void mongroup_map::clear()
+{
+    groups.clear();
+    index.clear();
+}
+
+const std::vector<mongroup *> &mongroup_map::at( const tripoint &p ) const
+{
+    static const std::vector<mongroup *> none;
+    const auto bucket = index.find( p );
+    return bucket != index.end() ? bucket->second : none;
+}
+
+void mongroup_map::move( mongroup &group, const tripoint &p )
+{
+    if( group.pos == p ) {
+        return;
+    }
+    remove_from_index( group );
+    group.pos = p;
+    add_to_index( group );
+}
+
+void mongroup_map::transfer( const iterator it, mongroup_map &other, const tripoint &p )
+{
+    mongroup &group = *it;
+    remove_from_index( group );
+    other.groups.splice( other.groups.end(), groups, it );
+    group.pos = p;
+    other.add_to_index( group );
+}
+
+void mongroup_map::add_to_index( mongroup &group )
+{
+    index[group.pos].push_back( &group );
+}
+
+void mongroup_map::remove_from_index( mongroup &group )
+{
+    const auto bucket = index.find( group.pos );
+    if( bucket == index.end() ) {
+        return;
+    }
+    std::vector<mongroup *> &at_pos = bucket->second;
+    const auto found = std::find( at_pos.begin(), at_pos.end(), &group );
+    if( found == at_pos.end() ) {
+        debugmsg( "monster group %s at %d,%d,%d is missing from the index",
+                  group.type.c_str(), group.pos.x, group.pos.y, group.pos.z );
+        return;
+    }
+    at_pos.erase( found );
+    if( at_pos.empty() ) {
+        index.erase( bucket );
+    }
+}
+
+void mongroup_map::copy_index( const mongroup_map &other )
+{
+    // The groups keep their order in the list, so they are paired up by walking both lists,
+    // the buckets then keep the order of the other map.
+    std::unordered_map<const mongroup *, mongroup *> copies;
+    auto copy = groups.begin();
+    for( const mongroup &group : other.groups ) {
+        copies[&group] = &*copy;
+        ++copy;
+    }
+    for( const auto &bucket : other.index ) {
+        std::vector<mongroup *> &at_pos = index[bucket.first];
+        at_pos.reserve( bucket.second.size() );
+        for( const mongroup *group : bucket.second ) {
+            at_pos.push_back( copies[group] );
+        }
+    }
+}
+
 const MonsterGroup &MonsterGroupManager::GetUpgradedMonsterGroup( const mongroup_id& group )
 {
     const MonsterGroup *groupptr = &group.obj();
-    if (ACTIVE_WORLD_OPTIONS["MONSTER_UPGRADE_FACTOR"] > 0) {
-        const int replace_time = DAYS(groupptr->monster_group_time * ACTIVE_WORLD_OPTIONS["MONSTER_UPGRADE_FACTOR"]);
+    if (option_monster_upgrade_factor > 0) {
+        const int replace_time = DAYS(groupptr->monster_group_time * option_monster_upgrade_factor);
         while( groupptr->replace_monster_group && calendar::turn.get_turn() > replace_time ) {
             groupptr = &groupptr->new_monster_group.obj();
         }
@@ -93,7 +201,7 @@ MonsterGroupResult MonsterGroupManager::GetResultFromGroup(
         valid_entry = valid_entry && (turn == -1 ||
                                       (turn + 900) >= (MINUTES(STARTING_MINUTES) + HOURS(mt.difficulty)));
         // If we are in classic mode, require the monster type to be either CLASSIC or WILDLIFE
-        if(ACTIVE_WORLD_OPTIONS["CLASSIC_ZOMBIES"]) {
+        if(option_classic_zombies) {
             valid_entry = valid_entry && (mt.in_category("CLASSIC") ||
                                           mt.in_category("WILDLIFE"));
         }
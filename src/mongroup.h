@@ -1,10 +1,13 @@
 #ifndef MONGROUP_H
 #define MONGROUP_H
 
+#include <functional>
+#include <list>
 #include <vector>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include "enums.h"
 #include "json.h"
 #include "string_id.h"
@@ -126,6 +129,11 @@ struct mongroup : public JsonSerializer, public JsonDeserializer {
         target.y = y;
     }
     void wander( overmap & );
+    /**
+     * Picks a new target.
+     * @param roll Returns a random number in the inclusive range given by its parameters.
+     */
+    void wander( const overmap &om, const std::function<int( int, int )> &roll );
     void inc_interest( int inc ) {
         interest += inc;
         if( interest > 100 ) {
@@ -154,6 +162,67 @@ struct mongroup : public JsonSerializer, public JsonDeserializer {
     void serialize( JsonOut &jsout ) const override;
 };
 
+/**
+ * The monster groups of an overmap. A group stays at the same address until it is erased, so
+ * pointers and iterators to it remain valid while other groups are added, moved and erased.
+ * The groups are indexed by position, finding those at a position doesn't look at any other.
+ * The position of a group in the map must only be changed with @ref move or @ref transfer.
+ */
+class mongroup_map
+{
+    public:
+        typedef std::list<mongroup>::iterator iterator;
+        typedef std::list<mongroup>::const_iterator const_iterator;
+
+        mongroup_map() = default;
+        /** The index of the copy points into its own groups. */
+        mongroup_map( const mongroup_map &other );
+        mongroup_map( mongroup_map && ) = default;
+        mongroup_map &operator=( const mongroup_map &other );
+        mongroup_map &operator=( mongroup_map && ) = default;
+
+        iterator begin() {
+            return groups.begin();
+        }
+        iterator end() {
+            return groups.end();
+        }
+        const_iterator begin() const {
+            return groups.begin();
+        }
+        const_iterator end() const {
+            return groups.end();
+        }
+        size_t size() const {
+            return groups.size();
+        }
+        bool empty() const {
+            return groups.empty();
+        }
+
+        /** Adds a copy of the group, returns the one in the map. */
+        mongroup &insert( const mongroup &group );
+        iterator erase( iterator it );
+        void clear();
+        /** The groups at the position, in the order they got there. */
+        const std::vector<mongroup *> &at( const tripoint &p ) const;
+        /** Changes the position of a group in this map. */
+        void move( mongroup &group, const tripoint &p );
+        /**
+         * Moves a group of this map into another one, and changes its position there.
+         * Nothing is copied, the group stays at the same address.
+         */
+        void transfer( iterator it, mongroup_map &other, const tripoint &p );
+
+    private:
+        void add_to_index( mongroup &group );
+        void remove_from_index( mongroup &group );
+        void copy_index( const mongroup_map &other );
+
+        std::list<mongroup> groups;
+        std::unordered_map<tripoint, std::vector<mongroup *>> index;
+};
+
 class MonsterGroupManager
 {
     public:
@@ -5,6 +5,7 @@
 #include "map_iterator.h"
 #include "debug.h"
 #include "game.h"
+#include "creature_tracker.h"
 #include "line.h"
 #include "rng.h"
 #include "pldata.h"
@@ -140,21 +141,22 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
     return INT_MAX;
 }
 
-void monster::plan( const mfactions &factions )
+monster_plan monster::plan_targets() const
 {
+    monster_plan result;
     // Bots are more intelligent than most living stuff
     bool electronic = has_flag( MF_ELECTRONIC );
-    Creature *target = nullptr;
+    Creature *&target = result.target;
     // 8.6f is rating for tank drone 60 tiles away, moose 16 or boomer 33
-    float dist = !electronic ? 1000 : 8.6f;
-    bool fleeing = false;
+    float &dist = result.dist;
+    dist = !electronic ? 1000 : 8.6f;
+    bool &fleeing = result.fleeing;
     bool docile = has_flag( MF_VERMIN ) || ( friendly != 0 && has_effect( effect_docile ) );
-    bool angers_hostile_weak = type->anger.find( MTRIG_HOSTILE_WEAK ) != type->anger.end();
     int angers_hostile_near = ( type->anger.find( MTRIG_HOSTILE_CLOSE ) != type->anger.end() ) ? 5 : 0;
     int fears_hostile_near = ( type->fear.find( MTRIG_HOSTILE_CLOSE ) != type->fear.end() ) ? 5 : 0;
-    bool group_morale = has_flag( MF_GROUP_MORALE ) && morale < type->morale;
-    bool swarms = has_flag( MF_SWARMS );
     auto mood = attitude();
+    // Nothing further than that can be seen (see Creature::sees), so it can't be a target either
+    const int max_sight = std::max( 1, sight_range( DAYLIGHT_LEVEL ) );
 
     // If we can see the player, move toward them or flee.
     if( friendly == 0 && sees( g->u ) ) {
@@ -162,17 +164,16 @@ void monster::plan( const mfactions &factions )
         fleeing = fleeing || is_fleeing( g->u );
         target = &g->u;
         if( dist <= 5 ) {
-            anger += angers_hostile_near;
-            morale -= fears_hostile_near;
+            result.anger_change += angers_hostile_near;
+            result.morale_change -= fears_hostile_near;
         }
     } else if( friendly != 0 && !docile ) {
         // Target unfriendly monsters, only if we aren't interacting with the player.
-        for( int i = 0, numz = g->num_zombies(); i < numz; i++ ) {
-            monster &tmp = g->zombie( i );
-            if( tmp.friendly == 0 ) {
-                float rating = rate_target( tmp, dist, electronic );
+        for( monster *tmp : g->critter_tracker->find_near( pos(), max_sight ) ) {
+            if( tmp->friendly == 0 ) {
+                float rating = rate_target( *tmp, dist, electronic );
                 if( rating < dist ) {
-                    target = &tmp;
+                    target = tmp;
                     dist = rating;
                 }
             }
@@ -180,11 +181,7 @@ void monster::plan( const mfactions &factions )
     }
 
     if( docile ) {
-        if( friendly != 0 && target != nullptr ) {
-            set_dest( target->pos() );
-        }
-
-        return;
+        return result;
     }
 
     for( size_t i = 0; i < g->active_npc.size(); i++ ) {
@@ -200,32 +197,61 @@ void monster::plan( const mfactions &factions )
         }
         fleeing = fleeing || fleeing_from;
         if( rating <= 5 ) {
-            anger += angers_hostile_near;
-            morale -= fears_hostile_near;
+            result.anger_change += angers_hostile_near;
+            result.morale_change -= fears_hostile_near;
         }
     }
 
     fleeing = fleeing || ( mood == MATT_FLEE );
     if( friendly == 0 ) {
-        for( const auto &fac : factions ) {
-            auto faction_att = faction.obj().attitude( fac.first );
+        const mfaction_id playerfaction = mfaction_str_id( "player" );
+        const auto &my_faction = faction.obj();
+        for( monster *mon : g->critter_tracker->find_near( pos(), max_sight ) ) {
+            const auto faction_att = my_faction.attitude( mon->friendly == 0 ? mon->faction : playerfaction );
             if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
                 continue;
             }
 
-            for( int i : fac.second ) { // mon indices
-                monster &mon = g->zombie( i );
-                float rating = rate_target( mon, dist, electronic );
-                if( rating < dist ) {
-                    target = &mon;
-                    dist = rating;
-                }
-                if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
-                }
+            float rating = rate_target( *mon, dist, electronic );
+            if( rating < dist ) {
+                target = mon;
+                dist = rating;
             }
+            if( rating <= 5 ) {
+                result.anger_change += angers_hostile_near;
+                result.morale_change -= fears_hostile_near;
+            }
+        }
+    }
+
+    return result;
+}
+
+void monster::plan( const mfactions &factions )
+{
+    plan( factions, plan_targets() );
+}
+
+void monster::plan( const mfactions &factions, const monster_plan &targets )
+{
+    bool electronic = has_flag( MF_ELECTRONIC );
+    Creature *target = targets.target;
+    float dist = targets.dist;
+    bool fleeing = targets.fleeing;
+    bool docile = has_flag( MF_VERMIN ) || ( friendly != 0 && has_effect( effect_docile ) );
+    bool angers_hostile_weak = type->anger.find( MTRIG_HOSTILE_WEAK ) != type->anger.end();
+    bool group_morale = has_flag( MF_GROUP_MORALE ) && morale < type->morale;
+    bool swarms = has_flag( MF_SWARMS );
+
+    anger += targets.anger_change;
+    morale += targets.morale_change;
+
+    if( docile ) {
+        if( friendly != 0 && target != nullptr ) {
+            set_dest( target->pos() );
         }
+
+        return;
     }
 
     // Friendly monsters here
@@ -847,6 +873,22 @@ tripoint monster::wander_next()
     return next;
 }
 
+// Cost of a tile for monsters that move differently over tiles with a given flag:
+// `flag_cost` if the tile has it, scaled terrain move cost otherwise.
+static int special_movecost( const tripoint &p, const pf_special flag, const int flag_cost )
+{
+    if( !g->m.inbounds( p ) ) {
+        return 0;
+    }
+
+    const auto &pf_cache = g->m.get_pathfinding_cache_ref( p.z );
+    if( ( pf_cache.special[p.x][p.y] & flag ) != 0 ) {
+        return flag_cost;
+    }
+
+    return 50 * pf_cache.move_cost[p.x][p.y];
+}
+
 int monster::calc_movecost( const tripoint &f, const tripoint &t ) const
 {
     int movecost = 0;
@@ -857,41 +899,17 @@ int monster::calc_movecost( const tripoint &f, const tripoint &t ) const
         movecost = 100 * diag_mult;
         // Swimming monsters move super fast in water
     } else if( has_flag( MF_SWIMS ) ) {
-        if( g->m.has_flag( "SWIMMABLE", f ) ) {
-            movecost += 25;
-        } else {
-            movecost += 50 * g->m.move_cost( f );
-        }
-        if( g->m.has_flag( "SWIMMABLE", t ) ) {
-            movecost += 25;
-        } else {
-            movecost += 50 * g->m.move_cost( t );
-        }
+        movecost += special_movecost( f, PF_SWIMMABLE, 25 );
+        movecost += special_movecost( t, PF_SWIMMABLE, 25 );
         movecost *= diag_mult;
     } else if( can_submerge() ) {
         // No-breathe monsters have to walk underwater slowly
-        if( g->m.has_flag( "SWIMMABLE", f ) ) {
-            movecost += 150;
-        } else {
-            movecost += 50 * g->m.move_cost( f );
-        }
-        if( g->m.has_flag( "SWIMMABLE", t ) ) {
-            movecost += 150;
-        } else {
-            movecost += 50 * g->m.move_cost( t );
-        }
+        movecost += special_movecost( f, PF_SWIMMABLE, 150 );
+        movecost += special_movecost( t, PF_SWIMMABLE, 150 );
         movecost *= diag_mult / 2;
     } else if( has_flag( MF_CLIMBS ) ) {
-        if( g->m.has_flag( "CLIMBABLE", f ) ) {
-            movecost += 150;
-        } else {
-            movecost += 50 * g->m.move_cost( f );
-        }
-        if( g->m.has_flag( "CLIMBABLE", t ) ) {
-            movecost += 150;
-        } else {
-            movecost += 50 * g->m.move_cost( t );
-        }
+        movecost += special_movecost( f, PF_CLIMBABLE, 150 );
+        movecost += special_movecost( t, PF_CLIMBABLE, 150 );
         movecost *= diag_mult / 2;
     } else {
         // All others use the same calculation as the player
@@ -39,6 +39,8 @@
 // The rough formula is 2^(-x), e.g. for x = 5 it's 0.03125 (~ 3%).
 #define UPGRADE_MAX_ITERS 5
 
+static const world_option<float> option_monster_upgrade_factor( "MONSTER_UPGRADE_FACTOR" );
+
 const mtype_id mon_ant( "mon_ant" );
 const mtype_id mon_ant_fungus( "mon_ant_fungus" );
 const mtype_id mon_ant_queen( "mon_ant_queen" );
@@ -203,7 +205,7 @@ void monster::poly( const mtype_id& id )
 }
 
 bool monster::can_upgrade() {
-    return upgrades && (ACTIVE_WORLD_OPTIONS["MONSTER_UPGRADE_FACTOR"] > 0.0);
+    return upgrades && (option_monster_upgrade_factor > 0.0);
 }
 
 // For master special attack.
@@ -212,7 +214,7 @@ void monster::hasten_upgrade() {
         return;
     }
 
-    const int scaled_half_life = type->half_life * ACTIVE_WORLD_OPTIONS["MONSTER_UPGRADE_FACTOR"];
+    const int scaled_half_life = type->half_life * option_monster_upgrade_factor;
     upgrade_time -= rng(1, scaled_half_life);
     if (upgrade_time < 0) {
         upgrade_time = 0;
@@ -222,7 +224,7 @@ void monster::hasten_upgrade() {
 // This will disable upgrades in case max iters have been reached.
 // Checking for return value of -1 is necessary.
 int monster::next_upgrade_time() {
-    const int scaled_half_life = type->half_life * ACTIVE_WORLD_OPTIONS["MONSTER_UPGRADE_FACTOR"];
+    const int scaled_half_life = type->half_life * option_monster_upgrade_factor;
     int day = scaled_half_life;
     for (int i = 0; i < UPGRADE_MAX_ITERS; i++) {
         if (one_in(2)) {
@@ -19,6 +19,18 @@ using mtype_id = string_id<mtype>;
 
 typedef std::map< mfaction_id, std::set< int > > mfactions;
 
+/**
+ * Target selection computed by @ref monster::plan_targets.
+ * Changes to anger and morale are only recorded here and applied by @ref monster::plan.
+ */
+struct monster_plan {
+    Creature *target = nullptr;
+    float dist = 0.0f;
+    bool fleeing = false;
+    int anger_change = 0;
+    int morale_change = 0;
+};
+
 class mon_special_attack : public JsonSerializer
 {
     public:
@@ -158,6 +170,13 @@ class monster : public Creature, public JsonSerializer, public JsonDeserializer
         // Pass all factions to mon, so that hordes of same-faction mons
         // do not iterate over each other
         void plan( const mfactions &factions );
+        /**
+         * Picks a target among the player, NPCs and hostile monsters.
+         * Doesn't modify anything or use the RNG, so it can be run for many monsters in parallel.
+         */
+        monster_plan plan_targets() const;
+        /** Same as plan( const mfactions & ), but with targets already selected by @ref plan_targets. */
+        void plan( const mfactions &factions, const monster_plan &targets );
         void move(); // Actual movement
         void footsteps( const tripoint &p ); // noise made by movement
 
@@ -44,6 +44,41 @@ std::map<std::string, int> mOptionsSort;
 std::map<std::string, std::string> optionNames;
 int iWorldOptPage;
 
+// Starts above the initial value of option::cached_changes, so each option is looked up once
+unsigned int options_manager::changes = 1;
+
+static void read_option( options_manager::cOpt &opt, bool &value )
+{
+    value = static_cast<bool>( opt );
+}
+
+static void read_option( options_manager::cOpt &opt, int &value )
+{
+    value = static_cast<int>( opt );
+}
+
+static void read_option( options_manager::cOpt &opt, float &value )
+{
+    value = static_cast<float>( opt );
+}
+
+static void read_option( options_manager::cOpt &opt, std::string &value )
+{
+    value = opt.getValue();
+}
+
+template<typename T>
+void option<T>::update() const
+{
+    read_option( ( world ? ACTIVE_WORLD_OPTIONS : OPTIONS )[name], value );
+    cached_changes = options_manager::get_changes();
+}
+
+template class option<bool>;
+template class option<int>;
+template class option<float>;
+template class option<std::string>;
+
 options_manager &get_options()
 {
     static options_manager single_instance;
@@ -401,6 +436,7 @@ int options_manager::cOpt::getMaxLength()
 //set to next item
 void options_manager::cOpt::setNext()
 {
+    notify_changed();
     if (sType == "string_select") {
         int iNext = getItemPos(sSet) + 1;
         if (iNext >= (int)vItems.size()) {
@@ -435,6 +471,7 @@ void options_manager::cOpt::setNext()
 //set to prev item
 void options_manager::cOpt::setPrev()
 {
+    notify_changed();
     if (sType == "string_select") {
         int iPrev = getItemPos(sSet) - 1;
         if (iPrev < 0) {
@@ -466,6 +503,7 @@ void options_manager::cOpt::setPrev()
 //set value
 void options_manager::cOpt::setValue(float fSetIn)
 {
+    notify_changed();
     if (sType != "float") {
         debugmsg("tried to set a float value to a %s option", sType.c_str());
         return;
@@ -479,6 +517,7 @@ void options_manager::cOpt::setValue(float fSetIn)
 //set value
 void options_manager::cOpt::setValue(std::string sSetIn)
 {
+    notify_changed();
     if (sType == "string_select") {
         if (getItemPos(sSetIn) != -1) {
             sSet = sSetIn;
@@ -760,6 +799,23 @@ void options_manager::init()
                                        0, 127, 5
                                       );
 
+    OPTIONS["MAP_MEMORY_LIMIT"] = cOpt("general", _("Map memory limit"),
+                                       _("Approximate memory in megabytes the map may use. Beyond that, the areas visited longest ago are written to disk and unloaded until they are needed again. If 0, the map is only written to disk when saving."),
+                                       0, 16384, 1024
+                                      );
+
+    optionNames["json"] = _("JSON");
+    optionNames["binary"] = _("Binary");
+    OPTIONS["MAP_SAVE_FORMAT"] = cOpt("general", _("Map save format"),
+                                      _("Format of saved map files. Binary files are much smaller and faster to save and load, but older versions of the game can't read them. Files in either format are loaded. The debug menu can convert existing files to the selected format."),
+                                      "json,binary", "json"
+                                     );
+
+    OPTIONS["PREGENERATE_QUADS"] = cOpt("general", _("Terrain generated ahead per turn"),
+                                        _("How many overmap tiles the player is heading into are generated each turn, before they come into view. With z-levels, each level of a tile counts on its own. Higher values avoid pauses when driving fast into unexplored terrain. If 0, terrain is only generated when it comes into view."),
+                                        0, 6, 4
+                                       );
+
     mOptionsSort["general"]++;
 
     OPTIONS["CIRCLEDIST"] = cOpt("general", _("Circular distances"),
@@ -1145,6 +1201,33 @@ void options_manager::init()
                                  false
                                 );
 
+    mOptionsSort["debug"]++;
+
+    OPTIONS["MONSTER_PLANNING_THREADS"] = cOpt("debug", _("Monster planning threads"),
+                                 _("If 0, each monster picks its target right before it moves. Otherwise all monsters pick their targets at the start of the turn, using this many threads. Results don't depend on the number of threads."),
+                                 0, 16, 0
+                                );
+
+    OPTIONS["FOV_THREADS"] = cOpt("debug", _("Field of vision threads"),
+                                 _("Number of threads used to compute what the player can see. The result doesn't depend on it. Has no effect with 3D field of vision."),
+                                 1, 4, 1
+                                );
+
+    OPTIONS["HORDE_THREADS"] = cOpt("debug", _("Horde movement threads"),
+                                 _("Number of threads used to move the hordes on the overmaps near the player. The result doesn't depend on it."),
+                                 1, 8, 1
+                                );
+
+    OPTIONS["DATA_CACHE"] = cOpt("debug", _("Cache finalized game data"),
+                                 _("If true, game data that is slow to set up after loading, like the vehicle blueprints, is kept in a cache file. It is used again as long as the same data files are loaded."),
+                                 true
+                                );
+
+    OPTIONS["PROFILE_CSV"] = cOpt("debug", _("Write turn profile"),
+                                  _("If true, the time taken by the parts of each turn, like moving the monsters or the vehicles, is appended to turn_profile.csv in the config directory."),
+                                  false
+                                 );
+
     ////////////////////////////WORLD DEFAULT////////////////////
     optionNames["no"] = _("No");
     optionNames["yes"] = _("Yes");
@@ -1311,6 +1394,8 @@ void options_manager::init()
             bLastLineEmpty = bThisLineEmpty;
         }
     }
+
+    notify_changed();
 }
 
 #ifdef TILES
@@ -1660,6 +1745,7 @@ void options_manager::show(bool ingame)
             if (ingame && world_options_changed) {
                 ACTIVE_WORLD_OPTIONS = WOPTIONS_OLD;
             }
+            notify_changed();
         }
     }
     if( lang_changed ) {
@@ -158,9 +158,24 @@ class options_manager : public JsonSerializer, public JsonDeserializer
         bool save( bool ingame = false );
         void show( bool ingame = false );
 
+        /**
+         * Has to be called after the values in OPTIONS or ACTIVE_WORLD_OPTIONS were changed other
+         * than through @ref cOpt, e.g. when a whole set of options got replaced.
+         */
+        static void notify_changed() {
+            changes++;
+        }
+        /** Increases whenever any option may have changed, see @ref option. */
+        static unsigned int get_changes() {
+            return changes;
+        }
+
         using JsonSerializer::serialize;
         void serialize( JsonOut &json ) const override;
         void deserialize( JsonIn &jsin ) override;
+
+    private:
+        static unsigned int changes;
 };
 
 bool use_narrow_sidebar(); // short-circuits to on if terminal is too small
@@ -182,4 +197,51 @@ extern int iWorldOptPage;
 
 options_manager &get_options();
 
+/**
+ * A handle to an option that converts the value only when options changed, reading it is as cheap
+ * as reading a variable. Use it instead of OPTIONS["NAME"] where the option is read often, e.g.
+ * each turn or for each tile drawn. Like OPTIONS, it must only be read on the main thread.
+ *
+ * The value is converted like cOpt does, T is bool, int, float or std::string. The latter gives
+ * the value of string options, compare it with `option.get() == "value"`.
+ */
+template<typename T>
+class option
+{
+    public:
+        explicit option( const std::string &name ) : option( name, false ) {
+        }
+
+        const T &get() const {
+            if( cached_changes != options_manager::get_changes() ) {
+                update();
+            }
+            return value;
+        }
+        operator const T &() const {
+            return get();
+        }
+
+    protected:
+        option( const std::string &name, const bool world ) : name( name ), world( world ) {
+        }
+
+    private:
+        void update() const;
+
+        std::string name;
+        bool world;
+        mutable T value = T();
+        mutable unsigned int cached_changes = 0;
+};
+
+/** A handle to an option of the active world, see @ref option. */
+template<typename T>
+class world_option : public option<T>
+{
+    public:
+        explicit world_option( const std::string &name ) : option<T>( name, true ) {
+        }
+};
+
 #endif
@@ -46,6 +46,8 @@ int OVERMAP_WINDOW_WIDTH;
 
 scrollingcombattext SCT;
 extern bool tile_iso;
+
+static const option<bool> option_animation_sct( "ANIMATION_SCT" );
 extern bool use_tiles;
 
 void delwin_functor::operator()( WINDOW *w ) const {
@@ -2085,7 +2087,7 @@ void scrollingcombattext::add(const int p_iPosX, const int p_iPosY, direction p_
                               const std::string p_sText2, const game_message_type p_gmt2,
                               const std::string p_sType)
 {
-    if (OPTIONS["ANIMATION_SCT"]) {
+    if (option_animation_sct) {
 
         int iCurStep = 0;
 
@@ -945,19 +945,19 @@ bool overmap::is_explored(int const x, int const y, int const z) const
 
 bool overmap::mongroup_check(const mongroup &candidate) const
 {
-    const auto matching_range = zg.equal_range(candidate.pos);
-    return std::find_if( matching_range.first, matching_range.second,
-        [candidate](std::pair<tripoint, mongroup> match) {
+    const auto &matching = zg.at( candidate.pos );
+    return std::find_if( matching.begin(), matching.end(),
+        [&candidate]( const mongroup *match ) {
             // This is extra strict since we're using it to test serialization.
-            return candidate.type == match.second.type && candidate.pos == match.second.pos &&
-                candidate.radius == match.second.radius &&
-                candidate.population == match.second.population &&
-                candidate.target == match.second.target &&
-                candidate.interest == match.second.interest &&
-                candidate.dying == match.second.dying &&
-                candidate.horde == match.second.horde &&
-                candidate.diffuse == match.second.diffuse;
-        } ) != matching_range.second;
+            return candidate.type == match->type && candidate.pos == match->pos &&
+                candidate.radius == match->radius &&
+                candidate.population == match->population &&
+                candidate.target == match->target &&
+                candidate.interest == match->interest &&
+                candidate.dying == match->dying &&
+                candidate.horde == match->horde &&
+                candidate.diffuse == match->diffuse;
+        } ) != matching.end();
 }
 
 int overmap::num_mongroups() const
@@ -2469,13 +2469,13 @@ tripoint overmap::find_random_omt( const std::string &omt_base_type ) const
 void overmap::process_mongroups()
 {
     for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
+        mongroup &mg = *it;
         if( mg.dying ) {
             mg.population = (mg.population * 4) / 5;
             mg.radius = (mg.radius * 9) / 10;
         }
         if( mg.empty() ) {
-            zg.erase( it++ );
+            it = zg.erase( it );
         } else {
             ++it;
         }
@@ -2488,6 +2488,13 @@ void overmap::clear_mon_groups()
 }
 
 void mongroup::wander( overmap &om )
+{
+    wander( om, []( const int lo, const int hi ) {
+        return int( rng( lo, hi ) );
+    } );
+}
+
+void mongroup::wander( const overmap &om, const std::function<int( int, int )> &roll )
 {
     const city *target_city = nullptr;
     int target_distance = 0;
@@ -2508,37 +2515,36 @@ void mongroup::wander( overmap &om )
         // TODO: somehow use the same algorithm that distributes zombie
         // density at world gen to spread the hordes over the actual
         // city, rather than the center city tile
-        target.x = target_city->x * 2 + rng( -5, 5 );
-        target.y = target_city->y * 2 + rng( -5, 5 );
+        target.x = target_city->x * 2 + roll( -5, 5 );
+        target.y = target_city->y * 2 + roll( -5, 5 );
         interest = 100;
     } else {
-        target.x = pos.x + rng( -10, 10 );
-        target.y = pos.y + rng( -10, 10 );
+        target.x = pos.x + roll( -10, 10 );
+        target.y = pos.y + roll( -10, 10 );
         interest = 30;
     }
 }
 
-void overmap::move_hordes()
+void overmap::move_hordes( const std::function<int( int, int )> &roll,
+                           std::vector<mongroup_map::iterator> &leaving )
 {
-    // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype(zg) tmpzg;
     //MOVE ZOMBIE GROUPS
-    for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
+    // Groups are moved in place, the order of zg doesn't change, so none is moved twice.
+    for( auto it = zg.begin(); it != zg.end(); ++it ) {
+        mongroup &mg = *it;
         if( !mg.horde ) {
-            ++it;
             continue;
         }
 
         if(mg.horde_behaviour == "") {
-            mg.horde_behaviour = one_in(2) ? "city" : "roam";
+            mg.horde_behaviour = roll( 0, 1 ) == 0 ? "city" : "roam";
         }
 
         // Gradually decrease interest.
         mg.dec_interest( 1 );
 
         if( (mg.pos.x == mg.target.x && mg.pos.y == mg.target.y) || mg.interest <= 15 ) {
-            mg.wander(*this);
+            mg.wander( *this, roll );
         }
 
         // Decrease movement chance according to the terrain we're currently on.
@@ -2552,88 +2558,82 @@ void overmap::move_hordes()
             movement_chance = 10;
         }
 
-        if( one_in(movement_chance) && rng(0, 100) < mg.interest ) {
+        if( roll( 0, movement_chance - 1 ) == 0 && roll( 0, 100 ) < mg.interest ) {
             // TODO: Adjust for monster speed.
-            // TODO: Handle moving to adjacent overmaps.
-            if( mg.pos.x > mg.target.x) {
-                mg.pos.x--;
+            tripoint next = mg.pos;
+            if( next.x > mg.target.x) {
+                next.x--;
             }
-            if( mg.pos.x < mg.target.x) {
-                mg.pos.x++;
+            if( next.x < mg.target.x) {
+                next.x++;
             }
-            if( mg.pos.y > mg.target.y) {
-                mg.pos.y--;
+            if( next.y > mg.target.y) {
+                next.y--;
             }
-            if( mg.pos.y < mg.target.y) {
-                mg.pos.y++;
+            if( next.y < mg.target.y) {
+                next.y++;
+            }
+            zg.move( mg, next );
+            if( next.x < 0 || next.y < 0 || next.x >= OMAPX * 2 || next.y >= OMAPY * 2 ) {
+                leaving.push_back( it );
             }
-
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint, mongroup>( mg.pos, mg ) );
-            zg.erase( it++ );
-        } else {
-            ++it;
         }
     }
-    // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
-
-
-    if(ACTIVE_WORLD_OPTIONS["WANDER_SPAWNS"]) {
-        static const mongroup_id GROUP_ZOMBIE("GROUP_ZOMBIE");
-
-        // Re-absorb zombies into hordes.
-        // Scan over monsters outside the player's view and place them back into hordes.
-        auto monster_map_it = monster_map.begin();
-        while(monster_map_it != monster_map.end()) {
-            const auto& p = monster_map_it->first;
-            auto& this_monster = monster_map_it->second;
-
-            // Only zombies on z-level 0 may join hordes.
-            if( p.z != 0 ) {
-                monster_map_it++;
-                continue;
-            }
-
-            // Check if the monster is a zombie.
-            auto& type = *(this_monster.type);
-            if(
-                !type.species.count(species_id("ZOMBIE")) || // Only add zombies to hordes.
-                type.id == mtype_id("mon_jabberwock") || // Jabberwockies are an exception.
-                this_monster.mission_id != -1 // We mustn't delete monsters that are related to missions.
-            ) {
-                // Don't delete the monster, just increment the iterator.
-                monster_map_it++;
-                continue;
-            }
+}
 
-            // Scan for compatible hordes in this area.
-            mongroup *add_to_group = NULL;
-            auto group_bucket = zg.equal_range(p);
-            std::for_each( group_bucket.first, group_bucket.second,
-                [&](std::pair<const tripoint, mongroup> &horde_entry ) {
-                mongroup &horde = horde_entry.second;
+void overmap::absorb_into_hordes()
+{
+    static const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
+    static const species_id ZOMBIE( "ZOMBIE" );
+    static const mtype_id mon_jabberwock( "mon_jabberwock" );
+
+    // Re-absorb zombies into hordes.
+    // Scan over monsters outside the player's view and place them back into hordes.
+    auto monster_map_it = monster_map.begin();
+    while(monster_map_it != monster_map.end()) {
+        const auto& p = monster_map_it->first;
+        auto& this_monster = monster_map_it->second;
+
+        // Only zombies on z-level 0 may join hordes.
+        if( p.z != 0 ) {
+            monster_map_it++;
+            continue;
+        }
 
-                // We only absorb zombies into GROUP_ZOMBIE hordes
-                if(horde.horde && !horde.monsters.empty() && horde.type == GROUP_ZOMBIE) {
-                    add_to_group = &horde;
-                }
-            });
+        // Check if the monster is a zombie.
+        auto& type = *(this_monster.type);
+        if(
+            !type.species.count( ZOMBIE ) || // Only add zombies to hordes.
+            type.id == mon_jabberwock || // Jabberwockies are an exception.
+            this_monster.mission_id != -1 // We mustn't delete monsters that are related to missions.
+        ) {
+            // Don't delete the monster, just increment the iterator.
+            monster_map_it++;
+            continue;
+        }
 
-            // If there is no horde to add the monster to, create one.
-            if(add_to_group == NULL) {
-                mongroup m(GROUP_ZOMBIE, p.x, p.y, p.z, 1, 0);
-                m.horde = true;
-                m.monsters.push_back(this_monster);
-                m.interest = 0; // Ensures that we will select a new target.
-                add_mon_group( m );
-            } else {
-                add_to_group->monsters.push_back(this_monster);
+        // Scan for compatible hordes in this area.
+        mongroup *add_to_group = NULL;
+        for( mongroup *horde : zg.at( p ) ) {
+            // We only absorb zombies into GROUP_ZOMBIE hordes
+            if(horde->horde && !horde->monsters.empty() && horde->type == GROUP_ZOMBIE) {
+                add_to_group = horde;
             }
+        }
 
-            // Delete the monster, continue iterating.
-            monster_map_it = monster_map.erase(monster_map_it);
+        // If there is no horde to add the monster to, create one.
+        if(add_to_group == NULL) {
+            mongroup m(GROUP_ZOMBIE, p.x, p.y, p.z, 1, 0);
+            m.horde = true;
+            m.monsters.push_back(this_monster);
+            m.interest = 0; // Ensures that we will select a new target.
+            add_mon_group( m );
+        } else {
+            add_to_group->monsters.push_back(this_monster);
         }
+
+        // Delete the monster, continue iterating.
+        monster_map_it = monster_map.erase(monster_map_it);
     }
 }
 
@@ -2642,8 +2642,7 @@ void overmap::move_hordes()
 */
 void overmap::signal_hordes( const tripoint &p, const int sig_power)
 {
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
+    for( mongroup &mg : zg ) {
         if( !mg.horde ) {
             continue;
         }
@@ -4557,7 +4556,7 @@ void overmap::add_mon_group(const mongroup &group)
     // makes the diffuse setting obsolete (as it only controls how the radius
     // is interpreted) - it's only used when adding monster groups with function.
     if( group.radius == 1 ) {
-        zg.insert(std::pair<tripoint, mongroup>( group.pos, group ) );
+        zg.insert( group );
         return;
     }
     // diffuse groups use a circular area, non-diffuse groups use a rectangular area
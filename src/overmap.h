@@ -7,6 +7,7 @@
 #include "weighted_list.h"
 #include "game_constants.h"
 #include "monster.h"
+#include "mongroup.h"
 
 #include <array>
 #include <iosfwd>
@@ -313,8 +314,10 @@ class overmap
      return settings;
   }
     void clear_mon_groups();
+    /** Adds the group, groups with a radius other than 1 are split into groups of radius 1. */
+    void add_mon_group(const mongroup &group);
 private:
-    std::multimap<tripoint, mongroup> zg;
+    mongroup_map zg;
 public:
     /** Unit test enablers to check if a given mongroup is present. */
     bool mongroup_check(const mongroup &candidate) const;
@@ -371,7 +374,16 @@ public:
     int dist_from_city( const tripoint &p );
     void signal_hordes( const tripoint &p, int sig_power );
     void process_mongroups();
-    void move_hordes();
+    /**
+     * Moves the hordes a step towards their targets. Hordes stepping over the edge of the overmap
+     * are left at the position outside of it and added to leaving, for @ref overmapbuffer to hand
+     * them to the overmap they are in.
+     * @param roll Returns a random number in the inclusive range given by its parameters.
+     */
+    void move_hordes( const std::function<int( int, int )> &roll,
+                      std::vector<mongroup_map::iterator> &leaving );
+    /** Puts the zombies that were despawned from the reality bubble back into hordes. */
+    void absorb_into_hordes();
 
     static bool obsolete_terrain( const std::string &ter );
     void convert_terrain( const std::unordered_map<tripoint, std::string> &needs_conversion );
@@ -439,8 +451,6 @@ public:
   void place_special(const overmap_special& special, const tripoint& p, int rotation);
   void place_mongroups();
   void place_radios();
-
-    void add_mon_group(const mongroup &group);
 };
 
 // TODO: readd the stream operators
@@ -12,15 +12,23 @@
 #include "catacharset.h"
 #include "npc.h"
 #include "vehicle.h"
+#include "options.h"
+#include "rng.h"
+#include "thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
+#include <climits>
 #include <fstream>
+#include <random>
 #include <sstream>
 #include <stdlib.h>
 
 overmapbuffer overmap_buffer;
 
+static const option<int> option_horde_threads( "HORDE_THREADS" );
+static const world_option<bool> option_wander_spawns( "WANDER_SPAWNS" );
+
 overmapbuffer::overmapbuffer()
 : last_requested_overmap( nullptr )
 {
@@ -74,11 +82,11 @@ overmap &overmapbuffer::get( const int x, const int y )
 void overmapbuffer::fix_mongroups(overmap &new_overmap)
 {
     for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
-        auto &mg = it->second;
+        auto &mg = *it;
         // spawn related code simply sets population to 0 when they have been
         // transformed into spawn points on a submap, the group can then be removed
         if( mg.empty() ) {
-            new_overmap.zg.erase( it++ );
+            it = new_overmap.zg.erase( it );
             continue;
         }
         // Inside the bounds of the overmap?
@@ -96,10 +104,7 @@ void overmapbuffer::fix_mongroups(overmap &new_overmap)
             continue;
         }
         overmap &om = get( omp.x, omp.y );
-        mg.pos.x = smabs.x;
-        mg.pos.y = smabs.y;
-        om.add_mon_group( mg );
-        new_overmap.zg.erase( it++ );
+        new_overmap.zg.transfer( it++, om.zg, tripoint( smabs.x, smabs.y, mg.pos.z ) );
     }
 }
 
@@ -332,8 +337,45 @@ void overmapbuffer::move_hordes()
     // arbitrary radius to include nearby overmaps (aside from the current one)
     const auto radius = MAPSIZE * 2;
     const auto center = g->u.global_sm_location();
-    for( auto &om : get_overmaps_near( center, radius ) ) {
-        om->move_hordes();
+    const std::vector<overmap *> near = get_overmaps_near( center, radius );
+
+    // Each overmap moves its hordes with its own random numbers, seeded here in a fixed order,
+    // so the hordes end up in the same places no matter how many threads move them.
+    std::vector<std::minstd_rand> engines;
+    for( size_t i = 0; i < near.size(); i++ ) {
+        engines.emplace_back( rng( 0, INT_MAX ) );
+    }
+    std::vector<std::vector<mongroup_map::iterator>> leaving( near.size() );
+    thread_pool &pool = get_thread_pool( pool_purpose::horde_movement, option_horde_threads - 1 );
+    pool.parallel_for( near.size(), [&]( size_t i ) {
+        std::minstd_rand &engine = engines[i];
+        near[i]->move_hordes( [&engine]( const int lo, const int hi ) {
+            return std::uniform_int_distribution<int>( lo, hi )( engine );
+        }, leaving[i] );
+    } );
+
+    // Hordes that walked off an overmap go to the one they walked into. If that one
+    // isn't loaded they stay where they are, fix_mongroups moves them once it is.
+    for( size_t i = 0; i < near.size(); i++ ) {
+        overmap &om = *near[i];
+        const point om_sm = om_to_sm_copy( om.pos() );
+        for( const mongroup_map::iterator &it : leaving[i] ) {
+            point smabs( it->pos.x + om_sm.x, it->pos.y + om_sm.y );
+            const point omp = sm_to_om_remain( smabs );
+            if( !has( omp.x, omp.y ) ) {
+                continue;
+            }
+            // The target is relative to the overmap as well
+            it->target.x += smabs.x - it->pos.x;
+            it->target.y += smabs.y - it->pos.y;
+            om.zg.transfer( it, get( omp.x, omp.y ).zg, tripoint( smabs.x, smabs.y, it->pos.z ) );
+        }
+    }
+
+    if( option_wander_spawns ) {
+        pool.parallel_for( near.size(), [&]( size_t i ) {
+            near[i]->absorb_into_hordes();
+        } );
     }
 }
 
@@ -362,12 +404,11 @@ std::vector<mongroup*> overmapbuffer::groups_at(int x, int y, int z)
     }
     const tripoint dpos( x, y, z );
     overmap &om = get( omp.x, omp.y );
-    for( auto it = om.zg.lower_bound( dpos ), end = om.zg.upper_bound( dpos ); it != end; ++it ) {
-        auto &mg = it->second;
-        if( mg.empty() ) {
+    for( mongroup *mg : om.zg.at( dpos ) ) {
+        if( mg->empty() ) {
             continue;
         }
-        result.push_back( &mg );
+        result.push_back( mg );
     }
     return result;
 }
@@ -107,6 +107,8 @@ void PATH_INFO::update_config_dir()
     update_pathname("fontdata", FILENAMES["config_dir"] + "fonts.json");
     update_pathname("autopickup", FILENAMES["config_dir"] + "auto_pickup.json");
     update_pathname("custom_colors", FILENAMES["config_dir"] + "custom_colors.json");
+    update_pathname("datacache", FILENAMES["config_dir"] + "data_cache.json");
+    update_pathname("profilecsv", FILENAMES["config_dir"] + "turn_profile.csv");
 }
 
 void PATH_INFO::set_standard_filenames(void)
@@ -184,6 +186,8 @@ void PATH_INFO::set_standard_filenames(void)
     update_pathname("fontdata", FILENAMES["config_dir"] + "fonts.json");
     update_pathname("autopickup", FILENAMES["config_dir"] + "auto_pickup.json");
     update_pathname("custom_colors", FILENAMES["config_dir"] + "custom_colors.json");
+    update_pathname("datacache", FILENAMES["config_dir"] + "data_cache.json");
+    update_pathname("profilecsv", FILENAMES["config_dir"] + "turn_profile.csv");
     update_pathname("worldoptions", "worldoptions.json");
 
     // Needed to move files from these legacy locations to the new config directory.
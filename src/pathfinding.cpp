@@ -1,3 +1,4 @@
+#include "pathfinding.h"
 #include "coordinates.h"
 #include "debug.h"
 #include "enums.h"
@@ -29,45 +30,89 @@ constexpr int flat_index( const int x, const int y )
     return ( x * MAPSIZE * SEEY ) + y;
 };
 
+constexpr int path_layer_size = SEEX * MAPSIZE * SEEY * MAPSIZE;
+
+// Packs a position into a single int: z-level in the high part, flat index in the low one
+constexpr int pack_index( const int x, const int y, const int z )
+{
+    return ( z + OVERMAP_DEPTH ) * path_layer_size + flat_index( x, y );
+}
+
+tripoint unpack_index( const int packed )
+{
+    const int flat = packed % path_layer_size;
+    return tripoint( flat / ( MAPSIZE * SEEY ), flat % ( MAPSIZE * SEEY ),
+                     packed / path_layer_size - OVERMAP_DEPTH );
+}
+
 // Flattened 2D array representing a single z-level worth of pathfinding data
+// A cell is only valid if its stamp matches the generation of the current search,
+// otherwise it is treated as unvisited. This way the layer never needs to be cleared.
 struct path_data_layer {
+    std::array< unsigned int, path_layer_size > stamp;
     // State is accessed way more often than all other values here
-    std::array< astar_state, SEEX *MAPSIZE *SEEY *MAPSIZE > state;
-    std::array< int, SEEX *MAPSIZE *SEEY *MAPSIZE > score;
-    std::array< int, SEEX *MAPSIZE *SEEY *MAPSIZE > gscore;
-    std::array< tripoint, SEEX *MAPSIZE *SEEY *MAPSIZE > parent;
-
-    void init( const int minx, const int miny, const int maxx, const int maxy ) {
-        for( int x = minx; x <= maxx; x++ ) {
-            for( int y = miny; y <= maxy; y++ ) {
-                const int ind = flat_index( x, y );
-                state[ind] = ASL_NONE; // Mark as unvisited
-            }
-        }
-    };
+    std::array< astar_state, path_layer_size > state;
+    std::array< int, path_layer_size > score;
+    std::array< int, path_layer_size > gscore;
+    // Packed with pack_index
+    std::array< int, path_layer_size > parent;
+
+    unsigned int generation = 0;
+
+    path_data_layer() {
+        stamp.fill( 0 );
+    }
+
+    astar_state get_state( const int index ) const {
+        return stamp[index] == generation ? state[index] : ASL_NONE;
+    }
+
+    void set_state( const int index, const astar_state new_state ) {
+        stamp[index] = generation;
+        state[index] = new_state;
+    }
 };
 
+// Reusable A* workspace, kept between calls to map::route
 struct pathfinder {
-    int minx;
-    int miny;
-    int maxx;
-    int maxy;
-    pathfinder( int _minx, int _miny, int _maxx, int _maxy ) :
-        minx( _minx ), miny( _miny ), maxx( _maxx ), maxy( _maxy ) {
-    }
+    int minx = 0;
+    int miny = 0;
+    int maxx = 0;
+    int maxy = 0;
 
-    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp >
-    open;
+    unsigned int generation = 0;
+
+    // Binary heap managed with std::push_heap/std::pop_heap, so that its storage is kept
+    std::vector< std::pair<int, tripoint> > open;
     std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
 
+    // Starts a new search, invalidating all data from the previous one
+    void reset( const int _minx, const int _miny, const int _maxx, const int _maxy ) {
+        minx = _minx;
+        miny = _miny;
+        maxx = _maxx;
+        maxy = _maxy;
+        open.clear();
+        generation++;
+        if( generation == 0 ) {
+            // Wrapped around: old stamps could now collide with new generations
+            for( auto &ptr : path_data ) {
+                if( ptr != nullptr ) {
+                    ptr->stamp.fill( 0 );
+                    ptr->generation = 0;
+                }
+            }
+            generation = 1;
+        }
+    }
+
     path_data_layer &get_layer( const int z ) {
         auto &ptr = path_data[z + OVERMAP_DEPTH];
-        if( ptr != nullptr ) {
-            return *ptr;
+        if( ptr == nullptr ) {
+            ptr = std::unique_ptr<path_data_layer>( new path_data_layer() );
         }
 
-        ptr = std::unique_ptr<path_data_layer>( new path_data_layer() );
-        ptr->init( minx, miny, maxx, maxy );
+        ptr->generation = generation;
         return *ptr;
     }
 
@@ -76,30 +121,38 @@ struct pathfinder {
     }
 
     tripoint get_next() {
-        auto pt = open.top();
-        open.pop();
-        return pt.second;
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp() );
+        const tripoint pt = open.back().second;
+        open.pop_back();
+        return pt;
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
         auto &layer = get_layer( to.z );
         const int index = flat_index( to.x, to.y );
-        if( ( layer.state[index] == ASL_OPEN && gscore >= layer.gscore[index] ) ||
-            layer.state[index] == ASL_CLOSED ) {
+        const astar_state state = layer.get_state( index );
+        if( ( state == ASL_OPEN && gscore >= layer.gscore[index] ) || state == ASL_CLOSED ) {
             return;
         }
 
-        layer.state [index] = ASL_OPEN;
+        layer.set_state( index, ASL_OPEN );
         layer.gscore[index] = gscore;
-        layer.parent[index] = from;
+        layer.parent[index] = pack_index( from.x, from.y, from.z );
         layer.score [index] = score;
-        open.push( std::make_pair( score, to ) );
+        open.push_back( std::make_pair( score, to ) );
+        std::push_heap( open.begin(), open.end(), pair_greater_cmp() );
     }
 
     void close_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
         const int index = flat_index( p.x, p.y );
-        layer.state[index] = ASL_CLOSED;
+        layer.set_state( index, ASL_CLOSED );
+    }
+
+    // Each thread gets its own workspace, allocated on first use
+    static pathfinder &get_instance() {
+        static thread_local pathfinder instance;
+        return instance;
     }
 };
 
@@ -131,6 +184,82 @@ tripoint vertical_move_destination( const map &m, const tripoint &t )
     return tripoint_min;
 }
 
+pathfinding_cache::pathfinding_cache()
+{
+    dirty = true;
+}
+
+const pathfinding_cache &map::get_pathfinding_cache_ref( const int zlev ) const
+{
+    const auto &cache = get_cache_ref( zlev ).pf_cache;
+    if( cache.dirty ) {
+        update_pathfinding_cache( zlev );
+    }
+
+    return cache;
+}
+
+void map::update_pathfinding_cache( const int zlev ) const
+{
+    // Caches are owned through pointers, so they can be updated from const methods
+    auto &cache = caches[zlev + OVERMAP_DEPTH]->pf_cache;
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            const auto cur_submap = get_submap_at_grid( smx, smy, zlev );
+            if( cur_submap == nullptr ) {
+                continue;
+            }
+
+            for( int sx = 0; sx < SEEX; ++sx ) {
+                for( int sy = 0; sy < SEEY; ++sy ) {
+                    const int x = sx + smx * SEEX;
+                    const int y = sy + smy * SEEY;
+                    const tripoint p( x, y, zlev );
+                    const maptile tile( cur_submap, sx, sy );
+                    const auto &terrain = tile.get_ter_t();
+                    const auto &furniture = tile.get_furn_t();
+                    int part = -1;
+                    const vehicle *veh = veh_at_internal( p, part );
+
+                    const int cost = move_cost_internal( furniture, terrain, veh, part );
+                    cache.move_cost[x][y] = std::min( cost, 255 );
+
+                    unsigned char special = PF_NORMAL;
+                    if( veh != nullptr ) {
+                        special |= PF_VEHICLE;
+                    }
+                    if( !terrain.open.empty() ) {
+                        special |= PF_DOOR;
+                    }
+                    // Pathing never bashes floors
+                    if( ( furniture.loadid != f_null && furniture.bash.str_max != -1 ) ||
+                        ( terrain.bash.str_max != -1 && !terrain.bash.bash_below ) ) {
+                        special |= PF_BASHABLE;
+                    }
+                    const auto &ter_trp = terrain.trap.obj();
+                    if( !ter_trp.is_benign() || !tile.get_trap_t().is_benign() ) {
+                        special |= PF_TRAP;
+                    }
+                    if( terrain.has_flag( TFLAG_CLIMBABLE ) || furniture.has_flag( TFLAG_CLIMBABLE ) ) {
+                        special |= PF_CLIMBABLE;
+                    }
+                    if( terrain.has_flag( TFLAG_SWIMMABLE ) || furniture.has_flag( TFLAG_SWIMMABLE ) ) {
+                        special |= PF_SWIMMABLE;
+                    }
+                    if( terrain.has_flag( TFLAG_GOES_DOWN ) || terrain.has_flag( TFLAG_GOES_UP ) ||
+                        terrain.has_flag( TFLAG_RAMP ) || terrain.has_flag( TFLAG_NO_FLOOR ) ) {
+                        special |= PF_UPDOWN;
+                    }
+
+                    cache.special[x][y] = special;
+                }
+            }
+        }
+    }
+
+    cache.dirty = false;
+}
+
 std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                   const int bash, const int maxdist ) const
 {
@@ -173,7 +302,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     clip_to_bounds( minx, miny, minz );
     clip_to_bounds( maxx, maxy, maxz );
 
-    pathfinder pf( minx, miny, maxx, maxy );
+    pathfinder &pf = pathfinder::get_instance();
+    pf.reset( minx, miny, maxx, maxy );
     pf.add_point( 0, 0, f, f );
     // Make NPCs not want to path through player
     // But don't make player pathing stop working
@@ -187,9 +317,10 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         auto cur = pf.get_next();
 
         const int parent_index = flat_index( cur.x, cur.y );
+        // The scores of cur are read from its layer, also when moving to another z-level
         auto &layer = pf.get_layer( cur.z );
-        auto &cur_state = layer.state[parent_index];
-        if( cur_state == ASL_CLOSED ) {
+        const auto &pf_cache = get_pathfinding_cache_ref( cur.z );
+        if( layer.get_state( parent_index ) == ASL_CLOSED ) {
             continue;
         }
 
@@ -203,7 +334,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             break;
         }
 
-        cur_state = ASL_CLOSED;
+        layer.set_state( parent_index, ASL_CLOSED );
 
         // 7 3 5
         // 1 . 2
@@ -219,7 +350,26 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 continue;
             }
 
-            if( layer.state[index] == ASL_CLOSED ) {
+            if( layer.get_state( index ) == ASL_CLOSED ) {
+                continue;
+            }
+
+            const int cost = pf_cache.move_cost[p.x][p.y];
+            const unsigned char special = pf_cache.special[p.x][p.y];
+            if( cost == 0 && ( bash == 0 || ( special & PF_BASHABLE ) == 0 ) &&
+                ( special & ( PF_DOOR | PF_VEHICLE ) ) == 0 ) {
+                layer.set_state( index, ASL_CLOSED ); // Close it so that next time we won't try to calc costs
+                continue;
+            }
+
+            const int diag_cost = ( cur.x != p.x && cur.y != p.y ) ? 1 : 0;
+            if( cost != 0 && ( special & PF_TRAP ) == 0 ) {
+                // Common case: passable tile with nothing special about it, cache has all we need
+                const int newg = layer.gscore[parent_index] + cost + diag_cost;
+                if( layer.get_state( index ) == ASL_NONE || newg < layer.gscore[index] ) {
+                    pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur, p );
+                }
+
                 continue;
             }
 
@@ -229,17 +379,16 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             const auto &furniture = tile.get_furn_t();
             const vehicle *veh = veh_at_internal( p, part );
 
-            const int cost = move_cost_internal( furniture, terrain, veh, part );
             // Don't calculate bash rating unless we intend to actually use it
             const int rating = ( bash == 0 || cost != 0 ) ? -1 :
                                bash_rating_internal( bash, furniture, terrain, false, veh, part );
 
             if( cost == 0 && rating <= 0 && terrain.open.empty() && veh == nullptr ) {
-                layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calc costs
+                layer.set_state( index, ASL_CLOSED ); // Close it so that next time we won't try to calc costs
                 continue;
             }
 
-            int newg = layer.gscore[parent_index] + cost + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
+            int newg = layer.gscore[parent_index] + cost + diag_cost;
             if( cost == 0 ) {
                 // Handle all kinds of doors
                 // Only try to open INSIDE doors from the inside
@@ -262,7 +411,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                     } else {
                         if( !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
                             // Won't be openable, don't try from other sides
-                            layer.state[index] = ASL_CLOSED;
+                            layer.set_state( index, ASL_CLOSED );
                         }
 
                         continue;
@@ -291,7 +440,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                         tripoint below( p.x, p.y, p.z - 1 );
                         if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
                             // Otherwise this would have been a huge fall
-                            auto &layer = pf.get_layer( p.z - 1 );
                             // From cur, not p, because we won't be walking on air
                             pf.add_point( layer.gscore[parent_index] + 10,
                                           layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
@@ -299,7 +447,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                         }
 
                         // Close p, because we won't be walking on it
-                        layer.state[index] = ASL_CLOSED;
+                        layer.set_state( index, ASL_CLOSED );
                         continue;
                     }
                     // Otherwise it's walkable
@@ -310,12 +458,12 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
             // If not visited, add as open
             // If visited, add it only if we can do so with better score
-            if( layer.state[index] == ASL_NONE || newg < layer.gscore[index] ) {
+            if( layer.get_state( index ) == ASL_NONE || newg < layer.gscore[index] ) {
                 pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur, p );
             }
         }
 
-        if( !has_zlevels() ) {
+        if( !has_zlevels() || ( pf_cache.special[cur.x][cur.y] & PF_UPDOWN ) == 0 ) {
             // The part below is only for z-level pathing
             continue;
         }
@@ -326,7 +474,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             tripoint dest( cur.x, cur.y, cur.z - 1 );
             dest = vertical_move_destination<TFLAG_GOES_UP>( *this, dest );
             if( inbounds( dest ) ) {
-                auto &layer = pf.get_layer( dest.z );
                 pf.add_point( layer.gscore[parent_index] + 2,
                               layer.score[parent_index] + 2 * rl_dist( dest, t ),
                               cur, dest );
@@ -336,7 +483,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             tripoint dest( cur.x, cur.y, cur.z + 1 );
             dest = vertical_move_destination<TFLAG_GOES_DOWN>( *this, dest );
             if( inbounds( dest ) ) {
-                auto &layer = pf.get_layer( dest.z );
                 pf.add_point( layer.gscore[parent_index] + 2,
                               layer.score[parent_index] + 2 * rl_dist( dest, t ),
                               cur, dest );
@@ -344,7 +490,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         }
         if( cur.z < maxz && parent_terrain.has_flag( TFLAG_RAMP ) &&
             valid_move( cur, tripoint( cur.x, cur.y, cur.z + 1 ), false, true ) ) {
-            auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
                 pf.add_point( layer.gscore[parent_index] + 4,
@@ -361,7 +506,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         for( int fdist = maxdist; fdist != 0; fdist-- ) {
             const int cur_index = flat_index( cur.x, cur.y );
             const auto &layer = pf.get_layer( cur.z );
-            const tripoint &par = layer.parent[cur_index];
+            const tripoint par = unpack_index( layer.parent[cur_index] );
             if( cur == f ) {
                 break;
             }
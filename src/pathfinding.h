@@ -0,0 +1,37 @@
+#ifndef PATHFINDING_H
+#define PATHFINDING_H
+
+#include "game_constants.h"
+
+/**
+ * Bits describing what makes a tile more interesting than its move cost.
+ * A tile with none of those set can be walked over by just paying the cost.
+ */
+enum pf_special : unsigned char {
+    PF_NORMAL = 0x00,    // Plain tile, only the move cost matters
+    PF_VEHICLE = 0x01,   // Contains a vehicle part
+    PF_DOOR = 0x02,      // Terrain can be opened
+    PF_BASHABLE = 0x04,  // Terrain or furniture can be bashed
+    PF_TRAP = 0x08,      // Terrain or tile has a trap that isn't benign
+    PF_CLIMBABLE = 0x20, // Has the CLIMBABLE flag
+    PF_SWIMMABLE = 0x40, // Has the SWIMMABLE flag
+    PF_UPDOWN = 0x80,    // Stairs, ramps and ledges, anything that leads to another z-level
+};
+
+/**
+ * Per z-level summary of the map used by pathfinding and monster movement,
+ * so that those don't need to look up submaps, vehicles and flags for every tile.
+ * Rebuilt lazily by @ref map::get_pathfinding_cache_ref when dirty.
+ */
+struct pathfinding_cache {
+    pathfinding_cache();
+
+    bool dirty;
+
+    // Same as map::move_cost, capped at 255
+    unsigned char move_cost[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    // Bitmask of pf_special values
+    unsigned char special[MAPSIZE * SEEX][MAPSIZE * SEEY];
+};
+
+#endif
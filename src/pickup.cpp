@@ -236,27 +236,19 @@ static bool select_autopickup_items( std::vector<item> &here, std::vector<pickup
             bPickup = false;
             if (here[i].volume() == (int)iVol) {
                 iNumChecked++;
-                const std::string sItemName = here[i].tname( 1, false );
+                const rule_state pickup_state = get_auto_pickup().check_item( here[i].tname( 1, false ) );
 
                 //Check the Pickup Rules
-                if ( get_auto_pickup().check_item(sItemName) == "true" ) {
+                if ( pickup_state == RULE_WHITELISTED ) {
                     bPickup = true;
-                } else if ( get_auto_pickup().check_item(sItemName) != "false" ) {
-                    //No prematched pickup rule found
-                    //items with damage, (fits) or a container
-                    get_auto_pickup().create_rules(sItemName);
-
-                    if ( get_auto_pickup().check_item(sItemName) == "true" ) {
-                        bPickup = true;
-                    }
                 }
 
                 //Auto Pickup all items with 0 Volume and Weight <= AUTO_PICKUP_ZERO * 50
-                //items will either be in the autopickup list ("true") or unmatched ("")
+                //items will either be in the autopickup list (whitelisted) or unmatched
                 if (!bPickup && OPTIONS["AUTO_PICKUP_ZERO"]) {
                     if (here[i].volume() == 0 &&
                         here[i].weight() <= OPTIONS["AUTO_PICKUP_ZERO"] * 50 &&
-                        get_auto_pickup().check_item(sItemName) != "false") {
+                        pickup_state != RULE_BLACKLISTED) {
                         bPickup = true;
                     }
                 }
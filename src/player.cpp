@@ -70,6 +70,9 @@
 #include <fstream>
 #include <limits>
 
+static const option<bool> option_rad_mutation( "RAD_MUTATION" );
+static const option<std::string> option_use_metric_speeds( "USE_METRIC_SPEEDS" );
+
 const mtype_id mon_dermatik_larva( "mon_dermatik_larva" );
 const mtype_id mon_player_blob( "mon_player_blob" );
 const mtype_id mon_shadow_snake( "mon_shadow_snake" );
@@ -3837,7 +3840,7 @@ void player::disp_status( WINDOW *w, WINDOW *w2 )
         int speedox = sideStyle ? 0 : 33;
         int speedoy = sideStyle ? 5 :  3;
 
-        bool metric = OPTIONS["USE_METRIC_SPEEDS"] == "km/h";
+        bool metric = option_use_metric_speeds.get() == "km/h";
         // Logic below is not applicable to translated units and should be changed
         int velx    = metric ? 4 : 3; // strlen(units) + 1
         int cruisex = metric ? 9 : 8; // strlen(units) + 6
@@ -8328,7 +8331,7 @@ void player::suffer()
         } else if (radiation > 2000) {
             radiation = 2000;
         }
-        if (OPTIONS["RAD_MUTATION"] && rng(60, 2500) < radiation) {
+        if (option_rad_mutation && rng(60, 2500) < radiation) {
             mutate();
             radiation /= 2;
             radiation -= 5;
@@ -9447,11 +9450,12 @@ int player::amount_of(const itype_id &it) const
     if (it == "apparatus") {
         return ( has_items_with_quality("SMOKE_PIPE", 1, 1) ? 1 : 0 );
     }
-    int quantity = weapon.amount_of(it, true);
+    const itype_iid iid = intern_itype_id( it );
+    int quantity = weapon.amount_of( iid, true );
     for( const auto &elem : worn ) {
-        quantity += elem.amount_of( it, true );
+        quantity += elem.amount_of( iid, true );
     }
-    quantity += inv.amount_of(it);
+    quantity += inv.amount_of( iid, true );
     return quantity;
 }
 
@@ -9490,11 +9494,12 @@ long player::charges_of(const itype_id &it) const
         return charges_of( "UPS_off" );
     }
     // Now regular charges from all items (weapone,worn,inventory)
-    long quantity = weapon.charges_of(it);
+    const itype_iid iid = intern_itype_id( it );
+    long quantity = weapon.charges_of( iid );
     for( const auto &armor : worn ) {
-        quantity += armor.charges_of(it);
+        quantity += armor.charges_of( iid );
     }
-    quantity += inv.charges_of(it);
+    quantity += inv.charges_of( iid );
     // Now include charges from advanced UPS if the request was UPS
     if ( it == "UPS_off" ) {
         // Round charges from adv. UPS down, if this reports there are N
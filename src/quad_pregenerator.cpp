@@ -0,0 +1,101 @@
+#include "quad_pregenerator.h"
+
+#include "coordinate_conversions.h"
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+#include "mapbuffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+quad_pregenerator quad_pregen;
+
+const int quad_pregenerator::max_quads_per_turn;
+
+// How far ahead to look, the faster the player moves the more quads that are
+static const int lookahead_turns = 5;
+
+int quad_pregenerator::process( const tripoint &abs_pos, const int facing, const bool all_zlevels,
+                                const int budget )
+{
+    // Teleporting, falling and such tell nothing about where the player is going
+    if( has_last_pos && abs_pos.z == last_pos.z &&
+        square_dist( abs_pos, last_pos ) <= MAPSIZE * SEEX ) {
+        velocity_x = ( velocity_x + abs_pos.x - last_pos.x ) / 2;
+        velocity_y = ( velocity_y + abs_pos.y - last_pos.y ) / 2;
+    } else {
+        velocity_x = 0.0;
+        velocity_y = 0.0;
+    }
+    has_last_pos = true;
+    last_pos = abs_pos;
+    if( budget <= 0 ) {
+        return 0;
+    }
+
+    double dx = velocity_x;
+    double dy = velocity_y;
+    if( facing >= 0 ) {
+        // Vehicles turn before the player has moved that way
+        const double speed = std::sqrt( dx * dx + dy * dy );
+        dx = speed * std::cos( facing * M_PI / 180 );
+        dy = speed * std::sin( facing * M_PI / 180 );
+    }
+
+    // The z-level of the player first, as that is the one they see
+    std::vector<int> zlevels( 1, abs_pos.z );
+    if( all_zlevels ) {
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            if( z != abs_pos.z ) {
+                zlevels.push_back( z );
+            }
+        }
+    }
+    const int max_generated = std::min( budget, max_quads_per_turn );
+    const std::vector<tripoint> ahead = predict( abs_pos, dx, dy, lookahead_turns );
+    int generated = 0;
+    for( const int z : zlevels ) {
+        for( const tripoint &omt : ahead ) {
+            if( generated >= max_generated ) {
+                return generated;
+            }
+            const tripoint sm_pos = omt_to_sm_copy( tripoint( omt.x, omt.y, z ) );
+            if( MAPBUFFER.lookup_submap( sm_pos ) == nullptr ) {
+                map::generate_quad( sm_pos );
+                generated++;
+            }
+        }
+    }
+    return generated;
+}
+
+std::vector<tripoint> quad_pregenerator::predict( const tripoint &abs_pos, const double dx,
+        const double dy, const int turns )
+{
+    std::vector<tripoint> result;
+    const double speed = std::sqrt( dx * dx + dy * dy );
+    if( speed < 0.5 ) {
+        return result;
+    }
+    const double ahead_x = dx / speed;
+    const double ahead_y = dy / speed;
+    // The reality bubble reaches this far from the player in every direction
+    const int half_bubble = MAPSIZE * SEEX / 2;
+    const int max_distance = half_bubble + std::max<int>( 2 * SEEX, speed * turns );
+
+    // Sample every half quad on lines across the heading, so no quad gets skipped
+    for( int distance = half_bubble; distance <= max_distance; distance += SEEX ) {
+        for( int side = 0; side <= half_bubble; side += SEEX ) {
+            for( const int sign : { 1, -1 } ) {
+                const int x = abs_pos.x + std::lround( ahead_x * distance - ahead_y * side * sign );
+                const int y = abs_pos.y + std::lround( ahead_y * distance + ahead_x * side * sign );
+                const tripoint omt = ms_to_omt_copy( tripoint( x, y, abs_pos.z ) );
+                if( std::find( result.begin(), result.end(), omt ) == result.end() ) {
+                    result.push_back( omt );
+                }
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,58 @@
+#ifndef QUAD_PREGENERATOR_H
+#define QUAD_PREGENERATOR_H
+
+#include "enums.h"
+#include "game_constants.h"
+
+#include <vector>
+
+/**
+ * Generates the quads (2x2 submaps, one overmap terrain) the player is about to bring into
+ * the reality bubble, a few each turn. Otherwise @ref map::loadn has to generate a whole row
+ * of them at once when the map shifts, which is noticeable when driving into unexplored terrain.
+ *
+ * Where the player is heading is guessed from how they moved during the last turns
+ * and the direction of the vehicle they are in. Generated quads go to @ref MAPBUFFER,
+ * where @ref map::loadn finds them like any other.
+ */
+class quad_pregenerator
+{
+    private:
+        bool has_last_pos = false;
+        tripoint last_pos;
+        // Map squares per turn, averaged over the last few turns
+        double velocity_x = 0.0;
+        double velocity_y = 0.0;
+
+    public:
+        /**
+         * Most quads generated in one turn, whatever the budget. A map shift by one submap
+         * brings in a row of MAPSIZE submaps, which is about this many quads of one z-level.
+         */
+        static const int max_quads_per_turn = ( MAPSIZE + 1 ) / 2;
+
+        /**
+         * Records the position of the player and generates up to budget of the missing quads
+         * they are heading into, those on the z-level of the player first. Call once per turn.
+         * The generation runs on the calling thread, as mapgen isn't safe to run beside the game.
+         * @param abs_pos Absolute map square of the player.
+         * @param facing Direction the vehicle of the player is facing in degrees, -1 if not driving.
+         * @param all_zlevels Whether to generate all z-levels of the quads, not just the one of abs_pos.
+         * @param budget How many quads may be generated, each z-level of one counts on its own.
+         * Capped at @ref max_quads_per_turn.
+         * @return The number of quads generated.
+         */
+        int process( const tripoint &abs_pos, int facing, bool all_zlevels, int budget );
+
+        /**
+         * Overmap terrain coordinates of the quads that come into the reality bubble within
+         * about the given number of turns when moving from abs_pos with the given number of
+         * map squares per turn, nearest first.
+         */
+        static std::vector<tripoint> predict( const tripoint &abs_pos, double dx, double dy,
+                                              int turns );
+};
+
+extern quad_pregenerator quad_pregen;
+
+#endif
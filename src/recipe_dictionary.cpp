@@ -40,14 +40,14 @@ void recipe_dictionary::delete_if( const std::function<bool( recipe & )> &pred )
 
 void recipe_dictionary::add_to_component_lookup( recipe *r )
 {
-    std::unordered_set<itype_id> counted;
+    std::unordered_set<itype_iid> counted;
     for( const auto &comp_choices : r->requirements.get_components() ) {
         for( const item_comp &comp : comp_choices ) {
-            if( counted.count( comp.type ) ) {
+            if( counted.count( comp.type_iid ) ) {
                 continue;
             }
-            counted.insert( comp.type );
-            by_component[comp.type].push_back( r );
+            counted.insert( comp.type_iid );
+            by_component[comp.type_iid].push_back( r );
         }
     }
 }
@@ -78,5 +78,5 @@ const std::vector<recipe *> &recipe_dictionary::in_category( const std::string &
 
 const std::vector<recipe *> &recipe_dictionary::of_component( const itype_id &id )
 {
-    return by_component[id];
+    return by_component[intern_itype_id( id )];
 }
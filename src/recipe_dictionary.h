@@ -1,11 +1,14 @@
 #ifndef RECIPE_DICTIONARY_H
 #define RECIPE_DICTIONARY_H
 
+#include "itype_iid.h"
+
 #include <string>
 #include <vector>
 #include <map>
 #include <list>
 #include <functional>
+#include <unordered_map>
 
 struct recipe;
 using itype_id = std::string; // From itype.h
@@ -53,7 +56,7 @@ class recipe_dictionary
         std::list<recipe *> recipes;
 
         std::map<const std::string, std::vector<recipe *>> by_category;
-        std::map<const itype_id, std::vector<recipe *>> by_component;
+        std::unordered_map<itype_iid, std::vector<recipe *>> by_component;
 
         std::map<const std::string, recipe *> by_name;
 
@@ -95,6 +95,7 @@ void tool_comp::load( JsonArray &ja )
         type = comp.get_string( 0 );
         count = comp.get_int( 1 );
     }
+    type_iid = intern_itype_id( type );
     if( count == 0 ) {
         ja.throw_error( "tool count must not be 0" );
     }
@@ -105,6 +106,7 @@ void item_comp::load( JsonArray &ja )
 {
     JsonArray comp = ja.next_array();
     type = comp.get_string( 0 );
+    type_iid = intern_itype_id( type );
     count = comp.get_int( 1 );
     // Recoverable is true by default.
     if( comp.size() > 2 ) {
@@ -407,9 +409,9 @@ bool tool_comp::has( const inventory &crafting_inv, int batch ) const
         }
     }
     if( !by_charges() ) {
-        return crafting_inv.has_tools( type, std::abs( count ) );
+        return crafting_inv.has_tools( type_iid, std::abs( count ) );
     } else {
-        return crafting_inv.has_charges( type, count * batch );
+        return crafting_inv.has_charges( type_iid, count * batch );
     }
 }
 
@@ -422,9 +424,9 @@ std::string tool_comp::get_color( bool has_one, const inventory &crafting_inv, i
     }
     if( available == a_insufficent ) {
         return "brown";
-    } else if( !by_charges() && crafting_inv.has_tools( type, std::abs( count ) ) ) {
+    } else if( !by_charges() && crafting_inv.has_tools( type_iid, std::abs( count ) ) ) {
         return "green";
-    } else if( by_charges() && crafting_inv.has_charges( type, count * batch ) ) {
+    } else if( by_charges() && crafting_inv.has_charges( type_iid, count * batch ) ) {
         return "green";
     }
     return has_one ? "dkgray" : "red";
@@ -443,10 +445,10 @@ bool item_comp::has( const inventory &crafting_inv, int batch ) const
         }
     }
     const int cnt = std::abs( count ) * batch;
-    if( item::count_by_charges( type ) ) {
-        return crafting_inv.has_charges( type, cnt );
+    if( item::count_by_charges( type_iid ) ) {
+        return crafting_inv.has_charges( type_iid, cnt );
     } else {
-        return crafting_inv.has_components( type, cnt );
+        return crafting_inv.has_components( type_iid, cnt );
     }
 }
 
@@ -460,11 +462,11 @@ std::string item_comp::get_color( bool has_one, const inventory &crafting_inv, i
     const int cnt = std::abs( count ) * batch;
     if( available == a_insufficent ) {
         return "brown";
-    } else if( item::count_by_charges( type ) ) {
-        if( crafting_inv.has_charges( type, cnt ) ) {
+    } else if( item::count_by_charges( type_iid ) ) {
+        if( crafting_inv.has_charges( type_iid, cnt ) ) {
             return "green";
         }
-    } else if( crafting_inv.has_components( type, cnt ) ) {
+    } else if( crafting_inv.has_components( type_iid, cnt ) ) {
         return "green";
     }
     return has_one ? "dkgray" : "red";
@@ -7,6 +7,7 @@
 #include <memory>
 #include "color.h"
 #include "output.h"
+#include "itype_iid.h"
 
 class JsonObject;
 class JsonArray;
@@ -38,19 +39,23 @@ struct quality {
 
 struct component {
     itype_id type;
+    /** The interned @ref type, the inventory is checked with it. */
+    itype_iid type_iid;
     int count;
     // -1 means the player doesn't have the item, 1 means they do,
     // 0 means they have item but not enough for both tool and component
     mutable available_status available;
     bool recoverable;
 
-    component() : type( "null" ) , count( 0 ) , available( a_false ), recoverable( true ) {
-    }
-    component( const itype_id &TYPE, int COUNT ) : type( TYPE ), count( COUNT ), available( a_false ),
+    component() : type( "null" ), type_iid( intern_itype_id( type ) ), count( 0 ), available( a_false ),
         recoverable( true ) {
     }
-    component( const itype_id &TYPE, int COUNT, bool RECOVERABLE ) : type( TYPE ), count( COUNT ),
-        available( a_false ), recoverable( RECOVERABLE ) {
+    component( const itype_id &TYPE, int COUNT ) : type( TYPE ), type_iid( intern_itype_id( TYPE ) ),
+        count( COUNT ), available( a_false ), recoverable( true ) {
+    }
+    component( const itype_id &TYPE, int COUNT, bool RECOVERABLE ) : type( TYPE ),
+        type_iid( intern_itype_id( TYPE ) ), count( COUNT ), available( a_false ),
+        recoverable( RECOVERABLE ) {
     }
     void check_consistency( const std::string &display_name ) const;
 };
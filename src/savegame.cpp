@@ -825,8 +825,8 @@ void overmap::serialize( std::ofstream &fout ) const
 
     json.member("mongroups");
     json.start_array();
-    for( const auto &group : zg ) {
-        json.write(group.second);
+    for( const mongroup &group : zg ) {
+        json.write( group );
     }
     json.end_array();
     fout << std::endl;
@@ -0,0 +1,118 @@
+#include "scent_map.h"
+
+#include "debug.h"
+#include "enums.h"
+
+#include <algorithm>
+#include <climits>
+
+#define dbg(x) DebugLog((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
+
+scent_cache::scent_cache()
+{
+    dirty = true;
+}
+
+void diffuse_scent( scent_grid &grid, const scent_cache &cache, const point &center,
+                    const int radius )
+{
+    const int minx = center.x - radius;
+    const int maxx = center.x + radius;
+    const int miny = center.y - radius;
+    const int maxy = center.y + radius;
+
+    // Find the scent that can spread into the square, including its border.
+    // Game code writes to the scent map freely, so this is cheaper than keeping track.
+    int active_minx = INT_MAX;
+    int active_maxx = INT_MIN;
+    int active_miny = INT_MAX;
+    int active_maxy = INT_MIN;
+    for( int x = minx - 1; x <= maxx + 1; ++x ) {
+        const int *const column = grid[x];
+        int any = 0;
+        for( int y = miny - 1; y <= maxy + 1; ++y ) {
+            any |= column[y];
+        }
+        if( any == 0 ) {
+            continue;
+        }
+        int first = miny - 1;
+        while( column[first] == 0 ) {
+            first++;
+        }
+        int last = maxy + 1;
+        while( column[last] == 0 ) {
+            last--;
+        }
+        active_minx = std::min( active_minx, x );
+        active_maxx = x;
+        active_miny = std::min( active_miny, first );
+        active_maxy = std::max( active_maxy, last );
+    }
+    if( active_minx > active_maxx ) {
+        return;
+    }
+
+    // Tiles with no scent on them or next to them stay at 0
+    const int x0 = std::max( minx, active_minx - 1 );
+    const int x1 = std::min( maxx, active_maxx + 1 );
+    const int y0 = std::max( miny, active_miny - 1 );
+    const int y1 = std::min( maxy, active_maxy + 1 );
+
+    // Sums of the weights and weighted scents of each tile and its 2 neighbours in the y direction.
+    // The x direction is summed up below, so each tile is visited 3 times instead of 9.
+    int sum_weight[SEEX * MAPSIZE][SEEY * MAPSIZE];
+    int sum_scent[SEEX * MAPSIZE][SEEY * MAPSIZE];
+    for( int x = x0 - 1; x <= x1 + 1; ++x ) {
+        const unsigned char *const weight = cache.weight[x];
+        const int *const scent = grid[x];
+        int *const sw = sum_weight[x];
+        int *const ss = sum_scent[x];
+        for( int y = y0; y <= y1; ++y ) {
+            sw[y] = weight[y - 1] + weight[y] + weight[y + 1];
+            ss[y] = weight[y - 1] * scent[y - 1] + weight[y] * scent[y] + weight[y + 1] * scent[y + 1];
+        }
+    }
+
+    int highest = 0;
+    for( int x = x0; x <= x1; ++x ) {
+        const unsigned char *const weight = cache.weight[x];
+        const int *const sw_prev = sum_weight[x - 1];
+        const int *const sw = sum_weight[x];
+        const int *const sw_next = sum_weight[x + 1];
+        const int *const ss_prev = sum_scent[x - 1];
+        const int *const ss = sum_scent[x];
+        const int *const ss_next = sum_scent[x + 1];
+        int *const scent = grid[x];
+        for( int y = y0; y <= y1; ++y ) {
+            // 100 on open ground, 20 on REDUCE_SCENT. This is essentially a decimal number * 1000.
+            const int diffusivity = weight[y] * 10;
+            // To how many neighbouring squares do we diffuse out, counting our own square
+            const int squares_used = sw_prev[y] + sw[y] + sw_next[y];
+            // Take the old scent and subtract what diffuses out
+            int temp_scent = scent[y] * ( 10 * 1000 - squares_used * diffusivity );
+            // Neighbouring walls and REDUCE_SCENT squares absorb some scent
+            temp_scent -= scent[y] * diffusivity * ( 90 - squares_used ) / 5;
+            // And add what diffuses in
+            const int result = ( temp_scent + diffusivity * ( ss_prev[y] + ss[y] + ss_next[y] ) ) /
+                               ( 1000 * 10 );
+            // Squares that block scent never hold any
+            scent[y] = result * ( weight[y] != SCENT_BLOCKED );
+            highest = std::max( highest, scent[y] );
+        }
+    }
+
+    if( highest <= 10000 ) {
+        return;
+    }
+    for( int x = x0; x <= x1; ++x ) {
+        for( int y = y0; y <= y1; ++y ) {
+            if( grid[x][y] > 10000 ) {
+                dbg( D_ERROR ) << "diffuse_scent: Wacky scent at " << x << ","
+                               << y << " (" << grid[x][y] << ")";
+                debugmsg( "Wacky scent at %d, %d (%d)", x, y, grid[x][y] );
+                grid[x][y] = 0; // Scent should never be higher
+            }
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef SCENT_MAP_H
+#define SCENT_MAP_H
+
+#include "game_constants.h"
+
+struct point;
+
+/**
+ * How much scent a tile lets through, relative to open ground.
+ * Both the share of the neighbouring scent that spreads into the tile and
+ * how fast scent leaves it are proportional to this.
+ */
+enum scent_weight : unsigned char {
+    SCENT_BLOCKED = 0,  // Walls, scent never gets there
+    SCENT_REDUCED = 2,  // REDUCE_SCENT terrain or furniture, vehicle obstacles and closed doors
+    SCENT_NORMAL = 10,  // Everything else
+};
+
+/**
+ * Per z-level scent weights of the map, so that scent diffusion doesn't need to look
+ * up terrain, furniture and vehicles every turn.
+ * Rebuilt lazily by @ref map::get_scent_cache_ref when dirty.
+ */
+struct scent_cache {
+    scent_cache();
+
+    bool dirty;
+
+    // One of scent_weight for every tile
+    unsigned char weight[MAPSIZE * SEEX][MAPSIZE * SEEY];
+};
+
+typedef int scent_grid[MAPSIZE * SEEX][MAPSIZE * SEEY];
+
+/**
+ * Spreads the scent in the square of given radius around center by one turn.
+ * Only the part of that square with scent on it or next to it is processed.
+ * The square and its 1 tile border must be inside the grid.
+ */
+void diffuse_scent( scent_grid &grid, const scent_cache &cache, const point &center, int radius );
+
+#endif
@@ -9,6 +9,7 @@
 #include "translations.h"
 #include "messages.h"
 #include "monster.h"
+#include "creature_tracker.h"
 #include "line.h"
 #include "mtype.h"
 #include "weather.h"
@@ -19,6 +20,7 @@
 #include "options.h"
 #include "time.h"
 #include "mapdata.h"
+#include "turn_profiler.h"
 #include <chrono>
 #ifdef SDL_SOUND
 #   include <SDL_mixer.h>
@@ -159,6 +161,7 @@ static std::vector<centroid> cluster_sounds( std::vector<std::pair<tripoint, int
 
 void sounds::process_sounds()
 {
+    PROFILE_SECTION( PROFILE_SOUNDS );
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
     const int weather_vol = weather_data( g->weather ).sound_attn;
     for( const auto &this_centroid : sound_clusters ) {
@@ -179,13 +182,9 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for (int i = 0, numz = g->num_zombies(); i < numz; i++) {
-            monster &critter = g->zombie(i);
-            const int dist = rl_dist( source, critter.pos() );
-            if( vol * 2 > dist ) {
-                // Exclude monsters that certainly won't hear the sound
-                critter.hear_sound( source, vol, dist );
-            }
+        // Monsters further than that certainly won't hear the sound.
+        for( monster *critter : g->critter_tracker->find_near( source, vol * 2 - 1 ) ) {
+            critter->hear_sound( source, vol, rl_dist( source, critter->pos() ) );
         }
     }
     recent_sounds.clear();
@@ -12,6 +12,7 @@
 #include "active_item_cache.h"
 
 #include <vector>
+#include <bitset>
 #include <list>
 #include <map>
 #include <string>
@@ -168,6 +169,15 @@ struct submap {
     active_item_cache active_items;
 
     int field_count = 0;
+    /**
+     * Squares that may have fields on them, bit x * SEEY + y is square (x, y).
+     * Set whenever a field is added, cleared again by field processing once the
+     * square is empty, so it can only have too many bits set, never too few.
+     */
+    std::bitset<SEEX * SEEY> field_tiles;
+    void mark_field_tile( const int x, const int y ) {
+        field_tiles.set( x * SEEY + y );
+    }
     int turn_last_touched = 0;
     int temperature = 0;
     std::vector<spawn_point> spawns;
@@ -247,6 +257,7 @@ public:
         const bool ret = sm->fld[x][y].addField( field_to_add, new_density, new_age );
         if( ret ) {
             sm->field_count++;
+            sm->mark_field_tile( x, y );
         }
 
         return ret;
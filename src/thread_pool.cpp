@@ -0,0 +1,102 @@
+#include "thread_pool.h"
+
+#include <array>
+#include <memory>
+
+thread_pool::thread_pool( const size_t worker_count ) : next_index( 0 )
+{
+    workers.reserve( worker_count );
+    for( size_t i = 0; i < worker_count; i++ ) {
+        workers.emplace_back( &thread_pool::worker_loop, this );
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    job_ready.notify_all();
+    for( auto &worker : workers ) {
+        worker.join();
+    }
+}
+
+size_t thread_pool::size() const
+{
+    return workers.size();
+}
+
+void thread_pool::run_current_job()
+{
+    for( size_t i = next_index++; i < job_size; i = next_index++ ) {
+        ( *job )( i );
+    }
+}
+
+void thread_pool::worker_loop()
+{
+    unsigned int seen_generation = 0;
+    while( true ) {
+        {
+            std::unique_lock<std::mutex> lock( mutex );
+            job_ready.wait( lock, [this, seen_generation]() {
+                return stopping || job_generation != seen_generation;
+            } );
+            if( stopping ) {
+                return;
+            }
+            seen_generation = job_generation;
+        }
+
+        run_current_job();
+
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            busy_workers--;
+        }
+        job_done.notify_one();
+    }
+}
+
+void thread_pool::parallel_for( const size_t count, const std::function<void( size_t )> &func )
+{
+    if( workers.empty() || count < 2 ) {
+        for( size_t i = 0; i < count; i++ ) {
+            func( i );
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        job = &func;
+        job_size = count;
+        next_index = 0;
+        busy_workers = workers.size();
+        job_generation++;
+    }
+    job_ready.notify_all();
+
+    run_current_job();
+
+    std::unique_lock<std::mutex> lock( mutex );
+    job_done.wait( lock, [this]() {
+        return busy_workers == 0;
+    } );
+    job = nullptr;
+    job_size = 0;
+}
+
+thread_pool &get_thread_pool( const pool_purpose purpose, const size_t workers )
+{
+    static std::array<std::unique_ptr<thread_pool>,
+           static_cast<size_t>( pool_purpose::num_purposes )> pools;
+    std::unique_ptr<thread_pool> &pool = pools[static_cast<size_t>( purpose )];
+    if( pool == nullptr || pool->size() != workers ) {
+        pool.reset( new thread_pool( workers ) );
+    }
+
+    return *pool;
+}
@@ -0,0 +1,71 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of worker threads for splitting up read-only per-turn work.
+ *
+ * Jobs are submitted with @ref parallel_for, which blocks until all of the work is done,
+ * so callers never have to deal with futures or worry about work outliving the turn.
+ * The calling thread takes part in the work, so a pool with 0 workers simply runs
+ * everything on the calling thread.
+ */
+class thread_pool
+{
+    public:
+        explicit thread_pool( size_t workers );
+        ~thread_pool();
+
+        thread_pool( const thread_pool & ) = delete;
+        thread_pool &operator=( const thread_pool & ) = delete;
+
+        /** Number of worker threads, not counting the calling thread. */
+        size_t size() const;
+
+        /**
+         * Calls `func( i )` for every i in [0, count), spread over all threads.
+         * Returns once every call has finished. Not reentrant.
+         */
+        void parallel_for( size_t count, const std::function<void( size_t )> &func );
+
+    private:
+        void worker_loop();
+        void run_current_job();
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable job_ready;
+        std::condition_variable job_done;
+
+        const std::function<void( size_t )> *job = nullptr;
+        size_t job_size = 0;
+        // Incremented for each job, so that workers can tell a new job from a spurious wakeup
+        unsigned int job_generation = 0;
+        size_t busy_workers = 0;
+        bool stopping = false;
+
+        std::atomic<size_t> next_index;
+};
+
+/** The kinds of work that keep a pool around between turns, each one gets its own pool. */
+enum class pool_purpose : int {
+    monster_planning,
+    horde_movement,
+    field_of_view,
+    num_purposes
+};
+
+/**
+ * Returns the shared pool for the purpose, recreated with the given number of workers
+ * whenever that differs from the last call, e.g. because the thread option changed.
+ * Only to be called from the main thread.
+ */
+thread_pool &get_thread_pool( pool_purpose purpose, size_t workers );
+
+#endif
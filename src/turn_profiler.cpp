@@ -0,0 +1,176 @@
+#include "turn_profiler.h"
+
+#include "debug.h"
+#include "options.h"
+#include "output.h"
+#include "path_info.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+
+turn_sample turn_profiler::current;
+
+// The kept samples, next_sample is overwritten next
+static turn_sample samples[turn_profiler::kept_turns];
+static size_t next_sample = 0;
+static size_t stored_samples = 0;
+
+static bool show_overlay = false;
+
+static std::unique_ptr<std::ofstream> csv;
+
+static const option<bool> option_profile_csv( "PROFILE_CSV" );
+
+static long long microseconds( const std::chrono::steady_clock::duration time )
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>( time ).count();
+}
+
+// Opens the file when streaming starts, closes it when it stops
+static std::ofstream *get_csv()
+{
+    if( !option_profile_csv ) {
+        csv.reset();
+        return nullptr;
+    }
+    if( !csv ) {
+        const std::string &path = FILENAMES["profilecsv"];
+        csv.reset( new std::ofstream( path.c_str(), std::ios::app ) );
+        if( !csv->is_open() ) {
+            DebugLog( D_WARNING, D_MAIN ) << "Can't write the turn profile to " << path;
+            csv.reset();
+            OPTIONS["PROFILE_CSV"].setValue( "false" );
+            return nullptr;
+        }
+        if( csv->tellp() == 0 ) {
+            *csv << "turn";
+            for( int i = 0; i < NUM_PROFILE_SECTIONS; i++ ) {
+                *csv << "," << turn_profiler::section_name( profile_section( i ) ) << "_us";
+            }
+            for( int i = 0; i < NUM_PROFILE_COUNTERS; i++ ) {
+                *csv << "," << turn_profiler::counter_name( profile_counter( i ) );
+            }
+            *csv << "\n";
+        }
+    }
+    return csv.get();
+}
+
+void turn_profiler::end_turn( const int turn )
+{
+    current.turn = turn;
+    if( std::ofstream *out = get_csv() ) {
+        *out << turn;
+        for( const auto &time : current.times ) {
+            *out << "," << microseconds( time );
+        }
+        for( const int counter : current.counters ) {
+            *out << "," << counter;
+        }
+        // Flushed once in a while, so the file can be watched while playing
+        if( turn % 10 == 0 ) {
+            *out << std::endl;
+        } else {
+            *out << "\n";
+        }
+    }
+    samples[next_sample] = current;
+    next_sample = ( next_sample + 1 ) % kept_turns;
+    stored_samples = std::min( stored_samples + 1, kept_turns );
+    current = turn_sample();
+}
+
+std::vector<turn_sample> turn_profiler::recent_samples()
+{
+    std::vector<turn_sample> result;
+    for( size_t i = kept_turns - stored_samples; i < kept_turns; i++ ) {
+        result.push_back( samples[( next_sample + i ) % kept_turns] );
+    }
+    return result;
+}
+
+void turn_profiler::clear()
+{
+    next_sample = 0;
+    stored_samples = 0;
+    current = turn_sample();
+}
+
+std::string turn_profiler::section_name( const profile_section section )
+{
+    switch( section ) {
+        case PROFILE_SCENT:
+            return "scent";
+        case PROFILE_VEHICLES:
+            return "vehicles";
+        case PROFILE_FIELDS:
+            return "fields";
+        case PROFILE_ACTIVE_ITEMS:
+            return "active_items";
+        case PROFILE_SOUNDS:
+            return "sounds";
+        case PROFILE_MAP_CACHE:
+            return "map_cache";
+        case PROFILE_MONSTERS:
+            return "monsters";
+        case PROFILE_STAIR_MONSTERS:
+            return "stair_monsters";
+        case NUM_PROFILE_SECTIONS:
+            break;
+    }
+    return "unknown";
+}
+
+std::string turn_profiler::counter_name( const profile_counter counter )
+{
+    switch( counter ) {
+        case PROFILE_MONSTER_MOVES:
+            return "monster_moves";
+        case PROFILE_FIELDS_PROCESSED:
+            return "fields_processed";
+        case PROFILE_LIGHT_CASTS:
+            return "light_casts";
+        case NUM_PROFILE_COUNTERS:
+            break;
+    }
+    return "unknown";
+}
+
+bool turn_profiler::overlay_shown()
+{
+    return show_overlay;
+}
+
+void turn_profiler::toggle_overlay()
+{
+    show_overlay = !show_overlay;
+}
+
+void turn_profiler::draw_overlay( WINDOW *w )
+{
+    const std::vector<turn_sample> kept = recent_samples();
+    const double turns = std::max<size_t>( kept.size(), 1 );
+    int line = 0;
+    mvwprintz( w, line++, 0, c_white, "%-18s%10d", "turns", int( kept.size() ) );
+    double total = 0;
+    for( int i = 0; i < NUM_PROFILE_SECTIONS; i++ ) {
+        long long sum = 0;
+        for( const turn_sample &sample : kept ) {
+            sum += microseconds( sample.times[i] );
+        }
+        const double ms = sum / turns / 1000.0;
+        total += ms;
+        mvwprintz( w, line++, 0, c_ltgray, "%-18s%7.2f ms", section_name( profile_section( i ) ).c_str(),
+                   ms );
+    }
+    mvwprintz( w, line++, 0, c_white, "%-18s%7.2f ms", "total", total );
+    for( int i = 0; i < NUM_PROFILE_COUNTERS; i++ ) {
+        long long sum = 0;
+        for( const turn_sample &sample : kept ) {
+            sum += sample.counters[i];
+        }
+        mvwprintz( w, line++, 0, c_ltgray, "%-18s%10.1f", counter_name( profile_counter( i ) ).c_str(),
+                   sum / turns );
+    }
+}
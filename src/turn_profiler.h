@@ -0,0 +1,110 @@
+#ifndef TURN_PROFILER_H
+#define TURN_PROFILER_H
+
+#include "cursesdef.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * The parts of a game turn whose time is measured. The time of a part is taken in the function
+ * that does it, so it includes calls of that function from outside of game::do_turn.
+ */
+enum profile_section : int {
+    PROFILE_SCENT,
+    PROFILE_VEHICLES,
+    PROFILE_FIELDS,
+    PROFILE_ACTIVE_ITEMS,
+    PROFILE_SOUNDS,
+    PROFILE_MAP_CACHE,
+    PROFILE_MONSTERS,
+    PROFILE_STAIR_MONSTERS,
+    NUM_PROFILE_SECTIONS
+};
+
+/** What is counted during a turn, to put the times in relation. */
+enum profile_counter : int {
+    PROFILE_MONSTER_MOVES,
+    PROFILE_FIELDS_PROCESSED,
+    PROFILE_LIGHT_CASTS,
+    NUM_PROFILE_COUNTERS
+};
+
+/** Everything measured during one turn. */
+struct turn_sample {
+    int turn = 0;
+    std::chrono::steady_clock::duration times[NUM_PROFILE_SECTIONS] = {};
+    int counters[NUM_PROFILE_COUNTERS] = {};
+};
+
+/**
+ * Measures the parts of each game turn. The measurements go into the sample of the current turn,
+ * game::do_turn finishes it with @ref end_turn. The last turns are kept to be shown in an overlay
+ * (see the debug menu), with the PROFILE_CSV option each turn is also written to a CSV file.
+ *
+ * Only the main thread may measure. Use the PROFILE_SECTION and PROFILE_COUNT macros, they are
+ * left out of builds with CATA_NO_PROFILER defined.
+ */
+namespace turn_profiler
+{
+/** Number of turns kept by @ref recent_samples. */
+constexpr size_t kept_turns = 100;
+
+/** The sample being measured. */
+extern turn_sample current;
+
+inline void add_time( const profile_section section, const std::chrono::steady_clock::duration time )
+{
+    current.times[section] += time;
+}
+
+inline void count( const profile_counter counter, const int amount )
+{
+    current.counters[counter] += amount;
+}
+
+/** Adds the time from its construction to its destruction to a section. */
+class scoped_timer
+{
+    public:
+        scoped_timer( const profile_section section ) : section( section ),
+            start( std::chrono::steady_clock::now() ) {
+        }
+        ~scoped_timer() {
+            add_time( section, std::chrono::steady_clock::now() - start );
+        }
+    private:
+        profile_section section;
+        std::chrono::steady_clock::time_point start;
+};
+
+/** Keeps the current sample as the one of the turn, and starts the next. */
+void end_turn( int turn );
+/** The kept samples, oldest first. */
+std::vector<turn_sample> recent_samples();
+/** Forgets the kept samples and the current one. */
+void clear();
+
+std::string section_name( profile_section section );
+std::string counter_name( profile_counter counter );
+
+bool overlay_shown();
+void toggle_overlay();
+/** Draws the averages of the kept samples into the top left corner of the window. */
+void draw_overlay( WINDOW *w );
+}
+
+#ifndef CATA_NO_PROFILER
+#define PROFILE_CONCAT_INNER( a, b ) a##b
+#define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_INNER( a, b )
+/** Measures the time until the end of the enclosing scope as part of the section. */
+#define PROFILE_SECTION( section ) \
+    turn_profiler::scoped_timer PROFILE_CONCAT( profile_timer_, __LINE__ )( section )
+#define PROFILE_COUNT( counter, amount ) turn_profiler::count( counter, amount )
+#else
+#define PROFILE_SECTION( section )
+#define PROFILE_COUNT( counter, amount )
+#endif
+
+#endif
@@ -392,13 +392,17 @@ void vehicle_prototype::finalize()
         vehicle_prototype &proto = vp.second;
         const vproto_id &id = vp.first;
 
-        // Calls the default constructor to create an empty vehicle. Calling the constructor with
-        // the type as parameter would make it look up the type in the map and copy the
-        // (non-existing) blueprint.
-        proto.blueprint.reset( new vehicle() );
+        // The blueprint may have been read from the data cache already
+        const bool cached = proto.blueprint != nullptr;
+        if( !cached ) {
+            // Calls the default constructor to create an empty vehicle. Calling the constructor with
+            // the type as parameter would make it look up the type in the map and copy the
+            // (non-existing) blueprint.
+            proto.blueprint.reset( new vehicle() );
+            proto.blueprint->type = id;
+            proto.blueprint->name = _(proto.name.c_str());
+        }
         vehicle &blueprint = *proto.blueprint;
-        blueprint.type = id;
-        blueprint.name = _(proto.name.c_str());
 
         for( auto &part : proto.parts ) {
             const point &p = part.first;
@@ -408,7 +412,7 @@ void vehicle_prototype::finalize()
                 continue;
             }
 
-            if(blueprint.install_part(p.x, p.y, part_id) < 0) {
+            if( !cached && blueprint.install_part(p.x, p.y, part_id) < 0 ) {
                 debugmsg("init_vehicles: '%s' part '%s'(%d) can't be installed to %d,%d",
                          blueprint.name.c_str(), part_id.c_str(),
                          blueprint.parts.size(), p.x, p.y);
@@ -440,6 +444,47 @@ void vehicle_prototype::finalize()
     }
 }
 
+void vehicle_prototype::save_blueprints( JsonOut &json )
+{
+    json.start_object();
+    for( auto &vp : vtypes ) {
+        if( vp.second.blueprint ) {
+            json.member( vp.first.str(), *vp.second.blueprint );
+        }
+    }
+    json.end_object();
+}
+
+void vehicle_prototype::load_blueprints( JsonIn &jsin )
+{
+    std::vector<std::pair<vehicle_prototype *, std::unique_ptr<vehicle>>> loaded;
+    // The blueprints were written by this version, they need none of the conversions for old saves
+    const int old_loading_version = savegame_loading_version;
+    savegame_loading_version = savegame_version;
+    try {
+        jsin.start_object();
+        while( !jsin.end_object() ) {
+            const auto iter = vtypes.find( vproto_id( jsin.get_member_name() ) );
+            if( iter == vtypes.end() ) {
+                jsin.skip_value();
+                continue;
+            }
+            std::unique_ptr<vehicle> blueprint( new vehicle() );
+            blueprint->deserialize( jsin );
+            // The language may have changed since
+            blueprint->name = _( iter->second.name.c_str() );
+            loaded.emplace_back( &iter->second, std::move( blueprint ) );
+        }
+    } catch( ... ) {
+        savegame_loading_version = old_loading_version;
+        throw;
+    }
+    savegame_loading_version = old_loading_version;
+    for( auto &elem : loaded ) {
+        elem.first->blueprint = std::move( elem.second );
+    }
+}
+
 std::vector<vproto_id> vehicle_prototype::get_all()
 {
     std::vector<vproto_id> result;
@@ -17,6 +17,8 @@ struct vehicle_prototype;
 using vproto_id = string_id<vehicle_prototype>;
 class vehicle;
 class JsonObject;
+class JsonIn;
+class JsonOut;
 struct vehicle_item_spawn;
 typedef int nc_color;
 
@@ -123,8 +125,9 @@ struct vehicle_item_spawn {
 };
 
 /**
- * Prototype of a vehicle. The blueprint member is filled in during the finalizing, before that it
- * is a nullptr. Creating a new vehicle copies the blueprint vehicle.
+ * Prototype of a vehicle. The blueprint member is filled in during the finalizing, or read from
+ * the data cache right before it, before that it is a nullptr. Creating a new vehicle copies the
+ * blueprint vehicle.
  */
 struct vehicle_prototype {
     std::string name;
@@ -136,6 +139,10 @@ struct vehicle_prototype {
     static void load( JsonObject &jo );
     static void reset();
     static void finalize();
+    /** Writes the blueprints of all prototypes as one object, keyed by prototype id. */
+    static void save_blueprints( JsonOut &json );
+    /** Reads what save_blueprints wrote, either all blueprints are set or (on error) none. */
+    static void load_blueprints( JsonIn &jsin );
 
     static std::vector<vproto_id> get_all();
 };
@@ -3,6 +3,7 @@
 #include "coordinate_conversions.h"
 #include "map.h"
 #include "mapbuffer.h"
+#include "active_vehicle_registry.h"
 #include "output.h"
 #include "game.h"
 #include "map.h"
@@ -250,6 +251,7 @@ vehicle::vehicle() : vehicle( vproto_id() )
 
 vehicle::~vehicle()
 {
+    active_vehicles.remove( this );
 }
 
 bool vehicle::player_in_control(player const& p) const
@@ -2127,6 +2129,7 @@ int vehicle::install_part( int dx, int dy, const vehicle_part &new_part )
     parts.back().mount.x = dx;
     parts.back().mount.y = dy;
     refresh();
+    g->m.set_pathfinding_cache_dirty( smz );
     return parts.size() - 1;
 }
 
@@ -2240,6 +2243,7 @@ bool vehicle::remove_part (int p)
         g->m.add_item_or_charges( dest, i );
     }
     g->m.dirty_vehicle_list.insert(this);
+    g->m.set_pathfinding_cache_dirty( smz );
     refresh();
     return shift_if_needed();
 }
@@ -3728,6 +3732,13 @@ void vehicle::power_parts()
     }
 }
 
+bool vehicle::has_active_systems() const
+{
+    return engine_on || reactor_on || lights_on || overhead_lights_on || fridge_on ||
+           recharger_on || is_alarm_on || camera_on || dome_lights_on || aisle_lights_on ||
+           scoop_on || stereo_on || chimes_on || planter_on;
+}
+
 vehicle* vehicle::find_vehicle( const tripoint &where )
 {
     // Is it in the reality bubble?
@@ -5700,6 +5711,8 @@ int vehicle::damage_direct( int p, int dmg, damage_type type )
         if( parts[p].hp == 0 && last_hp > 0) {
             insides_dirty = true;
             pivot_dirty = true;
+            // Broken obstacles don't block the way any more
+            g->m.set_pathfinding_cache_dirty( smz );
         }
 
         if( part_flag( p, "FUEL_TANK" ) ) {
@@ -6537,6 +6550,8 @@ void vehicle::open_or_close(int const part_index, bool const opening)
     parts[part_index].open = opening ? 1 : 0;
     insides_dirty = true;
     g->m.set_transparency_cache_dirty( smz );
+    g->m.set_pathfinding_cache_dirty( smz );
+    g->m.set_scent_cache_dirty( smz );
 
     if (!part_info(part_index).has_flag("MULTISQUARE")) {
         return;
@@ -567,6 +567,12 @@ public:
 
     void power_parts();
 
+    /**
+     * Whether any engine, reactor or electrical consumer is turned on, which means
+     * @ref power_parts and @ref idle have something to do even outside of the reality bubble.
+     */
+    bool has_active_systems() const;
+
     /**
      * Try to charge our (and, optionally, connected vehicles') batteries by the given amount.
      * @return amount of charge left over.
@@ -0,0 +1,64 @@
+#include "vehicle_scheduler.h"
+
+#include "vehicle.h"
+
+void vehicle_scheduler::reset( const std::vector<vehicle *> &vehicles )
+{
+    invalidate();
+    for( size_t i = 0; i < vehicles.size(); i++ ) {
+        scheduled[vehicles[i]] = scheduled_vehicle{ i, 0 };
+        update( vehicles[i] );
+    }
+    valid = true;
+}
+
+void vehicle_scheduler::invalidate()
+{
+    valid = false;
+    scheduled.clear();
+    moving = decltype( moving )();
+    falling.clear();
+}
+
+void vehicle_scheduler::update( vehicle *veh )
+{
+    const auto iter = scheduled.find( veh );
+    if( iter == scheduled.end() ) {
+        return;
+    }
+    scheduled_vehicle &sv = iter->second;
+    sv.stamp = ++last_stamp;
+    if( veh->of_turn > 0 ) {
+        moving.push( entry{ veh->of_turn, sv.order, sv.stamp, veh } );
+    }
+    if( veh->falling ) {
+        falling.emplace( sv.order, veh );
+    } else {
+        falling.erase( std::make_pair( sv.order, veh ) );
+    }
+}
+
+vehicle *vehicle_scheduler::next()
+{
+    while( !moving.empty() ) {
+        const entry &top = moving.top();
+        if( scheduled[top.veh].stamp == top.stamp && top.veh->of_turn == top.of_turn ) {
+            return top.veh;
+        }
+        // Outdated by a later update, or of_turn changed without one
+        vehicle *const veh = top.veh;
+        const bool changed = scheduled[veh].stamp == top.stamp;
+        moving.pop();
+        if( changed ) {
+            update( veh );
+        }
+    }
+    while( !falling.empty() ) {
+        vehicle *const veh = falling.begin()->second;
+        if( veh->falling ) {
+            return veh;
+        }
+        falling.erase( falling.begin() );
+    }
+    return nullptr;
+}
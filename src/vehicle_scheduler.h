@@ -0,0 +1,68 @@
+#ifndef VEHICLE_SCHEDULER_H
+#define VEHICLE_SCHEDULER_H
+
+#include <queue>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class vehicle;
+
+/**
+ * The order in which @ref map::vehproceed moves the vehicles of a turn, one step at a time:
+ * the vehicle with the most movement left (vehicle::of_turn) goes first, vehicles that are
+ * falling but have no movement left go after all the others. Ties go to the vehicle that
+ * came first when the schedule was reset.
+ *
+ * The schedule only looks at a vehicle again when told with @ref update, so it has to be
+ * told whenever of_turn or falling of a vehicle changed, e.g. after its step or a collision.
+ * It doesn't own the vehicles, it has to be invalidated when a vehicle gets destroyed or
+ * added, or leaves the map, and reset before it is used again.
+ */
+class vehicle_scheduler
+{
+    public:
+        /** Starts over with these vehicles, afterwards it's valid. */
+        void reset( const std::vector<vehicle *> &vehicles );
+        /** Forgets all vehicles, it has to be reset before it is used again. */
+        void invalidate();
+        bool is_valid() const {
+            return valid;
+        }
+
+        /** Schedules the vehicle again, after of_turn or falling changed. */
+        void update( vehicle *veh );
+        /** The vehicle to move next, or nullptr if no vehicle can move anymore. */
+        vehicle *next();
+
+    private:
+        struct entry {
+            float of_turn;
+            size_t order;
+            unsigned int stamp;
+            vehicle *veh;
+        };
+        struct moves_after {
+            bool operator()( const entry &lhs, const entry &rhs ) const {
+                if( lhs.of_turn != rhs.of_turn ) {
+                    return lhs.of_turn < rhs.of_turn;
+                }
+                return lhs.order > rhs.order;
+            }
+        };
+        struct scheduled_vehicle {
+            size_t order;
+            // Only the queue entry with the latest stamp of a vehicle counts
+            unsigned int stamp;
+        };
+
+        bool valid = false;
+        unsigned int last_stamp = 0;
+        std::unordered_map<const vehicle *, scheduled_vehicle> scheduled;
+        std::priority_queue<entry, std::vector<entry>, moves_after> moving;
+        // By order
+        std::set<std::pair<size_t, vehicle *>> falling;
+};
+
+#endif
@@ -17,9 +17,12 @@
 
 #include <vector>
 #include <sstream>
+#include <unordered_map>
 
 const efftype_id effect_glare( "glare" );
 
+static const option<std::string> option_use_celsius( "USE_CELSIUS" );
+
 /**
  * \defgroup Weather "Weather and its implications."
  * @{
@@ -56,6 +59,246 @@ void weather_effect::glare()
 
 int get_hourly_rotpoints_at_temp( int temp );
 
+inline void proc_weather_sum( const weather_type wtype, weather_sum &data,
+                              const calendar &turn, const int tick_size );
+
+namespace
+{
+
+/**
+ * Remembers the weather of each game hour per overmap terrain, as running totals,
+ * so that rot and rain over long periods don't need a noise sample per hour (or minute).
+ * The weather of a whole hour is sampled at its start, at the corner of the overmap
+ * terrain. The noise behind the weather changes over thousands of map squares,
+ * so that's as good as sampling the actual location.
+ * Only the latest hours of the most recently used overmap terrains are kept, hours
+ * before that are sampled each time, as they were before there was a history.
+ */
+class weather_history
+{
+    public:
+        /** Same as the old hourly sampling in get_rot_since, for the given absolute location. */
+        int rot_between( int startturn, int endturn, const tripoint &location );
+        /** Weather totals between the turns, with the hourly resolution of the table. */
+        weather_sum sum_between( int startturn, int endturn, const tripoint &location );
+
+    private:
+        /** Totals of all hours from first_hour up to (excluding) some hour */
+        struct running_total {
+            long long rot = 0;
+            long long rain = 0;
+            long long acid = 0;
+            double sunlight = 0.0;
+
+            void add( const running_total &other ) {
+                rot += other.rot;
+                rain += other.rain;
+                acid += other.acid;
+                sunlight += other.sunlight;
+            }
+        };
+        struct region_history {
+            int first_hour = 0;
+            // totals[i] sums hours first_hour .. first_hour + i - 1, so totals[0] is all zeroes
+            std::vector<running_total> totals;
+            // The use_count when the region was last used
+            unsigned long last_used = 0;
+        };
+
+        // Hours kept per region, counted back from the latest hour asked for
+        static const int max_hours = DAYS( 30 ) / HOURS( 1 );
+        // Regions kept, the least recently used one is dropped for a new one
+        static const size_t max_regions = 128;
+
+        // The table depends on those, it's thrown away when any of them changes
+        unsigned seed = 0;
+        int season_length = 0;
+        std::unordered_map<tripoint, region_history> regions;
+        unsigned long use_count = 0;
+
+        static int hour_of( const int turn ) {
+            return turn >= 0 ? turn / HOURS( 1 ) : ( turn - HOURS( 1 ) + 1 ) / HOURS( 1 );
+        }
+        /** Weather of a single hour, scaled to the full hour */
+        static running_total sample_hour( const point &omt, int hour );
+        /**
+         * Returns the region, with totals up to last_hour (inclusive) and back to first_hour
+         * or the start of the kept hours, whichever is later.
+         */
+        const region_history &get_region( const point &omt, int first_hour, int last_hour );
+        /** Totals of first_hour .. last_hour - 1, sampling the hours the region doesn't have */
+        static running_total range_total( const region_history &region, const point &omt,
+                                          int first_hour, int last_hour );
+};
+
+weather_history::running_total weather_history::sample_hour( const point &omt, const int hour )
+{
+    const point location( omt.x * SEEX * 2, omt.y * SEEY * 2 );
+    const calendar turn( HOURS( hour ) );
+    running_total result;
+    const w_point w = g->weather_gen->get_weather( location, turn );
+    result.rot = get_hourly_rotpoints_at_temp( w.temperature );
+
+    weather_sum sum;
+    proc_weather_sum( g->weather_gen->get_weather_conditions( w ), sum, turn, HOURS( 1 ) );
+    result.rain = sum.rain_amount;
+    result.acid = sum.acid_amount;
+    result.sunlight = sum.sunlight;
+    return result;
+}
+
+const weather_history::region_history &weather_history::get_region( const point &omt,
+        const int first_hour, const int last_hour )
+{
+    if( seed != g->weather_gen->get_seed() || season_length != calendar::season_length() ) {
+        regions.clear();
+        seed = g->weather_gen->get_seed();
+        season_length = calendar::season_length();
+    }
+
+    const tripoint key( omt.x, omt.y, 0 );
+    auto found = regions.find( key );
+    if( found == regions.end() ) {
+        if( regions.size() >= max_regions ) {
+            auto oldest = regions.begin();
+            for( auto iter = regions.begin(); iter != regions.end(); ++iter ) {
+                if( iter->second.last_used < oldest->second.last_used ) {
+                    oldest = iter;
+                }
+            }
+            regions.erase( oldest );
+        }
+        found = regions.emplace( key, region_history() ).first;
+    }
+    region_history &region = found->second;
+    region.last_used = ++use_count;
+
+    const auto append = [&omt]( std::vector<running_total> &totals, const int hour ) {
+        running_total next = totals.back();
+        next.add( sample_hour( omt, hour ) );
+        totals.push_back( next );
+    };
+
+    // Nothing of the old hours would be kept when jumping that far ahead
+    if( !region.totals.empty() &&
+        last_hour + 1 - max_hours > region.first_hour + static_cast<int>( region.totals.size() ) - 1 ) {
+        region.totals.clear();
+    }
+    if( region.totals.empty() ) {
+        region.first_hour = std::max( first_hour, last_hour + 1 - max_hours );
+        region.totals.emplace_back();
+    }
+
+    const int end_hour = std::max( last_hour + 1,
+                                   region.first_hour + static_cast<int>( region.totals.size() ) - 1 );
+    const int window_first = std::max( first_hour, end_hour - max_hours );
+    if( window_first < region.first_hour ) {
+        // Going back in time means shifting everything, so go back by up to a week at once
+        const int new_first = std::max( end_hour - max_hours,
+                                        std::min( window_first, region.first_hour - DAYS( 7 ) / HOURS( 1 ) ) );
+        std::vector<running_total> totals( 1 );
+        for( int hour = new_first; hour < region.first_hour; hour++ ) {
+            append( totals, hour );
+        }
+        const running_total offset = totals.back();
+        for( size_t i = 1; i < region.totals.size(); i++ ) {
+            running_total shifted = region.totals[i];
+            shifted.add( offset );
+            totals.push_back( shifted );
+        }
+        region.first_hour = new_first;
+        region.totals.swap( totals );
+    }
+
+    for( int hour = region.first_hour + region.totals.size() - 1; hour <= last_hour; hour++ ) {
+        append( region.totals, hour );
+    }
+
+    // Drop the hours that fell out of the window, a week at once
+    const int kept = static_cast<int>( region.totals.size() ) - 1;
+    if( kept > max_hours + DAYS( 7 ) / HOURS( 1 ) ) {
+        const int dropped = kept - max_hours;
+        region.totals.erase( region.totals.begin(), region.totals.begin() + dropped );
+        region.first_hour += dropped;
+    }
+    return region;
+}
+
+weather_history::running_total weather_history::range_total( const region_history &region,
+        const point &omt, const int first_hour, const int last_hour )
+{
+    running_total result;
+    const int kept_first = std::min( std::max( first_hour, region.first_hour ), last_hour );
+    if( kept_first < last_hour ) {
+        const running_total &from = region.totals[kept_first - region.first_hour];
+        const running_total &to = region.totals[last_hour - region.first_hour];
+        result.rot = to.rot - from.rot;
+        result.rain = to.rain - from.rain;
+        result.acid = to.acid - from.acid;
+        result.sunlight = to.sunlight - from.sunlight;
+    }
+    for( int hour = first_hour; hour < kept_first; hour++ ) {
+        result.add( sample_hour( omt, hour ) );
+    }
+    return result;
+}
+
+int weather_history::rot_between( const int startturn, const int endturn,
+                                  const tripoint &location )
+{
+    if( startturn >= endturn ) {
+        return 0;
+    }
+    const int first_hour = hour_of( startturn );
+    const int last_hour = hour_of( endturn );
+    const point omt = ms_to_omt_copy( point( location.x, location.y ) );
+    const auto &region = get_region( omt, first_hour, last_hour );
+    const auto hour_rot = [&]( const int hour ) {
+        return range_total( region, omt, hour, hour + 1 ).rot;
+    };
+    if( first_hour == last_hour ) {
+        return ( endturn - startturn ) * hour_rot( first_hour ) / HOURS( 1 );
+    }
+
+    // Partial hours at both ends, whole hours in between
+    const int head = HOURS( first_hour + 1 ) - startturn;
+    const int tail = endturn - HOURS( last_hour );
+    return head * hour_rot( first_hour ) / HOURS( 1 ) +
+           range_total( region, omt, first_hour + 1, last_hour ).rot +
+           tail * hour_rot( last_hour ) / HOURS( 1 );
+}
+
+weather_sum weather_history::sum_between( const int startturn, const int endturn,
+        const tripoint &location )
+{
+    weather_sum data;
+    if( startturn >= endturn ) {
+        return data;
+    }
+    const int first_hour = hour_of( startturn );
+    const int last_hour = hour_of( endturn );
+    const point omt = ms_to_omt_copy( point( location.x, location.y ) );
+    const auto &region = get_region( omt, first_hour, last_hour );
+    const auto add_part = [&data]( const running_total & total, const int turns ) {
+        data.rain_amount += total.rain * turns / HOURS( 1 );
+        data.acid_amount += total.acid * turns / HOURS( 1 );
+        data.sunlight += total.sunlight * turns / HOURS( 1 );
+    };
+    if( first_hour == last_hour ) {
+        add_part( range_total( region, omt, first_hour, first_hour + 1 ), endturn - startturn );
+        return data;
+    }
+
+    add_part( range_total( region, omt, first_hour, first_hour + 1 ), HOURS( first_hour + 1 ) - startturn );
+    add_part( range_total( region, omt, first_hour + 1, last_hour ), HOURS( 1 ) );
+    add_part( range_total( region, omt, last_hour, last_hour + 1 ), endturn - HOURS( last_hour ) );
+    return data;
+}
+
+weather_history history;
+
+} // namespace
+
 int get_rot_since( const int startturn, const int endturn, const tripoint &location )
 {
     // Ensure food doesn't rot in ice labs, where the
@@ -67,12 +310,7 @@ int get_rot_since( const int startturn, const int endturn, const tripoint &locat
         return 0;
     }
     // TODO: maybe have different rotting speed when underground?
-    int ret = 0;
-    for (calendar i(startturn); i.get_turn() < endturn; i += 600) {
-        w_point w = g->weather_gen->get_weather(location, i);
-        ret += std::min(600, endturn - i.get_turn()) * get_hourly_rotpoints_at_temp(w.temperature) / 600;
-    }
-    return ret;
+    return history.rot_between( startturn, endturn, location );
 }
 
 inline void proc_weather_sum( const weather_type wtype, weather_sum &data,
@@ -110,6 +348,12 @@ weather_sum sum_conditions( const calendar &startturn,
     int tick_size = MINUTES(1);
     weather_sum data;
 
+    // Hourly resolution is plenty for long periods, those come from the weather history.
+    // Debug weather isn't in the history, it can change at any time.
+    if( endturn - startturn > DAYS(1) && g->weather_gen->debug_weather == WEATHER_NULL ) {
+        return history.sum_between( startturn, endturn, location );
+    }
+
     for( calendar turn(startturn); turn < endturn; turn += tick_size ) {
         const int diff = endturn - startturn;
         if( diff <= 0 ) {
@@ -587,7 +831,7 @@ std::string print_temperature( double fahrenheit, int decimals )
     ret.precision( decimals );
     ret << std::fixed;
 
-    if(OPTIONS["USE_CELSIUS"] == "celsius") {
+    if(option_use_celsius.get() == "celsius") {
         ret << temp_to_celsius( fahrenheit );
         return rmp_format( _( "<Celsius>%sC" ), ret.str().c_str() );
     } else {
@@ -244,6 +244,7 @@ void worldfactory::set_active_world(WORLDPTR world)
     } else {
         ACTIVE_WORLD_OPTIONS.clear();
     }
+    options_manager::notify_changed();
 }
 
 bool worldfactory::save_world(WORLDPTR world, bool is_conversion)
@@ -0,0 +1,35 @@
+#include "catch/catch.hpp"
+
+#include "active_vehicle_registry.h"
+#include "game.h"
+#include "map.h"
+#include "mapdata.h"
+#include "vehicle.h"
+
+#include <algorithm>
+
+TEST_CASE( "active_vehicles_follow_vehicle_state" )
+{
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            g->m.set( x, y, t_grass, f_null );
+        }
+    }
+
+    vehicle *veh = g->m.add_vehicle( vproto_id( "car" ), tripoint( 60, 60, 0 ), 0, 0, 0 );
+    REQUIRE( veh != nullptr );
+    CHECK( !veh->has_active_systems() );
+    CHECK( !active_vehicles.has( veh ) );
+
+    veh->lights_on = true;
+    CHECK( veh->has_active_systems() );
+    active_vehicles.add( veh );
+    active_vehicles.add( veh );
+    const auto registered = active_vehicles.get();
+    CHECK( std::count( registered.begin(), registered.end(), veh ) == 1 );
+
+    // The destructor must not leave a dangling pointer behind
+    g->m.destroy_vehicle( veh );
+    CHECK( !active_vehicles.has( veh ) );
+}
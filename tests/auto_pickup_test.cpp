@@ -0,0 +1,144 @@
+#include "catch/catch.hpp"
+
+#include "auto_pickup.h"
+#include "item_factory.h"
+#include "itype.h"
+
+#include <chrono>
+#include <sstream>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+struct pickup_rule {
+    std::string rule;
+    bool active;
+    bool exclude;
+};
+
+static void set_rules( auto_pickup &apu, const std::vector<pickup_rule> &rules )
+{
+    std::ostringstream buffer;
+    JsonOut json( buffer );
+    json.start_array();
+    for( const auto &r : rules ) {
+        json.start_object();
+        json.member( "rule", r.rule );
+        json.member( "active", r.active );
+        json.member( "exclude", r.exclude );
+        json.end_object();
+    }
+    json.end_array();
+
+    std::istringstream stream( buffer.str() );
+    JsonIn jsin( stream );
+    apu.deserialize( jsin );
+    apu.create_rules();
+}
+
+TEST_CASE( "auto_pickup_rules_match_wildcards" )
+{
+    auto_pickup apu;
+    set_rules( apu, {
+        { "wooden arrow", true, false },
+        { "steel*", true, false },
+        { "*rrow", true, false },
+        { "*BOX*cardboard*", true, false },
+        { "gold**ring", true, false },
+        { "rock", false, false }
+    } );
+
+    CHECK( apu.check_item( "wooden arrow" ) == RULE_WHITELISTED );
+    CHECK( apu.check_item( "Wooden ARROW" ) == RULE_WHITELISTED );
+    CHECK( apu.check_item( "steel frame" ) == RULE_WHITELISTED );
+    CHECK( apu.check_item( "metal arrow" ) == RULE_WHITELISTED );
+    CHECK( apu.check_item( "large box of cardboard" ) == RULE_WHITELISTED );
+    CHECK( apu.check_item( "golden ring" ) == RULE_WHITELISTED );
+    CHECK( apu.check_item( "goldring" ) == RULE_WHITELISTED );
+
+    CHECK( apu.check_item( "wooden arrows" ) == RULE_NONE );
+    CHECK( apu.check_item( "stainless steel" ) == RULE_NONE );
+    CHECK( apu.check_item( "arrowhead" ) == RULE_NONE );
+    CHECK( apu.check_item( "cardboard box" ) == RULE_NONE );
+    // Inactive rules don't count
+    CHECK( apu.check_item( "rock" ) == RULE_NONE );
+    CHECK( apu.check_item( "" ) == RULE_NONE );
+}
+
+TEST_CASE( "auto_pickup_last_matching_rule_decides" )
+{
+    auto_pickup apu;
+    set_rules( apu, {
+        { "*arrow", true, false },
+        { "wooden*", true, true }
+    } );
+    CHECK( apu.check_item( "steel arrow" ) == RULE_WHITELISTED );
+    CHECK( apu.check_item( "wooden arrow" ) == RULE_BLACKLISTED );
+    CHECK( apu.check_item( "wooden spoon" ) == RULE_BLACKLISTED );
+
+    // The verdicts are forgotten when the rules change
+    set_rules( apu, {
+        { "wooden*", true, true },
+        { "*arrow", true, false }
+    } );
+    CHECK( apu.check_item( "wooden arrow" ) == RULE_WHITELISTED );
+    CHECK( apu.check_item( "wooden spoon" ) == RULE_BLACKLISTED );
+}
+
+TEST_CASE( "auto_pickup_performance", "[.]" )
+{
+    std::vector<std::string> type_names;
+    for( auto &p : item_controller->get_all_itypes() ) {
+        type_names.push_back( p.second->nname( 1 ) );
+    }
+    REQUIRE( type_names.size() > 200 );
+
+    // Rules of all kinds made from the names of the items
+    std::vector<pickup_rule> rules;
+    for( size_t i = 0; rules.size() < 200; i += type_names.size() / 200 ) {
+        const std::string &name = type_names[i];
+        const std::string part = name.substr( 0, ( name.length() + 1 ) / 2 );
+        switch( rules.size() % 4 ) {
+            case 0:
+                rules.push_back( { name, true, false } );
+                break;
+            case 1:
+                rules.push_back( { part + "*", true, false } );
+                break;
+            case 2:
+                rules.push_back( { "*" + part + "*", true, rules.size() % 3 == 0 } );
+                break;
+            default:
+                rules.push_back( { "*" + name.substr( name.length() / 2 ), true, false } );
+                break;
+        }
+    }
+
+    // Damaged and contained items are named differently
+    const char *const prefixes[] = { "", "bent ", "ripped ", "burnt " };
+    std::vector<std::string> names;
+    for( size_t i = 0; names.size() < 10000; i++ ) {
+        names.push_back( prefixes[( i / type_names.size() ) % 4] + type_names[i % type_names.size()] );
+    }
+
+    auto_pickup apu;
+    int whitelisted = 0;
+    const auto start1 = std::chrono::high_resolution_clock::now();
+    set_rules( apu, rules );
+    for( const auto &name : names ) {
+        whitelisted += apu.check_item( name ) == RULE_WHITELISTED ? 1 : 0;
+    }
+    const auto end1 = std::chrono::high_resolution_clock::now();
+
+    const auto start2 = std::chrono::high_resolution_clock::now();
+    for( const auto &name : names ) {
+        whitelisted -= apu.check_item( name ) == RULE_WHITELISTED ? 1 : 0;
+    }
+    const auto end2 = std::chrono::high_resolution_clock::now();
+    CHECK( whitelisted == 0 );
+
+    const long first = std::chrono::duration_cast<std::chrono::microseconds>( end1 - start1 ).count();
+    const long cached = std::chrono::duration_cast<std::chrono::microseconds>( end2 - start2 ).count();
+    printf( "%d names against %d rules: %ld us to compile and match, %ld us from the cache.\n",
+            int( names.size() ), int( rules.size() ), first, cached );
+}
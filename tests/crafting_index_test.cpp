@@ -0,0 +1,189 @@
+#include "catch/catch.hpp"
+
+#include "crafting.h"
+#include "game.h"
+#include "inventory.h"
+#include "item.h"
+#include "item_factory.h"
+#include "itype.h"
+#include "map.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "player.h"
+#include "recipe_dictionary.h"
+#include "requirements.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+static void check_same_answers( const inventory &indexed, const inventory &scanned )
+{
+    const std::vector<std::string> types = { "hammer", "rock", "nail", "water_clean", "bottle_plastic",
+                                             "tailors_kit", "sewing_kit", "mess_kit", "hotplate", "fire"
+                                           };
+    for( const auto &type : types ) {
+        CAPTURE( type );
+        CHECK( indexed.amount_of( type, true ) == scanned.amount_of( type, true ) );
+        CHECK( indexed.amount_of( type, false ) == scanned.amount_of( type, false ) );
+        CHECK( indexed.charges_of( type ) == scanned.charges_of( type ) );
+    }
+    const std::vector<std::string> qualities = { "HAMMER", "HAMMER_FINE", "CUT", "CONTAIN", "BOIL" };
+    for( const auto &quality : qualities ) {
+        CAPTURE( quality );
+        CHECK( indexed.max_quality( quality ) == scanned.max_quality( quality ) );
+        for( int level = 0; level <= 3; level++ ) {
+            for( int amount = 1; amount <= 3; amount++ ) {
+                CHECK( indexed.has_items_with_quality( quality, level, amount ) ==
+                       scanned.has_items_with_quality( quality, level, amount ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "crafting_index_counts_like_the_inventory" )
+{
+    inventory inv;
+    inv.push_back( item( "hammer", 0 ) );
+    inv.push_back( item( "hammer", 0 ) );
+    inv.push_back( item( "rock", 0 ) );
+    item nails( "nail", 0 );
+    nails.charges = 40;
+    inv.push_back( nails );
+    item bottle( "bottle_plastic", 0 );
+    bottle.put_in( item( "water_clean", 0 ) );
+    inv.push_back( bottle );
+    inv.push_back( item( "bottle_plastic", 0 ) );
+    inv.push_back( item( "tailors_kit", 0 ) );
+    inv.push_back( item( "mess_kit", 0 ) );
+    item fire( "fire", 0 );
+    fire.charges = 1;
+    fire.item_tags.insert( "PSEUDO" );
+    inv.push_back( fire );
+
+    const inventory scanned = inv;
+    inv.build_index();
+    check_same_answers( inv, scanned );
+
+    // Copies are changed without the index
+    inventory copy = inv;
+    copy.push_back( item( "hammer", 0 ) );
+    CHECK( copy.amount_of( "hammer", true ) == inv.amount_of( "hammer", true ) + 1 );
+}
+
+TEST_CASE( "crafting_index_is_dropped_by_changes" )
+{
+    inventory inv;
+    inv.push_back( item( "hammer", 0 ) );
+    item nails( "nail", 0 );
+    nails.charges = 40;
+    inv.push_back( nails );
+
+    inv.build_index();
+    inv.push_back( item( "hammer", 0 ) );
+    CHECK( inv.amount_of( "hammer", true ) == 2 );
+
+    inv.build_index();
+    inv.use_charges( "nail", 15 );
+    CHECK( inv.charges_of( "nail" ) == 25 );
+
+    inv.build_index();
+    inv.use_amount( "hammer", 1 );
+    CHECK( inv.amount_of( "hammer", true ) == 1 );
+
+    inv.build_index();
+    inv += item( "rock", 0 );
+    CHECK( inv.amount_of( "rock", false ) == 1 );
+
+    inv.build_index();
+    inv.remove_item( &inv.find_item( inv.position_by_type( "rock" ) ) );
+    CHECK( inv.amount_of( "rock", false ) == 0 );
+
+    // Changed in place through a reference handed out by the inventory
+    inv.build_index();
+    inv.item_by_type( "nail" ).charges = 5;
+    CHECK( inv.charges_of( "nail" ) == 5 );
+}
+
+TEST_CASE( "crafting_inventory_is_indexed" )
+{
+    const tripoint pos = g->u.pos();
+    for( const tripoint &p : g->m.points_in_radius( pos, 2 ) ) {
+        g->m.set( p, t_floor, f_null );
+        g->m.i_clear( p );
+    }
+    g->m.spawn_item( pos + tripoint( 1, 0, 0 ), "hammer" );
+    g->m.spawn_item( pos + tripoint( 0, 1, 0 ), "rock", 3 );
+    g->m.spawn_item( pos + tripoint( 1, 1, 0 ), "mess_kit" );
+    g->u.invalidate_crafting_inventory();
+
+    const inventory &crafting_inv = g->u.crafting_inventory();
+    const inventory scanned = crafting_inv;
+    CHECK( crafting_inv.amount_of( "rock", false ) >= 3 );
+    check_same_answers( crafting_inv, scanned );
+
+    for( const tripoint &p : g->m.points_in_radius( pos, 2 ) ) {
+        g->m.i_clear( p );
+    }
+    g->u.invalidate_crafting_inventory();
+}
+
+TEST_CASE( "crafting_availability_performance", "[.]" )
+{
+    const tripoint pos = g->u.pos();
+    for( const tripoint &p : g->m.points_in_radius( pos, PICKUP_RANGE ) ) {
+        g->m.set( p, t_floor, f_null );
+        g->m.i_clear( p );
+    }
+    // A well stocked base: a few of every kind of item within reach
+    std::vector<std::string> types;
+    for( auto &t : item_controller->get_all_itypes() ) {
+        types.push_back( t.first );
+    }
+    size_t next = 0;
+    for( const tripoint &p : g->m.points_in_radius( pos, PICKUP_RANGE ) ) {
+        for( int i = 0; i < 20 && next < types.size(); i++ ) {
+            g->m.add_item( p, item( types[next++], 0 ) );
+        }
+    }
+
+    // Most of crafting_inventory() is still going over the map, the index is built on top
+    const auto start0 = std::chrono::high_resolution_clock::now();
+    inventory nearby;
+    nearby.form_from_map( pos, PICKUP_RANGE, false );
+    const auto end0 = std::chrono::high_resolution_clock::now();
+
+    g->u.invalidate_crafting_inventory();
+    const auto start1 = std::chrono::high_resolution_clock::now();
+    const inventory &crafting_inv = g->u.crafting_inventory();
+    const auto end1 = std::chrono::high_resolution_clock::now();
+    const inventory scanned = crafting_inv;
+
+    int available1 = 0;
+    const auto start2 = std::chrono::high_resolution_clock::now();
+    for( auto &rec : recipe_dict ) {
+        available1 += rec->requirements.can_make_with_inventory( crafting_inv ) ? 1 : 0;
+    }
+    const auto end2 = std::chrono::high_resolution_clock::now();
+
+    int available2 = 0;
+    const auto start3 = std::chrono::high_resolution_clock::now();
+    for( auto &rec : recipe_dict ) {
+        available2 += rec->requirements.can_make_with_inventory( scanned ) ? 1 : 0;
+    }
+    const auto end3 = std::chrono::high_resolution_clock::now();
+    CHECK( available1 == available2 );
+
+    const long from_map = std::chrono::duration_cast<std::chrono::microseconds>( end0 - start0 ).count();
+    const long forming = std::chrono::duration_cast<std::chrono::microseconds>( end1 - start1 ).count();
+    const long indexed = std::chrono::duration_cast<std::chrono::microseconds>( end2 - start2 ).count();
+    const long scanning = std::chrono::duration_cast<std::chrono::microseconds>( end3 - start3 ).count();
+    printf( "%d items, %d recipes available: crafting_inventory() %ld us (form_from_map alone %ld us), checking the recipes %ld us with the index and %ld us without.\n",
+            scanned.num_items(), available1, forming, from_map, indexed, scanning );
+
+    for( const tripoint &p : g->m.points_in_radius( pos, PICKUP_RANGE ) ) {
+        g->m.i_clear( p );
+    }
+    g->u.invalidate_crafting_inventory();
+}
@@ -0,0 +1,93 @@
+#include "catch/catch.hpp"
+
+#include "creature_tracker.h"
+#include "game.h"
+#include "line.h"
+#include "map.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "mtype.h"
+#include "rng.h"
+
+#include <algorithm>
+#include <vector>
+
+static void clear_monsters()
+{
+    while( g->num_zombies() ) {
+        g->remove_zombie( 0 );
+    }
+}
+
+// What find_near should return, done the slow way
+static std::vector<monster *> linear_find_near( const tripoint &p, const int radius )
+{
+    std::vector<monster *> result;
+    for( size_t i = 0; i < g->num_zombies(); i++ ) {
+        monster &critter = g->zombie( i );
+        if( !critter.is_dead() && rl_dist( p, critter.pos() ) <= radius ) {
+            result.push_back( &critter );
+        }
+    }
+    std::sort( result.begin(), result.end() );
+    return result;
+}
+
+static void check_find_near( const tripoint &p, const int radius )
+{
+    auto found = g->critter_tracker->find_near( p, radius );
+    std::sort( found.begin(), found.end() );
+    CHECK( found == linear_find_near( p, radius ) );
+}
+
+TEST_CASE( "creature_tracker_area_queries" )
+{
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            g->m.set( x, y, t_grass, f_null );
+        }
+    }
+    clear_monsters();
+
+    while( g->num_zombies() < 100 ) {
+        const tripoint p( rng( 0, mapsize - 1 ), rng( 0, mapsize - 1 ), 0 );
+        if( g->mon_at( p ) == -1 ) {
+            monster temp( mtype_id( "mon_zombie" ), p );
+            g->critter_tracker->add( temp );
+        }
+    }
+
+    const tripoint center( mapsize / 2, mapsize / 2, 0 );
+    for( const int radius : { 0, 1, 5, 12, 13, 30, 200 } ) {
+        check_find_near( center, radius );
+        check_find_near( tripoint( 3, 7, 0 ), radius );
+    }
+
+    // Moved monsters must be found at their new location
+    for( size_t i = 0; i < g->num_zombies(); i++ ) {
+        monster &critter = g->zombie( i );
+        const tripoint dest( rng( 0, mapsize - 1 ), rng( 0, mapsize - 1 ), 0 );
+        if( g->mon_at( dest ) == -1 ) {
+            critter.setpos( dest );
+        }
+    }
+    g->remove_zombie( 10 );
+    g->zombie( 20 ).die( nullptr );
+    for( const int radius : { 0, 5, 12, 30 } ) {
+        check_find_near( center, radius );
+    }
+
+    const monster *nearest = g->critter_tracker->find_nearest( center, 200, []( const monster & ) {
+        return true;
+    } );
+    REQUIRE( nearest != nullptr );
+    for( monster *critter : linear_find_near( center, 200 ) ) {
+        CHECK( rl_dist( center, nearest->pos() ) <= rl_dist( center, critter->pos() ) );
+    }
+    CHECK( g->critter_tracker->find_nearest( center, 200, []( const monster & ) {
+        return false;
+    } ) == nullptr );
+
+    clear_monsters();
+}
@@ -0,0 +1,80 @@
+#include "catch/catch.hpp"
+
+#include "data_cache.h"
+#include "filesystem.h"
+#include "init.h"
+#include "json.h"
+#include "veh_type.h"
+#include "vehicle.h"
+
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <stdio.h>
+
+static std::map<vproto_id, std::string> serialized_blueprints()
+{
+    std::map<vproto_id, std::string> result;
+    for( const vproto_id &id : vehicle_prototype::get_all() ) {
+        REQUIRE( id.obj().blueprint );
+        std::ostringstream out;
+        JsonOut jsout( out );
+        jsout.write( *id.obj().blueprint );
+        result[id] = out.str();
+    }
+    return result;
+}
+
+TEST_CASE( "data_cache_restores_vehicle_blueprints" )
+{
+    const std::string path = "save/data_cache_test.json";
+    const std::string key = DynamicDataLoader::get_instance().get_data_key();
+    assure_dir_exist( "save" );
+    const std::map<vproto_id, std::string> built = serialized_blueprints();
+    REQUIRE( built.size() > 10 );
+
+    data_cache::save( path, key );
+    REQUIRE( file_exist( path ) );
+    // The temporary file of this game has been renamed into place
+    CHECK( get_files_from_path( ".temp", "save", false, true ).empty() );
+
+    // A cache for other data files is not used
+    const vehicle *before = vproto_id( "car" ).obj().blueprint.get();
+    CHECK_FALSE( data_cache::load( path, key + " changed" ) );
+    CHECK( vproto_id( "car" ).obj().blueprint.get() == before );
+
+    REQUIRE( data_cache::load( path, key ) );
+    CHECK( vproto_id( "car" ).obj().blueprint.get() != before );
+    const std::map<vproto_id, std::string> cached = serialized_blueprints();
+    for( const auto &elem : built ) {
+        INFO( elem.first.str() );
+        CHECK( cached.at( elem.first ) == elem.second );
+    }
+
+    remove_file( path );
+    CHECK_FALSE( data_cache::load( path, key ) );
+}
+
+TEST_CASE( "data_key_belongs_to_the_build" )
+{
+    const std::string build = data_cache::build_id();
+    CHECK_FALSE( build.empty() );
+    CHECK( data_cache::build_id() == build );
+    CHECK( DynamicDataLoader::get_instance().get_data_key().find( build ) != std::string::npos );
+}
+
+TEST_CASE( "data_cache_performance", "[.]" )
+{
+    const std::string path = "save/data_cache_test.json";
+    const std::string key = DynamicDataLoader::get_instance().get_data_key();
+    assure_dir_exist( "save" );
+    data_cache::save( path, key );
+
+    auto start = std::chrono::high_resolution_clock::now();
+    REQUIRE( data_cache::load( path, key ) );
+    auto end = std::chrono::high_resolution_clock::now();
+    const long diff = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+    printf( "%d vehicle blueprints read from the data cache in %ld us.\n",
+            int( vehicle_prototype::get_all().size() ), diff );
+    remove_file( path );
+}
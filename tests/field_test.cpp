@@ -0,0 +1,79 @@
+#include "catch/catch.hpp"
+
+#include "field.h"
+#include "game.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "submap.h"
+
+#include <vector>
+
+static std::vector<field_id> types_in( const field &fld )
+{
+    std::vector<field_id> result;
+    for( auto &entry : fld ) {
+        result.push_back( entry.first );
+    }
+    return result;
+}
+
+TEST_CASE( "field_entries_stay_sorted_by_type" )
+{
+    field fld;
+    CHECK( fld.fieldCount() == 0 );
+    CHECK( fld.addField( fd_smoke, 1, 0 ) );
+    CHECK( fld.addField( fd_blood, 2, 0 ) );
+    CHECK( fld.addField( fd_fire, 3, 0 ) );
+    // Adding an existing type only changes its density
+    CHECK_FALSE( fld.addField( fd_blood, 1, 0 ) );
+    CHECK( fld.findField( fd_blood )->getFieldDensity() == 3 );
+
+    const std::vector<field_id> expected = { fd_blood, fd_fire, fd_smoke };
+    CHECK( types_in( fld ) == expected );
+    CHECK( fld.fieldCount() == 3 );
+    CHECK( fld.findField( fd_acid ) == nullptr );
+
+    CHECK( fld.next_after( fd_blood )->first == fd_fire );
+    CHECK( fld.next_after( fd_bile )->first == fd_fire );
+    CHECK( fld.next_after( fd_smoke ) == fld.end() );
+
+    CHECK( fld.removeField( fd_fire ) );
+    CHECK_FALSE( fld.removeField( fd_fire ) );
+    const std::vector<field_id> remaining = { fd_blood, fd_smoke };
+    CHECK( types_in( fld ) == remaining );
+    CHECK( fld.fieldCount() == 2 );
+}
+
+TEST_CASE( "processing_skips_and_forgets_empty_squares" )
+{
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            const tripoint p( x, y, 0 );
+            g->m.set( x, y, t_grass, f_null );
+            while( g->m.field_at( p ).fieldCount() > 0 ) {
+                g->m.remove_field( p, g->m.field_at( p ).begin()->first );
+            }
+        }
+    }
+    g->m.process_fields();
+
+    const tripoint p( SEEX + 3, SEEY + 5, 0 );
+    const tripoint sm_pos = g->m.get_abs_sub() + tripoint( p.x / SEEX, p.y / SEEY, 0 );
+    submap *const sm = MAPBUFFER.lookup_submap( sm_pos );
+    REQUIRE( sm != nullptr );
+    const size_t tile = ( p.x % SEEX ) * SEEY + p.y % SEEY;
+    CHECK( sm->field_tiles.none() );
+
+    REQUIRE( g->m.add_field( p, fd_blood, 1, 0 ) );
+    CHECK( sm->field_tiles.count() == 1 );
+    CHECK( sm->field_tiles[tile] );
+
+    // A dead entry is removed by the next processing, which also forgets the square
+    g->m.get_field( p, fd_blood )->setFieldDensity( 0 );
+    g->m.process_fields();
+    CHECK( g->m.field_at( p ).fieldCount() == 0 );
+    CHECK( sm->field_count == 0 );
+    CHECK( sm->field_tiles.none() );
+}
@@ -0,0 +1,151 @@
+#include "catch/catch.hpp"
+
+#include "flag_set.h"
+#include "flat_map.h"
+#include "item.h"
+#include "item_factory.h"
+#include "itype.h"
+#include "json.h"
+
+#include <chrono>
+#include <sstream>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+TEST_CASE( "flag_set_behaves_like_a_set" )
+{
+    flag_set flags;
+    CHECK( flags.empty() );
+    CHECK( flags.count( "FIT" ) == 0 );
+
+    flags.insert( "FIT" );
+    flags.insert( "FIT" );
+    flags.insert( "never_seen_before_flag" );
+    CHECK( flags.size() == 2 );
+    CHECK( flags.count( "FIT" ) == 1 );
+    CHECK( flags.count( "never_seen_before_flag" ) == 1 );
+    CHECK( flags.count( "WET" ) == 0 );
+
+    std::vector<std::string> names( flags.begin(), flags.end() );
+    CHECK( names.size() == 2 );
+
+    flag_set other;
+    other.insert( "never_seen_before_flag" );
+    CHECK( flags != other );
+    other.insert( "FIT" );
+    CHECK( flags == other );
+
+    CHECK( flags.erase( "FIT" ) == 1 );
+    CHECK( flags.erase( "FIT" ) == 0 );
+    CHECK( flags.count( "FIT" ) == 0 );
+    CHECK( flags.size() == 1 );
+    flags.clear();
+    CHECK( flags.empty() );
+}
+
+TEST_CASE( "flag_set_keeps_flags_past_the_first_word" )
+{
+    flag_set many;
+    for( int i = 0; i < 200; i++ ) {
+        many.insert( "test_flag_" + std::to_string( i ) );
+    }
+    CHECK( many.size() == 200 );
+    CHECK( many.count( "test_flag_150" ) == 1 );
+
+    // Erasing the late flags must leave a set equal to one that never had them
+    flag_set few;
+    few.insert( "test_flag_0" );
+    for( int i = 1; i < 200; i++ ) {
+        many.erase( "test_flag_" + std::to_string( i ) );
+    }
+    CHECK( many == few );
+}
+
+TEST_CASE( "flat_map_behaves_like_a_map" )
+{
+    flat_map<std::string, std::string> vars;
+    vars["b"] = "2";
+    vars["a"] = "1";
+    vars["c"] = "3";
+    vars["b"] = "two";
+    CHECK( vars.size() == 3 );
+    CHECK( vars.begin()->first == "a" );
+    CHECK( vars.find( "b" )->second == "two" );
+    CHECK( vars.find( "d" ) == vars.end() );
+    CHECK( vars.count( "c" ) == 1 );
+    CHECK( vars.erase( "a" ) == 1 );
+    CHECK( vars.erase( "a" ) == 0 );
+    CHECK( vars.size() == 2 );
+}
+
+TEST_CASE( "item_flags_and_vars_survive_saving" )
+{
+    item it( "hammer", 0 );
+    it.item_tags.insert( "FIT" );
+    it.item_tags.insert( "LIGHT_20" );
+    it.set_var( "name", "Thor's" );
+    it.set_var( "counter", 3 );
+
+    std::ostringstream buffer;
+    JsonOut jsout( buffer );
+    it.serialize( jsout );
+    std::istringstream stream( buffer.str() );
+    JsonIn jsin( stream );
+    item loaded;
+    loaded.deserialize( jsin );
+
+    CHECK( loaded.item_tags == it.item_tags );
+    CHECK( loaded.has_flag( "FIT" ) );
+    CHECK( loaded.get_var( "name" ) == "Thor's" );
+    CHECK( loaded.get_var( "counter", 0.0 ) == 3 );
+    CHECK( loaded.stacks_with( it ) );
+
+    loaded.item_tags.erase( "FIT" );
+    CHECK_FALSE( loaded.stacks_with( it ) );
+}
+
+TEST_CASE( "item_flags_performance", "[.]" )
+{
+    // An item dense base: every type, some with flags and variables of their own
+    std::vector<item> items;
+    for( auto &t : item_controller->get_all_itypes() ) {
+        item it( t.first, 0 );
+        if( items.size() % 3 == 0 ) {
+            it.item_tags.insert( "FIT" );
+        }
+        if( items.size() % 5 == 0 ) {
+            it.item_tags.insert( "WET" );
+            it.set_var( "item_note", "Mine" );
+        }
+        items.push_back( it );
+    }
+
+    const auto start1 = std::chrono::high_resolution_clock::now();
+    std::vector<item> copies;
+    for( int i = 0; i < 10; i++ ) {
+        copies.insert( copies.end(), items.begin(), items.end() );
+    }
+    const auto end1 = std::chrono::high_resolution_clock::now();
+
+    int stacking = 0;
+    const auto start2 = std::chrono::high_resolution_clock::now();
+    for( size_t i = 0; i < copies.size(); i++ ) {
+        stacking += copies[i].stacks_with( items[i % items.size()] ) ? 1 : 0;
+    }
+    const auto end2 = std::chrono::high_resolution_clock::now();
+    CHECK( stacking == int( copies.size() ) );
+
+    int flagged = 0;
+    const auto start3 = std::chrono::high_resolution_clock::now();
+    for( const item &it : copies ) {
+        flagged += it.item_tags.count( "FIT" ) + it.item_tags.count( "WET" ) + it.item_tags.count( "HOT" );
+    }
+    const auto end3 = std::chrono::high_resolution_clock::now();
+
+    const long copying = std::chrono::duration_cast<std::chrono::microseconds>( end1 - start1 ).count();
+    const long comparing = std::chrono::duration_cast<std::chrono::microseconds>( end2 - start2 ).count();
+    const long checking = std::chrono::duration_cast<std::chrono::microseconds>( end3 - start3 ).count();
+    printf( "%d items: copying %ld us, comparing for stacking %ld us, checking %d flags %ld us.\n",
+            int( copies.size() ), copying, comparing, flagged, checking );
+}
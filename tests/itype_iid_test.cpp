@@ -0,0 +1,117 @@
+#include "catch/catch.hpp"
+
+#include "crafting.h"
+#include "inventory.h"
+#include "item.h"
+#include "item_factory.h"
+#include "itype.h"
+#include "itype_iid.h"
+#include "recipe_dictionary.h"
+#include "requirements.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+TEST_CASE( "itype_ids_are_interned" )
+{
+    const itype_iid hammer = intern_itype_id( "hammer" );
+    CHECK( intern_itype_id( std::string( "ham" ) + "mer" ) == hammer );
+    CHECK( intern_itype_id( "rock" ) != hammer );
+    CHECK( itype_iid_str( hammer ) == "hammer" );
+    CHECK( intern_itype_id( "" ) == itype_iid() );
+
+    // Unknown ids are interned too, they don't match any type
+    const itype_iid unknown = intern_itype_id( "no_such_item_type" );
+    CHECK( itype_iid_str( unknown ) == "no_such_item_type" );
+    CHECK( item( "hammer", 0 ).amount_of( unknown, true ) == 0 );
+
+    CHECK( item::find_type( "hammer" )->iid == hammer );
+    CHECK( item::find_type( hammer ) == item::find_type( "hammer" ) );
+}
+
+TEST_CASE( "interned_ids_count_like_string_ids" )
+{
+    inventory inv;
+    inv.push_back( item( "hammer", 0 ) );
+    item nails( "nail", 0 );
+    nails.charges = 40;
+    inv.push_back( nails );
+    item bottle( "bottle_plastic", 0 );
+    bottle.put_in( item( "water_clean", 0 ) );
+    inv.push_back( bottle );
+
+    for( const std::string type : { "hammer", "nail", "water_clean", "bottle_plastic", "rock" } ) {
+        CAPTURE( type );
+        const itype_iid iid = intern_itype_id( type );
+        CHECK( inv.amount_of( iid, true ) == inv.amount_of( type, true ) );
+        CHECK( inv.amount_of( iid, false ) == inv.amount_of( type, false ) );
+        CHECK( inv.charges_of( iid ) == inv.charges_of( type ) );
+    }
+    CHECK( inv.amount_of( "hammer", true ) == 1 );
+    CHECK( inv.charges_of( "nail" ) == 40 );
+
+    CHECK( inv.use_charges( intern_itype_id( "nail" ), 15 ).front().charges == 15 );
+    CHECK( inv.charges_of( "nail" ) == 25 );
+    CHECK( inv.use_amount( intern_itype_id( "hammer" ), 1 ).size() == 1 );
+    CHECK( inv.amount_of( "hammer", true ) == 0 );
+}
+
+TEST_CASE( "crafting_availability_by_interned_id_performance", "[.]" )
+{
+    // An unindexed inventory with a few of every kind of item, checked like the crafting menu does
+    inventory inv;
+    for( auto &t : item_controller->get_all_itypes() ) {
+        for( int i = 0; i < 3; i++ ) {
+            inv.push_back( item( t.first, 0 ) );
+        }
+    }
+    std::vector<const item_comp *> comps;
+    for( auto &rec : recipe_dict ) {
+        for( auto &choices : rec->requirements.get_components() ) {
+            for( auto &comp : choices ) {
+                comps.push_back( &comp );
+            }
+        }
+    }
+
+    std::vector<const item *> items;
+    inv.visit_items_const( [&items]( const item * e ) {
+        items.push_back( e );
+        return VisitResponse::NEXT;
+    } );
+
+    // The innermost loop, matching the type of every item, by string and by interned id
+    long by_string = 0;
+    const auto start1 = std::chrono::high_resolution_clock::now();
+    for( const item_comp *comp : comps ) {
+        for( const item *e : items ) {
+            by_string += e->type->id == comp->type ? 1 : 0;
+        }
+    }
+    const auto end1 = std::chrono::high_resolution_clock::now();
+
+    long by_iid = 0;
+    const auto start2 = std::chrono::high_resolution_clock::now();
+    for( const item_comp *comp : comps ) {
+        for( const item *e : items ) {
+            by_iid += e->type->iid == comp->type_iid ? 1 : 0;
+        }
+    }
+    const auto end2 = std::chrono::high_resolution_clock::now();
+    CHECK( by_string == by_iid );
+
+    int available = 0;
+    const auto start3 = std::chrono::high_resolution_clock::now();
+    for( auto &rec : recipe_dict ) {
+        available += rec->requirements.can_make_with_inventory( inv ) ? 1 : 0;
+    }
+    const auto end3 = std::chrono::high_resolution_clock::now();
+
+    const long strings = std::chrono::duration_cast<std::chrono::microseconds>( end1 - start1 ).count();
+    const long iids = std::chrono::duration_cast<std::chrono::microseconds>( end2 - start2 ).count();
+    const long checking = std::chrono::duration_cast<std::chrono::microseconds>( end3 - start3 ).count();
+    printf( "%d items, %d components: matching types %ld us by string and %ld us by interned id, %d recipes available in %ld us.\n",
+            inv.num_items(), int( comps.size() ), strings, iids, available, checking );
+}
@@ -0,0 +1,245 @@
+#include "catch/catch.hpp"
+
+#include "filesystem.h"
+#include "json.h"
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <stdio.h>
+
+static const std::string document =
+    "{\n"
+    "  \"id\": \"test\",\n"
+    "  \"escaped\": \"a \\\"quote\\\", a \\\\ and \\u00e9\\n\",\n"
+    "  \"numbers\": [ 0, -12, 3.5, 1e3, -2.5E-1 ],\n"
+    "  \"flags\": [ true, false, null ],\n"
+    "  \"nested\": { \"empty\": [], \"inner\": { \"x\": 7 } }\n"
+    "}\n";
+
+static void check_document( JsonIn &jsin )
+{
+    JsonObject jo = jsin.get_object();
+    CHECK( jo.get_string( "id" ) == "test" );
+    CHECK( jo.get_string( "escaped" ) == "a \"quote\", a \\ and \xc3\xa9\n" );
+
+    JsonArray numbers = jo.get_array( "numbers" );
+    CHECK( numbers.next_int() == 0 );
+    CHECK( numbers.next_int() == -12 );
+    CHECK( numbers.next_float() == Approx( 3.5 ) );
+    CHECK( numbers.next_int() == 1000 );
+    CHECK( numbers.next_float() == Approx( -0.25 ) );
+    CHECK_FALSE( numbers.has_more() );
+
+    JsonArray flags = jo.get_array( "flags" );
+    CHECK( flags.next_bool() );
+    CHECK_FALSE( flags.next_bool() );
+    CHECK( flags.test_null() );
+
+    JsonObject nested = jo.get_object( "nested" );
+    CHECK( nested.get_array( "empty" ).empty() );
+    CHECK( nested.get_object( "inner" ).get_int( "x" ) == 7 );
+    CHECK_FALSE( jo.has_member( "missing" ) );
+}
+
+TEST_CASE( "json_reads_the_same_from_streams_and_buffers" )
+{
+    SECTION( "stream" ) {
+        std::istringstream stream( document );
+        JsonIn jsin( stream );
+        check_document( jsin );
+    }
+    SECTION( "buffer" ) {
+        JsonIn jsin( document.data(), document.size() );
+        check_document( jsin );
+    }
+    SECTION( "mapped file" ) {
+        const std::string path = "save/json_test.json";
+        assure_dir_exist( "save" );
+        {
+            std::ofstream fout( path.c_str(), std::ios_base::binary );
+            fout << document;
+        }
+        {
+            const mapped_file mapped( path );
+            REQUIRE( mapped.is_open() );
+            REQUIRE( mapped.size() == document.size() );
+            JsonIn jsin( mapped.data(), mapped.size() );
+            check_document( jsin );
+        }
+        remove_file( path );
+        CHECK_FALSE( mapped_file( path ).is_open() );
+    }
+}
+
+TEST_CASE( "json_errors_point_at_the_problem" )
+{
+    const std::string text = "{\n  \"a\": 1,\n  \"b\": tru\n}";
+    JsonIn jsin( text.data(), text.size() );
+    try {
+        jsin.get_object();
+        FAIL( "no error for a broken boolean" );
+    } catch( const JsonError &err ) {
+        const std::string message = err.what();
+        INFO( message );
+        CHECK( message.find( "line 3:" ) == 0 );
+        CHECK( message.find( "expected \"true\"" ) != std::string::npos );
+    }
+
+    const std::string unclosed = "[ \"never closed ]";
+    JsonIn unclosed_jsin( unclosed.data(), unclosed.size() );
+    unclosed_jsin.start_array();
+    CHECK_THROWS_AS( unclosed_jsin.get_string(), JsonError );
+
+    const std::string empty;
+    JsonIn empty_jsin( empty.data(), empty.size() );
+    CHECK_FALSE( empty_jsin.good() );
+    CHECK_THROWS_AS( empty_jsin.start_object(), JsonError );
+}
+
+// How JsonObject used to index its members
+static std::map<std::string, int> old_member_index( JsonIn &jsin )
+{
+    std::map<std::string, int> positions;
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        std::string n = jsin.get_member_name();
+        positions[n] = jsin.tell();
+        jsin.skip_value();
+    }
+    return positions;
+}
+
+TEST_CASE( "json_object_finds_its_members" )
+{
+    const std::string text =
+        "{ \"b\": 2, \"//\": \"x\", \"a\": 1, \"ab\": 3, \"\\u0061c\": 4, \"//\": \"y\" }";
+    JsonIn jsin( text.data(), text.size() );
+    JsonObject jo = jsin.get_object();
+    CHECK( jo.size() == 5 );
+    CHECK( jo.get_int( "a" ) == 1 );
+    CHECK( jo.get_int( "ab" ) == 3 );
+    CHECK( jo.get_int( "ac" ) == 4 );
+    CHECK( jo.get_int( "b" ) == 2 );
+    CHECK( jo.get_string( "//" ) == "y" );
+    CHECK( jo.get_int( "c", 5 ) == 5 );
+    CHECK_FALSE( jo.has_member( "" ) );
+    CHECK_FALSE( jo.has_member( "aa" ) );
+    // Looking up missing members does not add them
+    CHECK( jo.size() == 5 );
+    CHECK( jo.get_member_names() == std::set<std::string>( { "//", "a", "ab", "ac", "b" } ) );
+
+    const std::string duplicate = "{ \"a\": 1, \"b\": 2, \"a\": 3 }";
+    JsonIn duplicate_jsin( duplicate.data(), duplicate.size() );
+    CHECK_THROWS_AS( duplicate_jsin.get_object(), JsonError );
+}
+
+// Every object in every file, with its type
+static void for_each_data_object( const std::function<void( JsonIn &, const std::string & )> &func )
+{
+    for( const std::string &file : get_files_from_path( ".json", "data/json", true, true ) ) {
+        const mapped_file mapped( file );
+        JsonIn jsin( mapped.data(), mapped.size() );
+        if( !jsin.test_array() ) {
+            continue;
+        }
+        JsonArray objects = jsin.get_array();
+        while( objects.has_more() ) {
+            if( !objects.test_object() ) {
+                objects.skip_value();
+                continue;
+            }
+            const int pos = jsin.tell();
+            const std::string type = objects.next_object().get_string( "type", "" );
+            jsin.seek( pos );
+            func( jsin, type );
+        }
+    }
+}
+
+TEST_CASE( "json_object_indexes_data_like_before" )
+{
+    int objects = 0;
+    for_each_data_object( [&objects]( JsonIn & jsin, const std::string & ) {
+        const int pos = jsin.tell();
+        const std::map<std::string, int> expected = old_member_index( jsin );
+        jsin.seek( pos );
+        JsonObject jo = jsin.get_object();
+        REQUIRE( jo.size() == expected.size() );
+        for( const auto &elem : expected ) {
+            REQUIRE( jo.get_raw( elem.first )->tell() == elem.second );
+        }
+        objects++;
+    } );
+    CHECK( objects > 1000 );
+}
+
+// Indexes each object and looks up every member twice, and one that is missing
+static long time_member_lookups( const bool old, std::map<std::string, long> &per_type )
+{
+    long total = 0;
+    for_each_data_object( [&]( JsonIn & jsin, const std::string & type ) {
+        const int pos = jsin.tell();
+        const std::map<std::string, int> names = old_member_index( jsin );
+        jsin.seek( pos );
+        auto start = std::chrono::high_resolution_clock::now();
+        for( int i = 0; i < 10; i++ ) {
+            jsin.seek( pos );
+            if( old ) {
+                std::map<std::string, int> positions = old_member_index( jsin );
+                for( const auto &elem : names ) {
+                    positions[elem.first];
+                    positions[elem.first];
+                }
+                positions["missing"];
+            } else {
+                JsonObject jo = jsin.get_object();
+                for( const auto &elem : names ) {
+                    jo.has_member( elem.first );
+                    jo.has_member( elem.first );
+                }
+                jo.has_member( "missing" );
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        const long diff = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+        per_type[type] += diff;
+        total += diff;
+    } );
+    return total;
+}
+
+TEST_CASE( "json_object_index_performance", "[.]" )
+{
+    std::map<std::string, long> old_per_type;
+    std::map<std::string, long> new_per_type;
+    const long old_total = time_member_lookups( true, old_per_type );
+    const long new_total = time_member_lookups( false, new_per_type );
+    for( const auto &elem : old_per_type ) {
+        if( elem.second >= 10000 ) {
+            printf( "%-24s %8ld us with a map, %8ld us indexed.\n", elem.first.c_str(), elem.second,
+                    new_per_type[elem.first] );
+        }
+    }
+    printf( "%-24s %8ld us with a map, %8ld us indexed, 10 times over data/json.\n", "all types",
+            old_total, new_total );
+}
+
+TEST_CASE( "json_data_parsing_performance", "[.]" )
+{
+    const std::vector<std::string> files = get_files_from_path( ".json", "data/json", true, true );
+    long bytes = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for( const std::string &file : files ) {
+        const mapped_file mapped( file );
+        bytes += mapped.size();
+        JsonIn jsin( mapped.data(), mapped.size() );
+        jsin.skip_value();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    long diff = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+    printf( "%d files, %ld bytes: %ld us mapped and skipped over.\n", int( files.size() ), bytes, diff );
+}
@@ -0,0 +1,141 @@
+#include "catch/catch.hpp"
+
+#include "calendar.h"
+#include "field.h"
+#include "game.h"
+#include "map.h"
+#include "mapdata.h"
+#include "player.h"
+#include "weather.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <stdio.h>
+
+typedef float light_grid[MAPSIZE * SEEX][MAPSIZE * SEEY];
+
+static void clear_map()
+{
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            const tripoint p( x, y, 0 );
+            g->m.set( x, y, t_grass, f_null );
+            while( g->m.field_at( p ).fieldCount() > 0 ) {
+                g->m.remove_field( p, g->m.field_at( p ).begin()->first );
+            }
+        }
+    }
+    g->weather = WEATHER_CLEAR;
+    g->m.set_transparency_cache_dirty( 0 );
+    g->u.setpos( tripoint( mapsize / 2, mapsize / 2, 0 ) );
+}
+
+// A town on fire, with walls around the fires
+static void start_fires( const int count )
+{
+    std::default_random_engine generator( 11 );
+    std::uniform_int_distribution<int> position( 2, g->m.getmapsize() * SEEX - 3 );
+    std::uniform_int_distribution<int> density( 1, 3 );
+    for( int i = 0; i < count; i++ ) {
+        const tripoint p( position( generator ), position( generator ), 0 );
+        g->m.add_field( p, fd_fire, density( generator ), 0 );
+        g->m.ter_set( p + tripoint( 2, 0, 0 ), t_wall );
+        g->m.ter_set( p + tripoint( 0, -2, 0 ), t_wall );
+    }
+}
+
+// Builds the lightmap with whatever is cached and again by casting every light source
+// straight into the lightmap, like before there was a cache, they must be the same
+static void check_cached_lightmap()
+{
+    static light_grid cached_lm;
+    static light_grid cached_sm;
+    g->m.build_map_cache( 0 );
+    std::memcpy( cached_lm, g->m.get_cache_ref( 0 ).lm, sizeof( cached_lm ) );
+    std::memcpy( cached_sm, g->m.get_cache_ref( 0 ).sm, sizeof( cached_sm ) );
+
+    g->m.set_light_source_cache_enabled( false );
+    g->m.build_map_cache( 0 );
+    g->m.set_light_source_cache_enabled( true );
+    CHECK( std::memcmp( cached_lm, g->m.get_cache_ref( 0 ).lm, sizeof( cached_lm ) ) == 0 );
+    CHECK( std::memcmp( cached_sm, g->m.get_cache_ref( 0 ).sm, sizeof( cached_sm ) ) == 0 );
+}
+
+// Midnight, so that the fires are what lights the map
+static void set_midnight()
+{
+    calendar::turn = calendar::turn.get_turn() - calendar::turn.seconds_past_midnight() / 6;
+}
+
+TEST_CASE( "cached_light_sources_match_casting_them_again" )
+{
+    const int old_turn = calendar::turn;
+    set_midnight();
+    clear_map();
+    start_fires( 30 );
+    g->m.add_field( tripoint( 40, 40, 0 ), fd_fire, 3, 0 );
+    g->m.ter_set( tripoint( 60, 40, 0 ), t_lava );
+    check_cached_lightmap();
+
+    SECTION( "a wall goes up near a fire" ) {
+        g->m.ter_set( tripoint( 43, 40, 0 ), t_wall );
+        check_cached_lightmap();
+        g->m.ter_set( tripoint( 43, 40, 0 ), t_grass );
+        check_cached_lightmap();
+    }
+    SECTION( "a fire shrinks, another one goes out" ) {
+        g->m.get_field( tripoint( 40, 40, 0 ), fd_fire )->setFieldDensity( 1 );
+        g->m.remove_field( tripoint( 60, 40, 0 ), fd_fire );
+        g->m.ter_set( tripoint( 60, 40, 0 ), t_grass );
+        check_cached_lightmap();
+    }
+    SECTION( "a fire grows and lights further" ) {
+        g->m.add_field( tripoint( 50, 50, 0 ), fd_fire, 1, 0 );
+        check_cached_lightmap();
+        g->m.get_field( tripoint( 50, 50, 0 ), fd_fire )->setFieldDensity( 3 );
+        check_cached_lightmap();
+    }
+    SECTION( "a fire starts next to another one" ) {
+        g->m.add_field( tripoint( 41, 40, 0 ), fd_fire, 3, 0 );
+        check_cached_lightmap();
+    }
+    SECTION( "smoke drifts through" ) {
+        for( int x = 30; x < 50; x++ ) {
+            g->m.add_field( tripoint( x, 45, 0 ), fd_smoke, 2, 0 );
+        }
+        g->m.set_transparency_cache_dirty( 0 );
+        check_cached_lightmap();
+    }
+    clear_map();
+    calendar::turn = old_turn;
+}
+
+static long time_lightmap( const int iterations, const bool cached )
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        if( !cached ) {
+            g->m.clear_light_source_cache();
+        }
+        g->m.build_map_cache( 0 );
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+}
+
+TEST_CASE( "light_source_cache_performance", "[.]" )
+{
+    const int old_turn = calendar::turn;
+    set_midnight();
+    clear_map();
+    start_fires( 300 );
+    const int iterations = 100;
+    const long uncached = time_lightmap( iterations, false );
+    const long cached = time_lightmap( iterations, true );
+    printf( "300 fires: %ld us casting every light source, %ld us cached for %d lightmaps.\n",
+            uncached, cached, iterations );
+    clear_map();
+    calendar::turn = old_turn;
+}
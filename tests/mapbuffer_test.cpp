@@ -0,0 +1,186 @@
+#include "catch/catch.hpp"
+
+#include "coordinate_conversions.h"
+#include "field.h"
+#include "filesystem.h"
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "options.h"
+#include "submap.h"
+#include "trap.h"
+#include "worldfactory.h"
+
+#include <fstream>
+#include <sstream>
+
+// Adds a full quad with the given terrain, returns its north-west submap coordinates
+static tripoint add_far_quad( const int index, const ter_id terrain )
+{
+    const tripoint origin = omt_to_sm_copy( sm_to_omt_copy( g->m.get_abs_sub() ) +
+                                            tripoint( 500 + index, 500, 0 ) );
+    for( int x = 0; x < 2; x++ ) {
+        for( int y = 0; y < 2; y++ ) {
+            submap *sm = new submap();
+            for( int i = 0; i < SEEX; i++ ) {
+                for( int j = 0; j < SEEY; j++ ) {
+                    sm->set_ter( i, j, terrain );
+                }
+            }
+            REQUIRE( MAPBUFFER.add_submap( origin + tripoint( x, y, 0 ), sm ) );
+        }
+    }
+    return origin;
+}
+
+TEST_CASE( "mapbuffer_unloads_least_recently_used_quads" )
+{
+    const std::string old_limit = OPTIONS["MAP_MEMORY_LIMIT"].getValue();
+    OPTIONS["MAP_MEMORY_LIMIT"].setValue( "0" );
+
+    std::vector<tripoint> quads;
+    for( int i = 0; i < 20; i++ ) {
+        quads.push_back( add_far_quad( i, i % 2 == 0 ? t_dirt : t_grass ) );
+    }
+    // No limit, nothing happens
+    const size_t before = MAPBUFFER.quad_count();
+    MAPBUFFER.unload_unused();
+    CHECK( MAPBUFFER.quad_count() == before );
+
+    OPTIONS["MAP_MEMORY_LIMIT"].setValue( "1" );
+    MAPBUFFER.unload_unused();
+    const size_t after = MAPBUFFER.quad_count();
+    CHECK( after < before );
+
+    // The reality bubble stays loaded
+    CHECK( MAPBUFFER.quad_count() > 0 );
+    CHECK( g->m.ter( tripoint( SEEX * MAPSIZE / 2, SEEY * MAPSIZE / 2, 0 ) ) != t_null );
+
+    // Unloaded quads come back from disk, unchanged
+    for( size_t i = 0; i < quads.size(); i++ ) {
+        const submap *sm = MAPBUFFER.lookup_submap( quads[i] + tripoint( 1, 1, 0 ) );
+        REQUIRE( sm != nullptr );
+        CHECK( sm->get_ter( 3, 4 ) == ( i % 2 == 0 ? t_dirt : t_grass ) );
+    }
+    CHECK( MAPBUFFER.quad_count() > after );
+    CHECK( MAPBUFFER.quad_count() <= before );
+
+    OPTIONS["MAP_MEMORY_LIMIT"].setValue( old_limit );
+}
+
+// A quad far from the reality bubble with a bit of everything on it
+static tripoint add_varied_quad( const int index )
+{
+    const tripoint origin = add_far_quad( index, t_dirt );
+    for( int x = 0; x < 2; x++ ) {
+        for( int y = 0; y < 2; y++ ) {
+            submap *sm = MAPBUFFER.lookup_submap( origin + tripoint( x, y, 0 ) );
+            for( int i = 0; i < SEEX; i++ ) {
+                sm->set_ter( i, 0, t_wall );
+                sm->set_radiation( i, 1, i );
+            }
+            sm->set_furn( 2, 3, f_chair );
+            sm->set_trap( 4, 5, tr_beartrap );
+            sm->fld[6][7].addField( fd_blood, 2, 10 );
+            sm->mark_field_tile( 6, 7 );
+            sm->field_count++;
+            sm->itm[8][9].push_back( item( "rock", 0 ) );
+            sm->set_graffiti( 10, 11, "Binary" );
+        }
+    }
+    return origin;
+}
+
+static void check_varied_quad( const tripoint &origin )
+{
+    for( int x = 0; x < 2; x++ ) {
+        for( int y = 0; y < 2; y++ ) {
+            const submap *sm = MAPBUFFER.lookup_submap( origin + tripoint( x, y, 0 ) );
+            REQUIRE( sm != nullptr );
+            CHECK( sm->get_ter( 3, 0 ) == t_wall );
+            CHECK( sm->get_ter( 3, 4 ) == t_dirt );
+            CHECK( sm->get_radiation( 5, 1 ) == 5 );
+            CHECK( sm->get_radiation( 5, 2 ) == 0 );
+            CHECK( sm->get_furn( 2, 3 ) == f_chair );
+            CHECK( sm->get_furn( 3, 3 ) == f_null );
+            CHECK( sm->get_trap( 4, 5 ) == tr_beartrap );
+            const field_entry *blood = sm->fld[6][7].findFieldc( fd_blood );
+            REQUIRE( blood != nullptr );
+            CHECK( blood->getFieldDensity() == 2 );
+            CHECK( blood->getFieldAge() == 10 );
+            CHECK( sm->field_count == 1 );
+            CHECK( sm->field_tiles.count() == 1 );
+            REQUIRE( sm->itm[8][9].size() == 1 );
+            CHECK( sm->itm[8][9].front().typeId() == "rock" );
+            CHECK( sm->get_graffiti( 10, 11 ) == "Binary" );
+        }
+    }
+}
+
+static std::string quad_file( const tripoint &origin, const std::string &extension )
+{
+    const tripoint om_addr = sm_to_omt_copy( origin );
+    const tripoint segment_addr = omt_to_seg_copy( om_addr );
+    std::stringstream path;
+    path << world_generator->active_world->world_path << "/maps/" << segment_addr.x << "." <<
+         segment_addr.y << "." << segment_addr.z << "/" << om_addr.x << "." << om_addr.y << "." <<
+         om_addr.z << extension;
+    return path.str();
+}
+
+static long file_size( const std::string &path )
+{
+    std::ifstream fin( path.c_str(), std::ios_base::binary | std::ios_base::ate );
+    return fin ? long( fin.tellg() ) : -1;
+}
+
+// Saves and unloads all quads outside the reality bubble
+static void unload_far_quads()
+{
+    const std::string old_limit = OPTIONS["MAP_MEMORY_LIMIT"].getValue();
+    OPTIONS["MAP_MEMORY_LIMIT"].setValue( "1" );
+    MAPBUFFER.unload_unused();
+    OPTIONS["MAP_MEMORY_LIMIT"].setValue( old_limit );
+}
+
+TEST_CASE( "quads_survive_saving_in_either_format" )
+{
+    const std::string old_format = OPTIONS["MAP_SAVE_FORMAT"].getValue();
+    const tripoint json_quad = add_varied_quad( 100 );
+    const tripoint binary_quad = add_varied_quad( 101 );
+
+    OPTIONS["MAP_SAVE_FORMAT"].setValue( "json" );
+    unload_far_quads();
+    REQUIRE( file_exist( quad_file( json_quad, ".map" ) ) );
+    CHECK_FALSE( file_exist( quad_file( json_quad, ".bmap" ) ) );
+    // Both quads hold the same, so their files can be compared
+    const long json_size = file_size( quad_file( json_quad, ".map" ) );
+    check_varied_quad( json_quad );
+    check_varied_quad( binary_quad );
+
+    OPTIONS["MAP_SAVE_FORMAT"].setValue( "binary" );
+    unload_far_quads();
+    // Saving in the other format replaces the old file
+    REQUIRE( file_exist( quad_file( binary_quad, ".bmap" ) ) );
+    CHECK_FALSE( file_exist( quad_file( binary_quad, ".map" ) ) );
+    const long binary_size = file_size( quad_file( binary_quad, ".bmap" ) );
+    INFO( "json " << json_size << " bytes, binary " << binary_size << " bytes" );
+    CHECK( binary_size > 0 );
+    CHECK( binary_size < json_size );
+    check_varied_quad( binary_quad );
+
+    // Converting turns every saved quad into the selected format
+    check_varied_quad( json_quad );
+    OPTIONS["MAP_SAVE_FORMAT"].setValue( "json" );
+    unload_far_quads();
+    REQUIRE( file_exist( quad_file( json_quad, ".map" ) ) );
+    OPTIONS["MAP_SAVE_FORMAT"].setValue( "binary" );
+    CHECK( MAPBUFFER.convert_saved_quads() > 0 );
+    CHECK( file_exist( quad_file( json_quad, ".bmap" ) ) );
+    CHECK_FALSE( file_exist( quad_file( json_quad, ".map" ) ) );
+    check_varied_quad( json_quad );
+
+    OPTIONS["MAP_SAVE_FORMAT"].setValue( old_format );
+}
@@ -0,0 +1,74 @@
+#include "catch/catch.hpp"
+
+#include "creature_tracker.h"
+#include "game.h"
+#include "map.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "mtype.h"
+#include "player.h"
+#include "thread_pool.h"
+
+#include <atomic>
+#include <vector>
+
+TEST_CASE( "thread_pool_runs_every_index_once" )
+{
+    thread_pool pool( 3 );
+    std::vector<std::atomic<int>> hits( 1000 );
+    for( auto &h : hits ) {
+        h = 0;
+    }
+    for( int repeat = 0; repeat < 10; repeat++ ) {
+        pool.parallel_for( hits.size(), [&]( size_t i ) {
+            hits[i]++;
+        } );
+    }
+    for( auto &h : hits ) {
+        CHECK( h == 10 );
+    }
+}
+
+TEST_CASE( "monster_plans_dont_depend_on_thread_count" )
+{
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            g->m.set( x, y, t_grass, f_null );
+        }
+    }
+    while( g->num_zombies() ) {
+        g->remove_zombie( 0 );
+    }
+    g->u.setpos( { 60, 60, 0 } );
+
+    const std::vector<std::string> types = {{ "mon_zombie", "mon_dog", "mon_zombie_dog", "mon_fox_red" }};
+    for( int i = 0; i < 40; i++ ) {
+        monster temp( mtype_id( types[i % types.size()] ), tripoint( 50 + i % 20, 50 + i / 2, 0 ) );
+        g->critter_tracker->add( temp );
+    }
+
+    std::vector<monster_plan> serial( g->num_zombies() );
+    for( size_t i = 0; i < serial.size(); i++ ) {
+        serial[i] = g->zombie( i ).plan_targets();
+    }
+
+    thread_pool pool( 3 );
+    std::vector<monster_plan> parallel( g->num_zombies() );
+    pool.parallel_for( parallel.size(), [&]( size_t i ) {
+        parallel[i] = g->zombie( i ).plan_targets();
+    } );
+
+    for( size_t i = 0; i < serial.size(); i++ ) {
+        CHECK( serial[i].target == parallel[i].target );
+        CHECK( serial[i].dist == parallel[i].dist );
+        CHECK( serial[i].fleeing == parallel[i].fleeing );
+        CHECK( serial[i].anger_change == parallel[i].anger_change );
+        CHECK( serial[i].morale_change == parallel[i].morale_change );
+    }
+
+    while( g->num_zombies() ) {
+        g->remove_zombie( 0 );
+    }
+    g->u.setpos( { 0, 0, -2 } );
+}
@@ -0,0 +1,89 @@
+#include "catch/catch.hpp"
+
+#include "options.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string>
+
+TEST_CASE( "option_handles_follow_the_options" )
+{
+    const option<int> autosave_turns( "AUTOSAVE_TURNS" );
+    const option<bool> animations( "ANIMATIONS" );
+    const option<float> training_speed( "SKILL_TRAINING_SPEED" );
+    const option<std::string> skill_rust( "SKILL_RUST" );
+    const std::string old_turns = OPTIONS["AUTOSAVE_TURNS"].getValue();
+    const std::string old_animations = OPTIONS["ANIMATIONS"].getValue();
+    const std::string old_rust = OPTIONS["SKILL_RUST"].getValue();
+
+    OPTIONS["AUTOSAVE_TURNS"].setValue( "77" );
+    CHECK( autosave_turns.get() == 77 );
+    OPTIONS["AUTOSAVE_TURNS"].setValue( "78" );
+    CHECK( autosave_turns.get() == 78 );
+
+    OPTIONS["ANIMATIONS"].setValue( "false" );
+    CHECK_FALSE( animations.get() );
+    OPTIONS["ANIMATIONS"].setNext();
+    CHECK( animations.get() );
+
+    CHECK( training_speed.get() == static_cast<float>( OPTIONS["SKILL_TRAINING_SPEED"] ) );
+
+    OPTIONS["SKILL_RUST"].setValue( "off" );
+    CHECK( skill_rust.get() == "off" );
+
+    // Options replaced as a whole have to be announced
+    auto saved = OPTIONS;
+    OPTIONS["AUTOSAVE_TURNS"].setValue( "79" );
+    OPTIONS = saved;
+    options_manager::notify_changed();
+    CHECK( autosave_turns.get() == 78 );
+
+    OPTIONS["AUTOSAVE_TURNS"].setValue( old_turns );
+    OPTIONS["ANIMATIONS"].setValue( old_animations );
+    OPTIONS["SKILL_RUST"].setValue( old_rust );
+}
+
+TEST_CASE( "world_option_handles_read_the_active_world" )
+{
+    const world_option<float> spawnrate( "ITEM_SPAWNRATE" );
+    const std::string old_rate = ACTIVE_WORLD_OPTIONS["ITEM_SPAWNRATE"].getValue();
+    const std::string old_global_rate = OPTIONS["ITEM_SPAWNRATE"].getValue();
+    ACTIVE_WORLD_OPTIONS["ITEM_SPAWNRATE"].setValue( 2.5f );
+    CHECK( spawnrate.get() == Approx( 2.5f ) );
+    // A global option of the same name doesn't matter
+    OPTIONS["ITEM_SPAWNRATE"].setValue( 3.0f );
+    CHECK( spawnrate.get() == Approx( 2.5f ) );
+    ACTIVE_WORLD_OPTIONS["ITEM_SPAWNRATE"].setValue( old_rate );
+    OPTIONS["ITEM_SPAWNRATE"].setValue( old_global_rate );
+}
+
+TEST_CASE( "option_handle_performance", "[.]" )
+{
+    const option<bool> animations( "ANIMATIONS" );
+    const world_option<float> spawnrate( "ITEM_SPAWNRATE" );
+    const int reads = 1000000;
+    float sum1 = 0;
+    float sum2 = 0;
+
+    auto start1 = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < reads; i++ ) {
+        if( OPTIONS["ANIMATIONS"] ) {
+            sum1 += ACTIVE_WORLD_OPTIONS["ITEM_SPAWNRATE"];
+        }
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+
+    auto start2 = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < reads; i++ ) {
+        if( animations ) {
+            sum2 += spawnrate;
+        }
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+
+    CHECK( sum1 == sum2 );
+    long diff1 = std::chrono::duration_cast<std::chrono::microseconds>( end1 - start1 ).count();
+    long diff2 = std::chrono::duration_cast<std::chrono::microseconds>( end2 - start2 ).count();
+    printf( "%d times two options: %ld us looked up by name, %ld us with handles.\n", reads, diff1,
+            diff2 );
+}
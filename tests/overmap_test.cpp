@@ -1,6 +1,16 @@
 #include "catch/catch.hpp"
 
+#include "coordinate_conversions.h"
+#include "game.h"
+#include "mongroup.h"
+#include "options.h"
 #include "overmap.h"
+#include "overmapbuffer.h"
+#include "player.h"
+
+#include <iterator>
+#include <string>
+#include <vector>
 
 TEST_CASE( "set_and_get_overmap_scents" ) {
     overmap test_overmap;
@@ -19,3 +29,138 @@ TEST_CASE( "set_and_get_overmap_scents" ) {
     REQUIRE( test_overmap.scent_at( { 75, 85, 0} ).creation_turn == 50 );
     REQUIRE( test_overmap.scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
+
+TEST_CASE( "mongroup_map_keeps_groups_in_place" ) {
+    const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
+    mongroup_map groups;
+    mongroup &first = groups.insert( mongroup( GROUP_ZOMBIE, 1, 1, 0, 1, 5 ) );
+    mongroup &second = groups.insert( mongroup( GROUP_ZOMBIE, 1, 1, 0, 1, 6 ) );
+    mongroup &third = groups.insert( mongroup( GROUP_ZOMBIE, 2, 2, 0, 1, 7 ) );
+    REQUIRE( groups.size() == 3 );
+    CHECK( groups.at( { 1, 1, 0 } ) == std::vector<mongroup *>( { &first, &second } ) );
+    CHECK( groups.at( { 3, 3, 0 } ).empty() );
+
+    groups.move( first, { 2, 2, 0 } );
+    CHECK( first.pos == tripoint( 2, 2, 0 ) );
+    CHECK( groups.at( { 1, 1, 0 } ) == std::vector<mongroup *>( { &second } ) );
+    CHECK( groups.at( { 2, 2, 0 } ) == std::vector<mongroup *>( { &third, &first } ) );
+
+    mongroup_map other;
+    auto it = std::next( groups.begin() );
+    REQUIRE( &*it == &second );
+    groups.transfer( it, other, { 5, 5, 0 } );
+    CHECK( groups.size() == 2 );
+    CHECK( groups.at( { 1, 1, 0 } ).empty() );
+    REQUIRE( other.size() == 1 );
+    CHECK( &*other.begin() == &second );
+    CHECK( other.at( { 5, 5, 0 } ) == std::vector<mongroup *>( { &second } ) );
+
+    it = groups.erase( groups.begin() );
+    CHECK( &*it == &third );
+    CHECK( groups.at( { 2, 2, 0 } ) == std::vector<mongroup *>( { &third } ) );
+    CHECK( third.population == 7 );
+}
+
+TEST_CASE( "mongroup_map_copy_has_its_own_index" ) {
+    const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
+    mongroup_map groups;
+    groups.insert( mongroup( GROUP_ZOMBIE, 1, 1, 0, 1, 5 ) );
+    mongroup &moved = groups.insert( mongroup( GROUP_ZOMBIE, 2, 2, 0, 1, 6 ) );
+    groups.insert( mongroup( GROUP_ZOMBIE, 1, 1, 0, 1, 7 ) );
+    groups.move( moved, { 1, 1, 0 } );
+
+    mongroup_map copy( groups );
+    REQUIRE( copy.size() == 3 );
+    const std::vector<mongroup *> &at_copy = copy.at( { 1, 1, 0 } );
+    REQUIRE( at_copy.size() == 3 );
+    CHECK( at_copy[0] == &*copy.begin() );
+    CHECK( at_copy[1] == &*std::next( copy.begin(), 2 ) );
+    CHECK( at_copy[2] == &*std::next( copy.begin() ) );
+
+    mongroup_map assigned;
+    assigned.insert( mongroup( GROUP_ZOMBIE, 3, 3, 0, 1, 8 ) );
+    assigned = groups;
+    groups.clear();
+    CHECK( assigned.at( { 3, 3, 0 } ).empty() );
+    REQUIRE( assigned.at( { 1, 1, 0 } ).size() == 3 );
+    for( const mongroup *group : assigned.at( { 1, 1, 0 } ) ) {
+        CHECK( group->pos == tripoint( 1, 1, 0 ) );
+    }
+    assigned.erase( assigned.begin() );
+    CHECK( assigned.at( { 1, 1, 0 } ).size() == 2 );
+}
+
+static mongroup *add_horde( overmap &om, const tripoint &pos, const tripoint &target ) {
+    mongroup horde( mongroup_id( "GROUP_ZOMBIE" ), pos.x, pos.y, pos.z, 1, 10 );
+    horde.horde = true;
+    horde.target = target;
+    horde.interest = 100;
+    const point om_sm = om_to_sm_copy( om.pos() );
+    const std::vector<mongroup *> added = overmap_buffer.groups_at( om_sm.x + pos.x, om_sm.y + pos.y,
+                                                                     pos.z );
+    om.add_mon_group( horde );
+    const std::vector<mongroup *> now = overmap_buffer.groups_at( om_sm.x + pos.x, om_sm.y + pos.y,
+                                                                   pos.z );
+    REQUIRE( now.size() == added.size() + 1 );
+    return now.back();
+}
+
+TEST_CASE( "hordes_walk_into_loaded_overmaps" ) {
+    const tripoint center = g->u.global_sm_location();
+    const point om_pos = sm_to_om_copy( center.x, center.y );
+    overmap &om = overmap_buffer.get( om_pos.x, om_pos.y );
+    overmap &east = overmap_buffer.get( om_pos.x + 1, om_pos.y );
+    om.clear_mon_groups();
+    east.clear_mon_groups();
+
+    mongroup *horde = add_horde( om, { OMAPX * 2 - 1, 10, 0 }, { OMAPX * 2 + 20, 10, 0 } );
+    horde->horde_behaviour = "roam";
+    for( int turn = 0; turn < 200 && horde->pos.x == OMAPX * 2 - 1; turn++ ) {
+        overmap_buffer.move_hordes();
+        horde->interest = 100;
+    }
+    // The same group, now on the next overmap with its position and target relative to it
+    REQUIRE( horde->pos == tripoint( 0, 10, 0 ) );
+    CHECK( horde->target == tripoint( 20, 10, 0 ) );
+    CHECK( om.num_mongroups() == 0 );
+    CHECK( east.num_mongroups() == 1 );
+    const point east_sm = om_to_sm_copy( east.pos() );
+    CHECK( overmap_buffer.groups_at( east_sm.x, east_sm.y + 10, 0 ) ==
+           std::vector<mongroup *>( { horde } ) );
+    om.clear_mon_groups();
+    east.clear_mon_groups();
+}
+
+// Where the hordes are after some turns with the given number of threads
+static std::vector<tripoint> moved_hordes( const int threads ) {
+    const tripoint center = g->u.global_sm_location();
+    const point om_pos = sm_to_om_copy( center.x, center.y );
+    overmap &om = overmap_buffer.get( om_pos.x, om_pos.y );
+    om.clear_mon_groups();
+    std::vector<mongroup *> hordes;
+    for( int i = 0; i < 20; i++ ) {
+        const tripoint pos( 20 + i * 7, 30 + ( i * 13 ) % 100, 0 );
+        hordes.push_back( add_horde( om, pos, pos ) );
+    }
+
+    OPTIONS["HORDE_THREADS"].setValue( std::to_string( threads ) );
+    srand( 42 );
+    for( int turn = 0; turn < 30; turn++ ) {
+        overmap_buffer.move_hordes();
+    }
+    OPTIONS["HORDE_THREADS"].setValue( "1" );
+
+    std::vector<tripoint> result;
+    for( const mongroup *horde : hordes ) {
+        result.push_back( horde->pos );
+        result.push_back( horde->target );
+    }
+    om.clear_mon_groups();
+    return result;
+}
+
+TEST_CASE( "horde_movement_does_not_depend_on_threads" ) {
+    const std::vector<tripoint> single = moved_hordes( 1 );
+    CHECK( moved_hordes( 4 ) == single );
+    CHECK( moved_hordes( 1 ) == single );
+}
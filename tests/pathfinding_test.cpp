@@ -0,0 +1,177 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "map.h"
+#include "mapdata.h"
+#include "pathfinding.h"
+#include "player.h"
+#include "rng.h"
+#include "vehicle.h"
+
+#include <chrono>
+#include <vector>
+
+static void wipe_map_terrain()
+{
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            g->m.set( x, y, t_grass, f_null );
+        }
+    }
+}
+
+// Scatters wall segments around the map, so that straight lines rarely work
+static void build_maze()
+{
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int x = 4; x < mapsize - 4; x += 6 ) {
+        const int gap = rng( 2, mapsize - 3 );
+        for( int y = 1; y < mapsize - 1; ++y ) {
+            if( abs( y - gap ) > 1 ) {
+                g->m.set( x, y, t_wall, f_null );
+            }
+        }
+    }
+}
+
+static bool is_connected( const std::vector<tripoint> &path, const tripoint &from, const tripoint &to )
+{
+    if( path.empty() || path.back() != to ) {
+        return false;
+    }
+
+    tripoint prev = from;
+    for( const tripoint &p : path ) {
+        if( rl_dist( prev, p ) != 1 || g->m.impassable( p ) ) {
+            return false;
+        }
+        prev = p;
+    }
+
+    return true;
+}
+
+TEST_CASE( "route_around_walls" )
+{
+    wipe_map_terrain();
+    g->u.setpos( { 0, 0, -2 } );
+    const tripoint from( 60, 60, 0 );
+    const tripoint to( 70, 60, 0 );
+    // Short enough to be walked around within route's search box
+    for( int y = 55; y <= 65; y++ ) {
+        g->m.set( 65, y, t_wall, f_null );
+    }
+
+    const auto first = g->m.route( from, to, 0, 1000 );
+    CHECK( is_connected( first, from, to ) );
+
+    // The workspace is reused, so a later search must not see stale data
+    const tripoint other( 70, 68, 0 );
+    const auto detour = g->m.route( from, other, 0, 1000 );
+    CHECK( is_connected( detour, from, other ) );
+
+    const auto second = g->m.route( from, to, 0, 1000 );
+    CHECK( first == second );
+
+    wipe_map_terrain();
+}
+
+TEST_CASE( "pathfinding_cache_follows_terrain" )
+{
+    wipe_map_terrain();
+    const tripoint p( 60, 60, 0 );
+    CHECK( g->m.get_pathfinding_cache_ref( 0 ).move_cost[p.x][p.y] == g->m.move_cost( p ) );
+
+    g->m.ter_set( p, t_wall );
+    const auto &walled = g->m.get_pathfinding_cache_ref( 0 );
+    CHECK( walled.move_cost[p.x][p.y] == 0 );
+    CHECK( ( walled.special[p.x][p.y] & PF_BASHABLE ) != 0 );
+
+    g->m.ter_set( p, t_grass );
+    const auto &cleared = g->m.get_pathfinding_cache_ref( 0 );
+    CHECK( cleared.move_cost[p.x][p.y] == g->m.move_cost( p ) );
+    CHECK( cleared.special[p.x][p.y] == PF_NORMAL );
+}
+
+TEST_CASE( "pathfinding_cache_follows_vehicle_obstacles" )
+{
+    wipe_map_terrain();
+    g->u.setpos( { 0, 0, -2 } );
+    const int mapsize = g->m.getmapsize() * SEEX;
+    const tripoint from( 60, 60, 0 );
+    const tripoint to( 70, 60, 0 );
+    const tripoint gap( 65, 60, 0 );
+    // A wall across the whole map, the only way through is blocked by a vehicle board
+    for( int y = 0; y < mapsize; y++ ) {
+        if( y != gap.y ) {
+            g->m.set( gap.x, y, t_wall, f_null );
+        }
+    }
+    vehicle *veh = g->m.add_vehicle( vproto_id( "none" ), gap, 0, 0, 0 );
+    REQUIRE( veh != nullptr );
+    // The frame is too tough to break, so that only the board gives way
+    veh->install_part( 0, 0, vpart_str_id( "frame_vertical" ), 100000, true );
+    const int board = veh->install_part( 0, 0, vpart_str_id( "board_vertical" ), -1, true );
+    REQUIRE( board >= 0 );
+    g->m.add_vehicle_to_cache( veh );
+    REQUIRE( g->m.impassable( gap ) );
+    CHECK( g->m.get_pathfinding_cache_ref( 0 ).move_cost[gap.x][gap.y] == 0 );
+    CHECK( g->m.route( from, to, 0, 1000 ).empty() );
+
+    SECTION( "a broken board lets the route through" ) {
+        while( veh->parts[board].hp > 0 ) {
+            veh->damage( board, 50, DT_TRUE );
+        }
+        REQUIRE_FALSE( g->m.impassable( gap ) );
+        CHECK( g->m.get_pathfinding_cache_ref( 0 ).move_cost[gap.x][gap.y] == g->m.move_cost( gap ) );
+        CHECK( is_connected( g->m.route( from, to, 0, 1000 ), from, to ) );
+
+        // A new board closes the way again
+        veh->install_part( 0, 0, vpart_str_id( "board_vertical" ), -1, true );
+        REQUIRE( g->m.impassable( gap ) );
+        CHECK( g->m.get_pathfinding_cache_ref( 0 ).move_cost[gap.x][gap.y] == 0 );
+        CHECK( g->m.route( from, to, 0, 1000 ).empty() );
+    }
+
+    g->m.destroy_vehicle( veh );
+    wipe_map_terrain();
+}
+
+static void route_benchmark( const int iterations )
+{
+    wipe_map_terrain();
+    build_maze();
+    g->u.setpos( { 0, 0, -2 } );
+    const int mapsize = g->m.getmapsize() * SEEX;
+
+    std::vector<std::pair<tripoint, tripoint>> pairs;
+    pairs.reserve( iterations );
+    while( static_cast<int>( pairs.size() ) < iterations ) {
+        const tripoint from( rng( 1, mapsize - 2 ), rng( 1, mapsize - 2 ), 0 );
+        const tripoint to( rng( 1, mapsize - 2 ), rng( 1, mapsize - 2 ), 0 );
+        if( !g->m.impassable( from ) && !g->m.impassable( to ) ) {
+            pairs.emplace_back( from, to );
+        }
+    }
+
+    int found = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for( const auto &pr : pairs ) {
+        if( !g->m.route( pr.first, pr.second, 0, 1000 ).empty() ) {
+            found++;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    long diff = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+    printf( "map::route() executed %d times in %ld microseconds, %d routes found.\n",
+            iterations, diff, found );
+
+    wipe_map_terrain();
+}
+
+TEST_CASE( "route_performance", "[.]" )
+{
+    route_benchmark( 1000 );
+}
@@ -0,0 +1,83 @@
+#include "catch/catch.hpp"
+
+#include "coordinate_conversions.h"
+#include "game.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "player.h"
+#include "quad_pregenerator.h"
+
+#include <algorithm>
+
+TEST_CASE( "pregeneration_predicts_quads_ahead" )
+{
+    const tripoint pos( 1000, 1000, 0 );
+    const tripoint omt = ms_to_omt_copy( pos );
+    CHECK( quad_pregenerator::predict( pos, 0.0, 0.0, 5 ).empty() );
+
+    const std::vector<tripoint> east = quad_pregenerator::predict( pos, 20.0, 0.0, 5 );
+    REQUIRE_FALSE( east.empty() );
+    // Only quads ahead of the reality bubble, the nearest and straight ahead first
+    for( const tripoint &quad : east ) {
+        CHECK( quad.x > omt.x );
+        CHECK( quad.z == pos.z );
+    }
+    CHECK( east.front().y == omt.y );
+    for( size_t i = 1; i < east.size(); i++ ) {
+        CHECK( east[i - 1].x <= east[i].x );
+    }
+    // Covers the width of the bubble
+    const auto by_y = std::minmax_element( east.begin(), east.end(),
+    []( const tripoint & a, const tripoint & b ) {
+        return a.y < b.y;
+    } );
+    const int width = by_y.second->y - by_y.first->y;
+    CHECK( width >= MAPSIZE / 2 );
+
+    // Faster means further
+    CHECK( quad_pregenerator::predict( pos, 40.0, 0.0, 5 ).size() > east.size() );
+
+    for( const tripoint &quad : quad_pregenerator::predict( pos, 0.0, -20.0, 5 ) ) {
+        CHECK( quad.y < omt.y );
+    }
+}
+
+TEST_CASE( "pregeneration_fills_the_mapbuffer_within_budget" )
+{
+    // Far away from anything generated so far, on the ground whatever level other tests left
+    const tripoint here = g->m.getabs( g->u.pos() );
+    const tripoint start( here.x, here.y + 50 * SEEY * MAPSIZE, 0 );
+    quad_pregenerator pregen;
+    // Standing still or without a budget does nothing, but the moves are remembered
+    CHECK( pregen.process( start, -1, false, 4 ) == 0 );
+    CHECK( pregen.process( start + tripoint( 20, 0, 0 ), -1, false, 0 ) == 0 );
+
+    const tripoint pos = start + tripoint( 40, 0, 0 );
+    const std::vector<tripoint> expected = quad_pregenerator::predict( pos, 15.0, 0.0, 5 );
+    for( const tripoint &quad : expected ) {
+        REQUIRE( MAPBUFFER.lookup_submap( omt_to_sm_copy( quad ) ) == nullptr );
+    }
+    CHECK( pregen.process( pos, -1, false, 2 ) == 2 );
+    CHECK( MAPBUFFER.lookup_submap( omt_to_sm_copy( expected[0] ) ) != nullptr );
+    CHECK( MAPBUFFER.lookup_submap( omt_to_sm_copy( expected[1] ) + tripoint( 1, 1, 0 ) ) != nullptr );
+    CHECK( MAPBUFFER.lookup_submap( omt_to_sm_copy( expected[2] ) ) == nullptr );
+
+    // Each z-level counts against the budget, the level of the player comes first
+    const tripoint next = pos + tripoint( 15, 0, 0 );
+    const std::vector<tripoint> ahead = quad_pregenerator::predict( next, 15.0, 0.0, 5 );
+    const auto missing_on = [&ahead]( const int z ) {
+        return std::count_if( ahead.begin(), ahead.end(), [z]( const tripoint & quad ) {
+            return MAPBUFFER.lookup_submap( omt_to_sm_copy( tripoint( quad.x, quad.y, z ) ) ) == nullptr;
+        } );
+    };
+    const long missing = missing_on( 0 );
+    REQUIRE( missing > 2 );
+    REQUIRE( missing_on( -1 ) == static_cast<long>( ahead.size() ) );
+    CHECK( pregen.process( next, -1, true, 2 ) == 2 );
+    CHECK( missing_on( 0 ) == missing - 2 );
+    CHECK( missing_on( -1 ) == static_cast<long>( ahead.size() ) );
+
+    // A large budget is capped
+    CHECK( pregen.process( next + tripoint( 15, 0, 0 ), -1, true, 100 ) ==
+           quad_pregenerator::max_quads_per_turn );
+}
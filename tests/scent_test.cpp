@@ -0,0 +1,191 @@
+#include "catch/catch.hpp"
+
+#include "enums.h"
+#include "game.h"
+#include "map.h"
+#include "mapdata.h"
+#include "scent_map.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <stdio.h>
+
+// The scent diffusion as it was done in game::update_scent,
+// with the blocker flags taken from the same weights as the current one.
+static void old_update_scent( scent_grid &grscent, const scent_cache &cache,
+                              const point &center, const int radius )
+{
+    static int sum_3_scent_y[SEEY * MAPSIZE][SEEX * MAPSIZE];
+    static int squares_used_y[SEEY * MAPSIZE][SEEX * MAPSIZE];
+    static bool blocks_scent[SEEX * MAPSIZE][SEEY * MAPSIZE];
+    static bool reduces_scent[SEEX * MAPSIZE][SEEY * MAPSIZE];
+    for( int x = 0; x < SEEX * MAPSIZE; ++x ) {
+        for( int y = 0; y < SEEY * MAPSIZE; ++y ) {
+            blocks_scent[x][y] = cache.weight[x][y] == SCENT_BLOCKED;
+            reduces_scent[x][y] = cache.weight[x][y] == SCENT_REDUCED;
+        }
+    }
+
+    const int scentmap_minx = center.x - radius;
+    const int scentmap_maxx = center.x + radius;
+    const int scentmap_miny = center.y - radius;
+    const int scentmap_maxy = center.y + radius;
+    const int diffusivity = 100;
+
+    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = y - 1; i <= y + 1; ++i ) {
+                if( ! blocks_scent[x][i] ) {
+                    if( reduces_scent[x][i] ) {
+                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
+                        squares_used_y[y][x] += 2;
+                    } else {
+                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
+                        squares_used_y[y][x] += 10;
+                    }
+                }
+            }
+        }
+    }
+
+    for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
+        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+            if( ! blocks_scent[x][y] ) {
+                int squares_used = squares_used_y[y][x - 1]
+                                   + squares_used_y[y][x]
+                                   + squares_used_y[y][x + 1];
+
+                int this_diffusivity;
+                if( ! reduces_scent[x][y] ) {
+                    this_diffusivity = diffusivity;
+                } else {
+                    this_diffusivity = diffusivity / 5;
+                }
+                int temp_scent;
+                temp_scent = grscent[x][y] * ( 10 * 1000 - squares_used * this_diffusivity );
+                temp_scent -= grscent[x][y] * this_diffusivity * ( 90 - squares_used ) / 5;
+                grscent[x][y] =
+                    ( temp_scent
+                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
+                                             + sum_3_scent_y[y][x]
+                                             + sum_3_scent_y[y][x + 1] )
+                    ) / ( 1000 * 10 );
+
+                if( grscent[x][y] > 10000 ) {
+                    grscent[x][y] = 0;
+                }
+            } else {
+                grscent[x][y] = 0;
+            }
+        }
+    }
+}
+
+static scent_grid control;
+static scent_grid experiment;
+static scent_cache weights;
+
+static void randomize_weights( std::default_random_engine &generator )
+{
+    std::uniform_int_distribution<int> distribution( 0, 9 );
+    for( auto &column : weights.weight ) {
+        for( auto &w : column ) {
+            const int roll = distribution( generator );
+            w = roll == 0 ? SCENT_BLOCKED : roll == 1 ? SCENT_REDUCED : SCENT_NORMAL;
+        }
+    }
+}
+
+// Scent in a few blobs, most of the grid stays empty
+static void scatter_scent( std::default_random_engine &generator, const int blobs )
+{
+    std::memset( control, 0, sizeof( control ) );
+    std::uniform_int_distribution<int> position( 30, SEEX * MAPSIZE - 31 );
+    std::uniform_int_distribution<int> strength( 0, 500 );
+    for( int i = 0; i < blobs; i++ ) {
+        const int cx = position( generator );
+        const int cy = position( generator );
+        for( int x = cx - 3; x <= cx + 3; x++ ) {
+            for( int y = cy - 3; y <= cy + 3; y++ ) {
+                control[x][y] = strength( generator );
+            }
+        }
+    }
+    std::memcpy( experiment, control, sizeof( control ) );
+}
+
+static bool grids_match()
+{
+    return std::memcmp( control, experiment, sizeof( control ) ) == 0;
+}
+
+TEST_CASE( "scent_diffusion_matches_old_implementation" )
+{
+    const unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
+    std::default_random_engine generator( seed );
+    randomize_weights( generator );
+    std::uniform_int_distribution<int> center_offset( -6, 6 );
+    const int mid = SEEX * MAPSIZE / 2;
+
+    for( const int blobs : { 0, 1, 5, 200 } ) {
+        scatter_scent( generator, blobs );
+        for( int turn = 0; turn < 50; turn++ ) {
+            const point center( mid + center_offset( generator ), mid + center_offset( generator ) );
+            control[center.x][center.y] = 500;
+            experiment[center.x][center.y] = 500;
+            old_update_scent( control, weights, center, 40 );
+            diffuse_scent( experiment, weights, center, 40 );
+        }
+        INFO( "seed " << seed << ", " << blobs << " blobs" );
+        CHECK( grids_match() );
+    }
+}
+
+TEST_CASE( "scent_cache_follows_terrain" )
+{
+    const tripoint p( 30, 30, 0 );
+    g->m.ter_set( p, t_grass );
+    CHECK( g->m.get_scent_cache_ref( 0 ).weight[p.x][p.y] == SCENT_NORMAL );
+    g->m.ter_set( p, t_wall );
+    CHECK( g->m.get_scent_cache_ref( 0 ).weight[p.x][p.y] == SCENT_BLOCKED );
+    g->m.ter_set( p, t_grass );
+    CHECK( g->m.get_scent_cache_ref( 0 ).weight[p.x][p.y] == SCENT_NORMAL );
+}
+
+static void scent_benchmark( const int iterations, const int blobs )
+{
+    std::default_random_engine generator( 42 );
+    randomize_weights( generator );
+    scatter_scent( generator, blobs );
+    const point center( SEEX * MAPSIZE / 2, SEEY * MAPSIZE / 2 );
+
+    auto start1 = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        control[center.x][center.y] = 500;
+        old_update_scent( control, weights, center, 40 );
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+
+    auto start2 = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        experiment[center.x][center.y] = 500;
+        diffuse_scent( experiment, weights, center, 40 );
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+
+    long diff1 = std::chrono::duration_cast<std::chrono::microseconds>( end1 - start1 ).count();
+    long diff2 = std::chrono::duration_cast<std::chrono::microseconds>( end2 - start2 ).count();
+    printf( "%d blobs: old scent diffusion %ld us, current %ld us for %d iterations.\n",
+            blobs, diff1, diff2, iterations );
+    CHECK( grids_match() );
+}
+
+TEST_CASE( "scent_diffusion_performance", "[.]" )
+{
+    scent_benchmark( 10000, 0 );
+    scent_benchmark( 10000, 1 );
+    scent_benchmark( 10000, 200 );
+}
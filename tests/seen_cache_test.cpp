@@ -0,0 +1,124 @@
+#include "catch/catch.hpp"
+
+#include "field.h"
+#include "game.h"
+#include "map.h"
+#include "mapdata.h"
+#include "options.h"
+#include "player.h"
+#include "weather.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <stdio.h>
+
+typedef float seen_grid[MAPSIZE * SEEX][MAPSIZE * SEEY];
+
+static void clear_map_with_walls( const int walls )
+{
+    std::default_random_engine generator( 7 );
+    std::uniform_int_distribution<int> wall_distribution( 0, 99 );
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            const tripoint p( x, y, 0 );
+            g->m.set( x, y, wall_distribution( generator ) < walls ? t_wall : t_grass, f_null );
+            // Smoke left over from other tests blocks the sight
+            while( g->m.field_at( p ).fieldCount() > 0 ) {
+                g->m.remove_field( p, g->m.field_at( p ).begin()->first );
+            }
+        }
+    }
+    // Other weather makes the outdoors less transparent
+    g->weather = WEATHER_CLEAR;
+    g->m.set_transparency_cache_dirty( 0 );
+    const tripoint center( mapsize / 2, mapsize / 2, 0 );
+    g->m.ter_set( center, t_grass );
+    g->u.setpos( center );
+}
+
+static void copy_seen_cache( seen_grid &to )
+{
+    std::memcpy( to, g->m.get_cache_ref( 0 ).seen_cache, sizeof( to ) );
+}
+
+static bool seen_cache_is( const seen_grid &expected )
+{
+    return std::memcmp( expected, g->m.get_cache_ref( 0 ).seen_cache, sizeof( expected ) ) == 0;
+}
+
+TEST_CASE( "seen_cache_follows_transparency_and_origin" )
+{
+    clear_map_with_walls( 0 );
+    const tripoint center = g->u.pos();
+    const tripoint behind_wall = center + tripoint( 5, 0, 0 );
+
+    g->m.build_map_cache( 0 );
+    static seen_grid open;
+    copy_seen_cache( open );
+    CHECK( g->m.get_cache_ref( 0 ).seen_cache[behind_wall.x][behind_wall.y] > LIGHT_TRANSPARENCY_SOLID );
+
+    g->m.ter_set( center + tripoint( 2, 0, 0 ), t_wall );
+    g->m.build_map_cache( 0 );
+    CHECK( g->m.get_cache_ref( 0 ).seen_cache[behind_wall.x][behind_wall.y] <= LIGHT_TRANSPARENCY_SOLID );
+
+    g->m.ter_set( center + tripoint( 2, 0, 0 ), t_grass );
+    g->m.build_map_cache( 0 );
+    CHECK( seen_cache_is( open ) );
+
+    g->u.setpos( center + tripoint( 1, 0, 0 ) );
+    g->m.build_map_cache( 0 );
+    CHECK_FALSE( seen_cache_is( open ) );
+    g->u.setpos( center );
+    g->m.build_map_cache( 0 );
+    CHECK( seen_cache_is( open ) );
+}
+
+TEST_CASE( "seen_cache_does_not_depend_on_threads" )
+{
+    const std::string old_threads = OPTIONS["FOV_THREADS"].getValue();
+    for( const int walls : { 0, 5, 20, 50 } ) {
+        clear_map_with_walls( walls );
+        OPTIONS["FOV_THREADS"].setValue( "1" );
+        g->m.set_transparency_cache_dirty( 0 );
+        g->m.build_map_cache( 0 );
+        static seen_grid single_threaded;
+        copy_seen_cache( single_threaded );
+
+        OPTIONS["FOV_THREADS"].setValue( "4" );
+        g->m.set_transparency_cache_dirty( 0 );
+        g->m.build_map_cache( 0 );
+        INFO( walls << "% walls" );
+        CHECK( seen_cache_is( single_threaded ) );
+    }
+    OPTIONS["FOV_THREADS"].setValue( old_threads );
+}
+
+static long time_map_cache( const int iterations, const bool changing )
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        if( changing ) {
+            g->m.set_transparency_cache_dirty( 0 );
+        }
+        g->m.build_map_cache( 0, true );
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+}
+
+TEST_CASE( "seen_cache_performance", "[.]" )
+{
+    const std::string old_threads = OPTIONS["FOV_THREADS"].getValue();
+    clear_map_with_walls( 5 );
+    const int iterations = 1000;
+    for( const char *threads : { "1", "2", "4" } ) {
+        OPTIONS["FOV_THREADS"].setValue( threads );
+        const long changing = time_map_cache( iterations, true );
+        const long unchanged = time_map_cache( iterations, false );
+        printf( "%s threads: %ld us with the transparency changing, %ld us unchanged for %d map cache builds.\n",
+                threads, changing, unchanged, iterations );
+    }
+    OPTIONS["FOV_THREADS"].setValue( old_threads );
+}
@@ -0,0 +1,90 @@
+#include "catch/catch.hpp"
+
+#include "field.h"
+#include "filesystem.h"
+#include "game.h"
+#include "map.h"
+#include "options.h"
+#include "path_info.h"
+#include "turn_profiler.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+TEST_CASE( "turn_profiler_keeps_the_last_turns" )
+{
+    turn_profiler::clear();
+    CHECK( turn_profiler::recent_samples().empty() );
+    for( int turn = 0; turn < 150; turn++ ) {
+        turn_profiler::count( PROFILE_MONSTER_MOVES, turn );
+        turn_profiler::end_turn( turn );
+    }
+    const std::vector<turn_sample> samples = turn_profiler::recent_samples();
+    REQUIRE( samples.size() == turn_profiler::kept_turns );
+    CHECK( samples.front().turn == 50 );
+    CHECK( samples.front().counters[PROFILE_MONSTER_MOVES] == 50 );
+    CHECK( samples.back().turn == 149 );
+    CHECK( samples.back().counters[PROFILE_MONSTER_MOVES] == 149 );
+    CHECK( samples.back().counters[PROFILE_FIELDS_PROCESSED] == 0 );
+    // Measuring starts over after each turn
+    CHECK( turn_profiler::current.counters[PROFILE_MONSTER_MOVES] == 0 );
+    turn_profiler::clear();
+}
+
+#ifndef CATA_NO_PROFILER
+TEST_CASE( "turn_profiler_measures_the_map" )
+{
+    const tripoint fire( 30, 30, 0 );
+    g->m.add_field( fire, fd_fire, 2, 0 );
+    turn_profiler::clear();
+    g->m.process_fields();
+    g->m.set_transparency_cache_dirty( 0 );
+    g->m.clear_light_source_cache();
+    g->m.build_map_cache( 0 );
+    turn_profiler::end_turn( 1 );
+
+    const turn_sample sample = turn_profiler::recent_samples().back();
+    CHECK( sample.times[PROFILE_FIELDS].count() > 0 );
+    CHECK( sample.times[PROFILE_MAP_CACHE].count() > 0 );
+    CHECK( sample.times[PROFILE_MONSTERS].count() == 0 );
+    CHECK( sample.counters[PROFILE_FIELDS_PROCESSED] > 0 );
+    CHECK( sample.counters[PROFILE_LIGHT_CASTS] > 0 );
+    g->m.remove_field( fire, fd_fire );
+    turn_profiler::clear();
+}
+#endif
+
+TEST_CASE( "turn_profiler_writes_csv" )
+{
+    const std::string old_path = FILENAMES["profilecsv"];
+    const std::string path = "save/turn_profile_test.csv";
+    assure_dir_exist( "save" );
+    remove_file( path );
+    FILENAMES["profilecsv"] = path;
+
+    OPTIONS["PROFILE_CSV"].setValue( "true" );
+    turn_profiler::count( PROFILE_LIGHT_CASTS, 3 );
+    turn_profiler::end_turn( 11 );
+    turn_profiler::end_turn( 12 );
+    // Turning the option off closes the file
+    OPTIONS["PROFILE_CSV"].setValue( "false" );
+    turn_profiler::end_turn( 13 );
+
+    std::ifstream fin( path.c_str() );
+    std::vector<std::string> lines;
+    for( std::string line; std::getline( fin, line ); ) {
+        lines.push_back( line );
+    }
+    REQUIRE( lines.size() == 3 );
+    CHECK( lines[0].find( "turn,scent_us," ) == 0 );
+    CHECK( lines[0].find( ",light_casts" ) != std::string::npos );
+    CHECK( lines[1].find( "11," ) == 0 );
+    CHECK( lines[1].substr( lines[1].size() - 2 ) == ",3" );
+    CHECK( lines[2].find( "12," ) == 0 );
+
+    fin.close();
+    remove_file( path );
+    FILENAMES["profilecsv"] = old_path;
+    turn_profiler::clear();
+}
@@ -0,0 +1,194 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "map.h"
+#include "mapdata.h"
+#include "vehicle.h"
+#include "vehicle_scheduler.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+TEST_CASE( "vehicle_scheduler_moves_the_fastest_first" )
+{
+    vehicle a;
+    vehicle b;
+    vehicle c;
+    a.of_turn = 0.5f;
+    b.of_turn = 1.0f;
+    c.of_turn = 0.5f;
+    vehicle_scheduler schedule;
+    CHECK_FALSE( schedule.is_valid() );
+    schedule.reset( { &a, &b, &c } );
+    REQUIRE( schedule.is_valid() );
+
+    CHECK( schedule.next() == &b );
+    b.of_turn = 0.2f;
+    schedule.update( &b );
+    // Ties go to the one that came first
+    CHECK( schedule.next() == &a );
+    a.of_turn = 0;
+    schedule.update( &a );
+    CHECK( schedule.next() == &c );
+    // A collision gives the other vehicle more movement
+    b.of_turn = 0.8f;
+    schedule.update( &b );
+    CHECK( schedule.next() == &b );
+    b.of_turn = 0;
+    c.of_turn = 0;
+    schedule.update( &b );
+    schedule.update( &c );
+
+    // Falling vehicles go after all vehicles that can move
+    c.falling = true;
+    schedule.update( &c );
+    CHECK( schedule.next() == &c );
+    c.falling = false;
+    schedule.update( &c );
+    CHECK( schedule.next() == nullptr );
+
+    schedule.invalidate();
+    CHECK_FALSE( schedule.is_valid() );
+}
+
+static void pave_map()
+{
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            g->m.set( x, y, t_pavement, f_null );
+            g->m.i_clear( tripoint( x, y, 0 ) );
+        }
+    }
+}
+
+static void clear_vehicles()
+{
+    for( auto &vehs_v : g->m.get_vehicles() ) {
+        g->m.destroy_vehicle( vehs_v.v );
+    }
+}
+
+// Cars driving east on the left, with a parking lot full of cars on the right
+static std::vector<vehicle *> fill_map( const int moving, const int parked )
+{
+    std::vector<vehicle *> drivers;
+    for( int i = 0; i < moving; i++ ) {
+        vehicle *veh = g->m.add_vehicle( vproto_id( "car" ), tripoint( 10, 10 + 6 * i, 0 ), 0, 100, 0 );
+        REQUIRE( veh != nullptr );
+        veh->engine_on = true;
+        veh->velocity = 1000;
+        veh->cruise_velocity = 1000;
+        drivers.push_back( veh );
+    }
+    int placed = 0;
+    for( int x = 60; x < g->m.getmapsize() * SEEX - 8 && placed < parked; x += 8 ) {
+        for( int y = 10; y < g->m.getmapsize() * SEEY - 8 && placed < parked; y += 6 ) {
+            if( g->m.add_vehicle( vproto_id( "car" ), tripoint( x, y, 0 ), 0, 100, 0 ) != nullptr ) {
+                placed++;
+            }
+        }
+    }
+    return drivers;
+}
+
+TEST_CASE( "vehmove_moves_vehicles_with_movement_left" )
+{
+    pave_map();
+    clear_vehicles();
+    const std::vector<vehicle *> drivers = fill_map( 3, 20 );
+    // The position of the vehicle jumps around its pivot, the parts don't
+    std::vector<tripoint> before;
+    for( vehicle *veh : drivers ) {
+        before.push_back( veh->global_part_pos3( 0 ) );
+    }
+    const size_t total = g->m.get_vehicles().size();
+
+    for( int turn = 0; turn < 3; turn++ ) {
+        g->m.vehmove();
+    }
+    for( size_t i = 0; i < drivers.size(); i++ ) {
+        // Nobody drives, so they may start skidding a little off course
+        CHECK( drivers[i]->global_part_pos3( 0 ).x > before[i].x );
+        CHECK( drivers[i]->of_turn <= 0 );
+    }
+    CHECK( g->m.get_vehicles().size() == total );
+    clear_vehicles();
+}
+
+// vehmove as it was before the schedule: all vehicles are collected again for each step.
+// Returns the number of steps.
+static int scanning_vehmove()
+{
+    for( auto &vehs_v : g->m.get_vehicles() ) {
+        vehs_v.v->gain_moves();
+        vehs_v.v->slow_leak();
+    }
+    int steps = 0;
+    for( ; steps < 100; steps++ ) {
+        VehicleList vehs = g->m.get_vehicles();
+        vehicle *cur_veh = nullptr;
+        float max_of_turn = 0;
+        for( auto &vehs_v : vehs ) {
+            if( vehs_v.v->of_turn > max_of_turn ) {
+                cur_veh = vehs_v.v;
+                max_of_turn = cur_veh->of_turn;
+            }
+        }
+        if( cur_veh == nullptr ) {
+            for( auto &vehs_v : vehs ) {
+                if( vehs_v.v->falling ) {
+                    cur_veh = vehs_v.v;
+                    break;
+                }
+            }
+        }
+        if( cur_veh == nullptr ) {
+            break;
+        }
+        g->m.vehicle_step( *cur_veh );
+    }
+    for( vehicle *veh : g->m.dirty_vehicle_list ) {
+        veh->part_removal_cleanup();
+    }
+    g->m.dirty_vehicle_list.clear();
+    return steps;
+}
+
+// Microseconds that the given number of turns of vehmove take, starting with a fresh map
+template<typename Vehmove>
+static long time_vehicle_movement( const int turns, Vehmove vehmove )
+{
+    clear_vehicles();
+    const std::vector<vehicle *> drivers = fill_map( 10, 150 );
+    long moving_us = 0;
+    for( int turn = 0; turn < turns; turn++ ) {
+        // Keep them driving, nobody is at the wheel
+        for( vehicle *veh : drivers ) {
+            veh->velocity = 1000;
+        }
+        const auto start = std::chrono::high_resolution_clock::now();
+        vehmove();
+        const auto end = std::chrono::high_resolution_clock::now();
+        moving_us += std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+    }
+    return moving_us;
+}
+
+TEST_CASE( "vehicle_movement_performance", "[.]" )
+{
+    pave_map();
+    const int turns = 20;
+    int steps = 0;
+    const long scanning_us = time_vehicle_movement( turns, [&steps]() {
+        steps += scanning_vehmove();
+    } );
+    const int vehicles = g->m.get_vehicles().size();
+    const long scheduled_us = time_vehicle_movement( turns, []() {
+        g->m.vehmove();
+    } );
+    printf( "%d vehicles, 10 moving, %d steps per turn: %ld us per turn scheduled, %ld us per turn collecting them for each step.\n",
+            vehicles, steps / turns, scheduled_us / turns, scanning_us / turns );
+    clear_vehicles();
+}
@@ -0,0 +1,78 @@
+#include "catch/catch.hpp"
+
+#include "calendar.h"
+#include "game.h"
+#include "map.h"
+#include "weather.h"
+#include "weather_gen.h"
+
+int get_hourly_rotpoints_at_temp( int temp );
+
+TEST_CASE( "rot_since_matches_hourly_weather" )
+{
+    const tripoint location = g->m.getabs( tripoint( 60, 60, 0 ) );
+    const tripoint omt_corner( location.x - location.x % ( SEEX * 2 ),
+                               location.y - location.y % ( SEEY * 2 ), 0 );
+    const int start = HOURS( 1000 );
+
+    int expected = 0;
+    for( int hour = 1000; hour < 1000 + 24 * 10; hour++ ) {
+        const w_point w = g->weather_gen->get_weather( omt_corner, calendar( HOURS( hour ) ) );
+        expected += get_hourly_rotpoints_at_temp( w.temperature );
+    }
+    CHECK( get_rot_since( start, start + DAYS( 10 ), location ) == expected );
+
+    // Splitting the period at an hour boundary must not change the result
+    const int middle = start + HOURS( 37 );
+    const int split = get_rot_since( start, middle, location ) +
+                      get_rot_since( middle, start + DAYS( 10 ), location );
+    CHECK( split == expected );
+    // Earlier periods extend the history backwards
+    CHECK( get_rot_since( start - DAYS( 30 ), start, location ) > 0 );
+    CHECK( get_rot_since( start, start + DAYS( 10 ), location ) == expected );
+    CHECK( get_rot_since( start, start, location ) == 0 );
+}
+
+TEST_CASE( "rot_since_outside_of_the_kept_history" )
+{
+    const tripoint location = g->m.getabs( tripoint( 60, 60, 0 ) );
+    const tripoint omt_corner( location.x - location.x % ( SEEX * 2 ),
+                               location.y - location.y % ( SEEY * 2 ), 0 );
+    const auto hourly_rot = [&]( const int first_hour, const int last_hour ) {
+        int rot = 0;
+        for( int hour = first_hour; hour < last_hour; hour++ ) {
+            const w_point w = g->weather_gen->get_weather( omt_corner, calendar( HOURS( hour ) ) );
+            rot += get_hourly_rotpoints_at_temp( w.temperature );
+        }
+        return rot;
+    };
+
+    // Longer than the hours that are kept
+    const int start = HOURS( 3000 );
+    CHECK( get_rot_since( start, start + DAYS( 45 ), location ) == hourly_rot( 3000, 3000 + 24 * 45 ) );
+    // Far ahead of everything kept so far, and then back to the start again
+    CHECK( get_rot_since( start + DAYS( 200 ), start + DAYS( 201 ), location ) ==
+           hourly_rot( 3000 + 24 * 200, 3000 + 24 * 201 ) );
+    CHECK( get_rot_since( start, start + DAYS( 1 ), location ) == hourly_rot( 3000, 3000 + 24 ) );
+
+    // Many other regions push this one out, it comes back the same
+    for( int i = 0; i < 200; i++ ) {
+        const tripoint other( ( i % 20 ) * SEEX * 2, ( i / 20 ) * SEEY * 2, 0 );
+        get_rot_since( start, start + HOURS( 2 ), location + other );
+    }
+    CHECK( get_rot_since( start, start + DAYS( 1 ), location ) == hourly_rot( 3000, 3000 + 24 ) );
+}
+
+TEST_CASE( "weather_sums_add_up" )
+{
+    const tripoint location = g->m.getabs( tripoint( 60, 60, 0 ) );
+    const calendar start( DAYS( 40 ) );
+    const calendar middle( DAYS( 45 ) );
+    const calendar end( DAYS( 50 ) );
+    const weather_sum whole = sum_conditions( start, end, location );
+    const weather_sum first = sum_conditions( start, middle, location );
+    const weather_sum second = sum_conditions( middle, end, location );
+    CHECK( whole.rain_amount == first.rain_amount + second.rain_amount );
+    CHECK( whole.acid_amount == first.acid_amount + second.acid_amount );
+    CHECK( whole.sunlight == Approx( first.sunlight + second.sunlight ) );
+}